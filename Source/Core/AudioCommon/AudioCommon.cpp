@@ -213,8 +213,9 @@ void StartAudioDump()
   std::string base_name =
       fmt::format("{}_{:%Y-%m-%d_%H-%M-%S}", path_prefix, fmt::localtime(start_time));
 
-  const std::string audio_file_name_dtk = fmt::format("{}_dtkdump.wav", base_name);
-  const std::string audio_file_name_dsp = fmt::format("{}_dspdump.wav", base_name);
+  // The file extension depends on the dump format and is added by the mixer's audio dumpers.
+  const std::string audio_file_name_dtk = fmt::format("{}_dtkdump", base_name);
+  const std::string audio_file_name_dsp = fmt::format("{}_dspdump", base_name);
   File::CreateFullPath(audio_file_name_dtk);
   File::CreateFullPath(audio_file_name_dsp);
   g_sound_stream->GetMixer()->StartLogDTKAudio(audio_file_name_dtk);
@@ -0,0 +1,192 @@
+// Copyright 2022 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "AudioCommon/AudioDumper.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include <fmt/format.h>
+
+#include "Common/FileUtil.h"
+#include "Common/Logging/Log.h"
+#include "Common/MsgHandler.h"
+#include "Common/Swap.h"
+#include "Common/Thread.h"
+#include "Core/Config/MainSettings.h"
+
+namespace AudioCommon
+{
+AudioDumper::AudioDumper() : m_packets(QUEUE_PACKETS)
+{
+}
+
+AudioDumper::~AudioDumper()
+{
+  Stop();
+}
+
+bool AudioDumper::Start(const std::string& base_path, u32 sample_rate)
+{
+  if (m_running.IsSet())
+    return false;
+
+  // This is the only place where the writers may ask whether to overwrite an existing file, since
+  // the writer thread can't show prompts.
+  m_use_flac = Config::Get(Config::MAIN_DUMP_AUDIO_FLAC);
+  if (m_use_flac)
+  {
+    const std::string filename = base_path + ".flac";
+    if (File::Exists(filename) && !Config::Get(Config::MAIN_DUMP_AUDIO_SILENT) &&
+        !AskYesNoFmtT("Delete the existing file '{0}'?", filename))
+    {
+      return false;
+    }
+    if (!m_flac_writer.Start(filename, sample_rate))
+      return false;
+  }
+  else if (!m_wave_writer.Start(base_path + ".wav", sample_rate))
+  {
+    m_wave_writer.Stop();
+    return false;
+  }
+
+  m_base_path = base_path;
+  m_sample_rate = sample_rate;
+  m_file_index = 0;
+  m_write_failed = false;
+
+  m_read_index.store(0, std::memory_order_relaxed);
+  m_write_index.store(0, std::memory_order_relaxed);
+  m_dropped_samples = 0;
+
+  m_running.Set();
+  m_thread = std::thread(&AudioDumper::WriterThread, this);
+  return true;
+}
+
+void AudioDumper::Stop()
+{
+  if (!m_running.TestAndClear())
+    return;
+
+  m_wakeup.Set();
+  m_thread.join();
+
+  if (m_use_flac)
+    m_flac_writer.Stop();
+  else
+    m_wave_writer.Stop();
+
+  if (m_dropped_samples != 0)
+  {
+    WARN_LOG_FMT(AUDIO, "Audio dumping could not keep up, {} samples were dropped",
+                 m_dropped_samples);
+  }
+}
+
+void AudioDumper::AddStereoSamplesBE(const s16* samples, u32 count, u32 sample_rate)
+{
+  while (count != 0)
+  {
+    const u32 write_index = m_write_index.load(std::memory_order_relaxed);
+    if (write_index - m_read_index.load(std::memory_order_acquire) == QUEUE_PACKETS)
+    {
+      m_dropped_samples += count;
+      break;
+    }
+
+    Packet& packet = m_packets[write_index % QUEUE_PACKETS];
+    packet.sample_rate = sample_rate;
+    packet.count = std::min(count, PACKET_SAMPLES);
+    std::memcpy(packet.samples.data(), samples, packet.count * 2 * sizeof(s16));
+    m_write_index.store(write_index + 1, std::memory_order_release);
+
+    samples += packet.count * 2;
+    count -= packet.count;
+  }
+
+  m_wakeup.Set();
+}
+
+void AudioDumper::WriterThread()
+{
+  Common::SetCurrentThreadName("Audio Dumping");
+
+  while (m_running.IsSet())
+  {
+    m_wakeup.Wait();
+    WritePendingPackets();
+  }
+
+  // Write out whatever was queued before Stop was called.
+  WritePendingPackets();
+}
+
+void AudioDumper::WritePendingPackets()
+{
+  const u32 write_index = m_write_index.load(std::memory_order_acquire);
+  u32 read_index = m_read_index.load(std::memory_order_relaxed);
+
+  for (; read_index != write_index; ++read_index)
+  {
+    WritePacket(m_packets[read_index % QUEUE_PACKETS]);
+
+    // Hand the packet back to the producer as soon as possible.
+    m_read_index.store(read_index + 1, std::memory_order_release);
+  }
+}
+
+void AudioDumper::WritePacket(const Packet& packet)
+{
+  if (m_write_failed)
+    return;
+
+  if (packet.sample_rate != m_sample_rate && !StartNextFile(packet.sample_rate))
+  {
+    ERROR_LOG_FMT(AUDIO, "Could not start a new audio dump for sample rate {}, stopping dump",
+                  packet.sample_rate);
+    m_write_failed = true;
+    return;
+  }
+
+  if (!m_use_flac)
+  {
+    m_wave_writer.AddStereoSamplesBE(packet.samples.data(), packet.count, packet.sample_rate);
+    return;
+  }
+
+  for (u32 i = 0; i < packet.count; ++i)
+  {
+    // Flip the audio channels from RL to LR
+    const u16 right = Common::swap16(static_cast<u16>(packet.samples[2 * i]));
+    const u16 left = Common::swap16(static_cast<u16>(packet.samples[2 * i + 1]));
+    m_conversion_buffer[2 * i] = static_cast<s16>(left);
+    m_conversion_buffer[2 * i + 1] = static_cast<s16>(right);
+  }
+
+  m_flac_writer.AddStereoSamples(m_conversion_buffer.data(), packet.count);
+}
+
+bool AudioDumper::StartNextFile(u32 sample_rate)
+{
+  if (m_use_flac)
+    m_flac_writer.Stop();
+  else
+    m_wave_writer.Stop();
+  m_sample_rate = sample_rate;
+
+  // Existing files are skipped rather than overwritten, since there's no one to ask here.
+  const char* extension = m_use_flac ? "flac" : "wav";
+  std::string filename;
+  do
+  {
+    ++m_file_index;
+    filename = fmt::format("{}{}.{}", m_base_path, m_file_index, extension);
+  } while (File::Exists(filename));
+
+  if (m_use_flac)
+    return m_flac_writer.Start(filename, sample_rate);
+  return m_wave_writer.Start(filename, sample_rate);
+}
+}  // namespace AudioCommon
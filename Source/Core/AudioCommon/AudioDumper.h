@@ -0,0 +1,82 @@
+// Copyright 2022 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "AudioCommon/FlacFileWriter.h"
+#include "AudioCommon/WaveFile.h"
+#include "Common/CommonTypes.h"
+#include "Common/Event.h"
+#include "Common/Flag.h"
+
+namespace AudioCommon
+{
+// Dumps a stream of 16-bit stereo audio to a WAV file, or to a FLAC file if DSP/DumpAudioFLAC is
+// enabled.
+//
+// Samples are handed to a writer thread through a bounded lock-free queue, so that encoding and
+// disk I/O never hold up the thread that produces the audio. If the writer thread falls behind
+// far enough for the queue to fill up, samples are dropped instead.
+class AudioDumper
+{
+public:
+  AudioDumper();
+  ~AudioDumper();
+
+  AudioDumper(const AudioDumper&) = delete;
+  AudioDumper& operator=(const AudioDumper&) = delete;
+  AudioDumper(AudioDumper&&) = delete;
+  AudioDumper& operator=(AudioDumper&&) = delete;
+
+  // The file extension is appended to base_path depending on the format.
+  bool Start(const std::string& base_path, u32 sample_rate);
+  void Stop();
+
+  // Takes big endian samples with the channels in right/left order, like the DSP and DTK mixers.
+  // Must only be called from one thread at a time.
+  void AddStereoSamplesBE(const s16* samples, u32 count, u32 sample_rate);
+
+private:
+  static constexpr u32 PACKET_SAMPLES = 512;
+  static constexpr u32 QUEUE_PACKETS = 256;
+
+  struct Packet
+  {
+    u32 sample_rate;
+    u32 count;
+    std::array<s16, PACKET_SAMPLES * 2> samples;
+  };
+
+  void WriterThread();
+  void WritePendingPackets();
+  void WritePacket(const Packet& packet);
+  bool StartNextFile(u32 sample_rate);
+
+  // Single producer, single consumer ring. The indices only ever increase.
+  std::vector<Packet> m_packets;
+  std::atomic<u32> m_read_index{0};
+  std::atomic<u32> m_write_index{0};
+  u64 m_dropped_samples = 0;
+
+  std::thread m_thread;
+  Common::Flag m_running;
+  Common::Event m_wakeup;
+
+  bool m_use_flac = false;
+  WaveFileWriter m_wave_writer;
+  FlacFileWriter m_flac_writer;
+
+  // Used by the writer thread to start a new file when the sample rate changes.
+  std::string m_base_path;
+  u32 m_sample_rate = 0;
+  int m_file_index = 0;
+  bool m_write_failed = false;
+  std::array<s16, PACKET_SAMPLES * 2> m_conversion_buffer{};
+};
+}  // namespace AudioCommon
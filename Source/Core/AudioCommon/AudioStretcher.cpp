@@ -12,20 +12,18 @@
 
 namespace AudioCommon
 {
-AudioStretcher::AudioStretcher(unsigned int sample_rate) : m_sample_rate(sample_rate)
+AudioStretcher::AudioStretcher(unsigned int sample_rate)
+    : m_sample_rate(sample_rate), m_time_stretcher(sample_rate)
 {
-  m_sound_touch.setChannels(2);
-  m_sound_touch.setSampleRate(sample_rate);
-  m_sound_touch.setPitch(1.0);
-  m_sound_touch.setTempo(1.0);
 }
 
 void AudioStretcher::Clear()
 {
-  m_sound_touch.clear();
+  m_time_stretcher.Clear();
 }
 
-void AudioStretcher::ProcessSamples(const short* in, unsigned int num_in, unsigned int num_out)
+void AudioStretcher::ProcessSamples(const short* in, unsigned int num_in, unsigned int num_out,
+                                    float emulation_speed)
 {
   const double time_delta = static_cast<double>(num_out) / m_sample_rate;  // seconds
 
@@ -34,7 +32,7 @@ void AudioStretcher::ProcessSamples(const short* in, unsigned int num_in, unsign
 
   const double max_latency = Config::Get(Config::MAIN_AUDIO_STRETCH_LATENCY);
   const double max_backlog = m_sample_rate * max_latency / 1000.0 / m_stretch_ratio;
-  const double backlog_fullness = m_sound_touch.numSamples() / max_backlog;
+  const double backlog_fullness = m_time_stretcher.GetAvailableSamples() / max_backlog;
   if (backlog_fullness > 5.0)
   {
     // Too many samples in backlog: Don't push anymore on
@@ -53,20 +51,25 @@ void AudioStretcher::ProcessSamples(const short* in, unsigned int num_in, unsign
   const double lpf_gain = 1.0 - std::exp(-time_delta / lpf_time_scale);
   m_stretch_ratio += lpf_gain * (current_ratio - m_stretch_ratio);
 
+  // Don't take a whole second to catch up when fast-forwarding is toggled. The measured emulation
+  // speed is what the ratio is going to settle at anyway.
+  if (emulation_speed > 0.0f && std::abs(m_stretch_ratio / emulation_speed - 1.0) > 0.25)
+    m_stretch_ratio = emulation_speed;
+
   // Place a lower limit of 10% speed.  When a game boots up, there will be
   // many silence samples.  These do not need to be timestretched.
   m_stretch_ratio = std::max(m_stretch_ratio, 0.1);
-  m_sound_touch.setTempo(m_stretch_ratio);
+  m_time_stretcher.SetTempo(m_stretch_ratio);
 
   DEBUG_LOG_FMT(AUDIO, "Audio stretching: samples:{}/{} ratio:{} backlog:{} gain: {}", num_in,
                 num_out, m_stretch_ratio, backlog_fullness, lpf_gain);
 
-  m_sound_touch.putSamples(in, num_in);
+  m_time_stretcher.PutSamples(in, num_in);
 }
 
 void AudioStretcher::GetStretchedSamples(short* out, unsigned int num_out)
 {
-  const size_t samples_received = m_sound_touch.receiveSamples(out, num_out);
+  const size_t samples_received = m_time_stretcher.ReceiveSamples(out, num_out);
 
   if (samples_received != 0)
   {
@@ -5,7 +5,7 @@
 
 #include <array>
 
-#include <SoundTouch.h>
+#include "AudioCommon/TimeStretcher.h"
 
 namespace AudioCommon
 {
@@ -13,14 +13,16 @@ class AudioStretcher
 {
 public:
   explicit AudioStretcher(unsigned int sample_rate);
-  void ProcessSamples(const short* in, unsigned int num_in, unsigned int num_out);
+  // emulation_speed is the measured speed of the emulated console, where 1.0 is full speed.
+  void ProcessSamples(const short* in, unsigned int num_in, unsigned int num_out,
+                      float emulation_speed);
   void GetStretchedSamples(short* out, unsigned int num_out);
   void Clear();
 
 private:
   unsigned int m_sample_rate;
   std::array<short, 2> m_last_stretched_sample = {};
-  soundtouch::SoundTouch m_sound_touch;
+  TimeStretcher m_time_stretcher;
   double m_stretch_ratio = 1.0;
 };
 
@@ -0,0 +1,616 @@
+// Copyright 2022 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "AudioCommon/FlacFileWriter.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <limits>
+
+#include "Common/Logging/Log.h"
+#include "Common/MsgHandler.h"
+
+namespace AudioCommon
+{
+namespace
+{
+constexpr u32 MAX_RICE_PARAMETER = 14;
+
+// Channel assignments from the frame header.
+constexpr u32 CHANNELS_INDEPENDENT = 1;
+constexpr u32 CHANNELS_LEFT_SIDE = 8;
+constexpr u32 CHANNELS_SIDE_RIGHT = 9;
+constexpr u32 CHANNELS_MID_SIDE = 10;
+
+const std::array<u8, 256> s_crc8_table = [] {
+  std::array<u8, 256> table{};
+  for (u32 i = 0; i < 256; ++i)
+  {
+    u32 crc = i;
+    for (int bit = 0; bit < 8; ++bit)
+      crc = (crc & 0x80) ? (crc << 1) ^ 0x07 : crc << 1;
+    table[i] = static_cast<u8>(crc);
+  }
+  return table;
+}();
+
+const std::array<u16, 256> s_crc16_table = [] {
+  std::array<u16, 256> table{};
+  for (u32 i = 0; i < 256; ++i)
+  {
+    u32 crc = i << 8;
+    for (int bit = 0; bit < 8; ++bit)
+      crc = (crc & 0x8000) ? (crc << 1) ^ 0x8005 : crc << 1;
+    table[i] = static_cast<u16>(crc);
+  }
+  return table;
+}();
+
+u8 ComputeCRC8(const u8* data, size_t size)
+{
+  u8 crc = 0;
+  for (size_t i = 0; i < size; ++i)
+    crc = s_crc8_table[crc ^ data[i]];
+  return crc;
+}
+
+u16 ComputeCRC16(const u8* data, size_t size)
+{
+  u16 crc = 0;
+  for (size_t i = 0; i < size; ++i)
+    crc = static_cast<u16>(crc << 8) ^ s_crc16_table[(crc >> 8) ^ data[i]];
+  return crc;
+}
+
+s32 FixedResidual(const s32* samples, u32 i, u32 order)
+{
+  switch (order)
+  {
+  case 0:
+    return samples[i];
+  case 1:
+    return samples[i] - samples[i - 1];
+  case 2:
+    return samples[i] - 2 * samples[i - 1] + samples[i - 2];
+  case 3:
+    return samples[i] - 3 * samples[i - 1] + 3 * samples[i - 2] - samples[i - 3];
+  default:
+    return samples[i] - 4 * samples[i - 1] + 6 * samples[i - 2] - 4 * samples[i - 3] +
+           samples[i - 4];
+  }
+}
+
+// Picks the fixed predictor with the smallest total residual magnitude. Returns that magnitude,
+// which is a good enough estimate of the coded size to also pick the stereo decorrelation.
+u64 ChooseFixedOrder(const s32* samples, u32 block_size, u32 max_order, u32* order)
+{
+  if (block_size <= max_order)
+  {
+    *order = 0;
+    return std::numeric_limits<u64>::max() / 4;
+  }
+
+  std::array<u64, 5> sums{};
+  for (u32 i = max_order; i < block_size; ++i)
+  {
+    for (u32 o = 0; o <= max_order; ++o)
+      sums[o] += static_cast<u64>(std::abs(FixedResidual(samples, i, o)));
+  }
+
+  const auto best = std::min_element(sums.begin(), sums.begin() + max_order + 1);
+  *order = static_cast<u32>(best - sums.begin());
+  return *best;
+}
+
+u32 FoldResidual(s32 value)
+{
+  return (static_cast<u32>(value) << 1) ^ static_cast<u32>(value >> 31);
+}
+
+// Residuals are kept well inside 32 bits, so that decoders never overflow while reconstructing.
+constexpr s64 MAX_LPC_RESIDUAL = s64{1} << 30;
+
+bool ComputeLPCResidual(const s32* samples, u32 block_size, u32 order, const s32* coefficients,
+                        u32 shift, s32* residual)
+{
+  for (u32 i = order; i < block_size; ++i)
+  {
+    s64 prediction = 0;
+    for (u32 j = 0; j < order; ++j)
+      prediction += s64{coefficients[j]} * samples[i - j - 1];
+
+    const s64 value = samples[i] - (prediction >> shift);
+    if (value >= MAX_LPC_RESIDUAL || value <= -MAX_LPC_RESIDUAL)
+      return false;
+    residual[i] = static_cast<s32>(value);
+  }
+  return true;
+}
+}  // namespace
+
+void FlacFileWriter::BitWriter::Reset()
+{
+  m_bytes.clear();
+  m_accumulator = 0;
+  m_bits = 0;
+}
+
+void FlacFileWriter::BitWriter::Write(u32 value, u32 bits)
+{
+  if (bits == 0)
+    return;
+
+  m_accumulator = (m_accumulator << bits) | (value & ((u64{1} << bits) - 1));
+  m_bits += bits;
+  while (m_bits >= 8)
+  {
+    m_bits -= 8;
+    m_bytes.push_back(static_cast<u8>(m_accumulator >> m_bits));
+  }
+}
+
+void FlacFileWriter::BitWriter::WriteRice(s32 value, u32 parameter)
+{
+  const u32 folded = FoldResidual(value);
+  u32 quotient = folded >> parameter;
+
+  // The quotient is coded in unary as that many zero bits and a terminating one bit.
+  while (quotient >= 16)
+  {
+    Write(0, 16);
+    quotient -= 16;
+  }
+  Write(1, quotient + 1);
+  Write(folded, parameter);
+}
+
+void FlacFileWriter::BitWriter::AlignToByte()
+{
+  if (m_bits != 0)
+    Write(0, 8 - m_bits);
+}
+
+FlacFileWriter::~FlacFileWriter()
+{
+  Stop();
+}
+
+bool FlacFileWriter::Start(const std::string& filename, u32 sample_rate)
+{
+  if (m_file)
+  {
+    PanicAlertFmtT("The file {0} was already open, the file header will not be written.", filename);
+    return false;
+  }
+
+  m_file.Open(filename, "wb");
+  if (!m_file)
+  {
+    PanicAlertFmtT(
+        "The file {0} could not be opened for writing. Please check if it's already opened "
+        "by another program.",
+        filename);
+    return false;
+  }
+
+  m_sample_rate = sample_rate;
+  m_total_samples = 0;
+  m_frame_number = 0;
+  m_buffered = 0;
+
+  mbedtls_md5_init(&m_md5);
+  mbedtls_md5_starts_ret(&m_md5);
+  m_md5_digest.fill(0);
+
+  // The total sample count in the stream info is filled in once Stop is called.
+  WriteStreamInfo();
+  return true;
+}
+
+void FlacFileWriter::Stop()
+{
+  if (!m_file)
+    return;
+
+  if (m_buffered != 0)
+    EncodeFrame(m_buffered);
+  m_buffered = 0;
+
+  mbedtls_md5_finish_ret(&m_md5, m_md5_digest.data());
+  mbedtls_md5_free(&m_md5);
+
+  m_file.Seek(0, File::SeekOrigin::Begin);
+  WriteStreamInfo();
+  m_file.Close();
+}
+
+void FlacFileWriter::WriteStreamInfo()
+{
+  m_bits.Reset();
+  for (const char c : {'f', 'L', 'a', 'C'})
+    m_bits.Write(c, 8);
+
+  // Metadata block header: this is the last metadata block, of type STREAMINFO.
+  m_bits.Write(1, 1);
+  m_bits.Write(0, 7);
+  m_bits.Write(34, 24);
+
+  m_bits.Write(BLOCK_SIZE, 16);  // Minimum block size
+  m_bits.Write(BLOCK_SIZE, 16);  // Maximum block size
+  m_bits.Write(0, 24);           // Minimum frame size (unknown)
+  m_bits.Write(0, 24);           // Maximum frame size (unknown)
+  m_bits.Write(m_sample_rate, 20);
+  m_bits.Write(2 - 1, 3);   // Channels
+  m_bits.Write(16 - 1, 5);  // Bits per sample
+  m_bits.Write(static_cast<u32>(m_total_samples >> 32), 4);
+  m_bits.Write(static_cast<u32>(m_total_samples), 32);
+  for (const u8 byte : m_md5_digest)
+    m_bits.Write(byte, 8);
+
+  m_file.WriteBytes(m_bits.GetBytes().data(), m_bits.GetBytes().size());
+}
+
+void FlacFileWriter::AddStereoSamples(const s16* samples, u32 count)
+{
+  if (!m_file)
+  {
+    ERROR_LOG_FMT(AUDIO, "FlacFileWriter - file not open.");
+    return;
+  }
+
+  for (u32 i = 0; i < count; ++i)
+  {
+    m_left[m_buffered] = samples[2 * i];
+    m_right[m_buffered] = samples[2 * i + 1];
+    if (++m_buffered == BLOCK_SIZE)
+    {
+      EncodeFrame(BLOCK_SIZE);
+      m_buffered = 0;
+    }
+  }
+}
+
+void FlacFileWriter::UpdateMD5(u32 block_size)
+{
+  for (u32 i = 0; i < block_size; ++i)
+  {
+    m_md5_buffer[4 * i] = static_cast<u8>(m_left[i]);
+    m_md5_buffer[4 * i + 1] = static_cast<u8>(m_left[i] >> 8);
+    m_md5_buffer[4 * i + 2] = static_cast<u8>(m_right[i]);
+    m_md5_buffer[4 * i + 3] = static_cast<u8>(m_right[i] >> 8);
+  }
+  mbedtls_md5_update_ret(&m_md5, m_md5_buffer.data(), block_size * 4);
+}
+
+void FlacFileWriter::EncodeFrame(u32 block_size)
+{
+  UpdateMD5(block_size);
+
+  for (u32 i = 0; i < block_size; ++i)
+  {
+    m_mid[i] = (m_left[i] + m_right[i]) >> 1;
+    m_side[i] = m_left[i] - m_right[i];
+  }
+
+  u32 left_order, right_order, mid_order, side_order;
+  const u64 left = ChooseFixedOrder(m_left.data(), block_size, MAX_FIXED_ORDER, &left_order);
+  const u64 right = ChooseFixedOrder(m_right.data(), block_size, MAX_FIXED_ORDER, &right_order);
+  const u64 mid = ChooseFixedOrder(m_mid.data(), block_size, MAX_FIXED_ORDER, &mid_order);
+  const u64 side = ChooseFixedOrder(m_side.data(), block_size, MAX_FIXED_ORDER, &side_order);
+
+  u32 channels = CHANNELS_INDEPENDENT;
+  u64 best = left + right;
+  if (left + side < best)
+  {
+    channels = CHANNELS_LEFT_SIDE;
+    best = left + side;
+  }
+  if (side + right < best)
+  {
+    channels = CHANNELS_SIDE_RIGHT;
+    best = side + right;
+  }
+  if (mid + side < best)
+    channels = CHANNELS_MID_SIDE;
+
+  m_bits.Reset();
+
+  // Frame header
+  m_bits.Write(0x3ffe, 14);  // Sync code
+  m_bits.Write(0, 1);        // Reserved
+  m_bits.Write(0, 1);        // Fixed block size
+  m_bits.Write(block_size == BLOCK_SIZE ? 12 : 7, 4);
+  m_bits.Write(0, 4);  // Sample rate from the stream info
+  m_bits.Write(channels, 4);
+  m_bits.Write(4, 3);  // 16 bits per sample
+  m_bits.Write(0, 1);  // Reserved
+
+  // The frame number is coded like a UTF-8 character.
+  if (m_frame_number < 0x80)
+  {
+    m_bits.Write(m_frame_number, 8);
+  }
+  else
+  {
+    u32 num_bytes = 2;
+    while (num_bytes < 6 && m_frame_number >= (1u << (5 * num_bytes + 1)))
+      ++num_bytes;
+    m_bits.Write(((1u << num_bytes) - 1) << 1, num_bytes + 1);
+    m_bits.Write(m_frame_number >> (6 * (num_bytes - 1)), 7 - num_bytes);
+    for (u32 i = num_bytes - 1; i > 0; --i)
+      m_bits.Write(0x80 | ((m_frame_number >> (6 * (i - 1))) & 0x3f), 8);
+  }
+
+  if (block_size != BLOCK_SIZE)
+    m_bits.Write(block_size - 1, 16);
+  m_bits.Write(ComputeCRC8(m_bits.GetBytes().data(), m_bits.GetBytes().size()), 8);
+
+  switch (channels)
+  {
+  case CHANNELS_INDEPENDENT:
+    EncodeSubframe(m_left.data(), block_size, 16, left_order);
+    EncodeSubframe(m_right.data(), block_size, 16, right_order);
+    break;
+  case CHANNELS_LEFT_SIDE:
+    EncodeSubframe(m_left.data(), block_size, 16, left_order);
+    EncodeSubframe(m_side.data(), block_size, 17, side_order);
+    break;
+  case CHANNELS_SIDE_RIGHT:
+    EncodeSubframe(m_side.data(), block_size, 17, side_order);
+    EncodeSubframe(m_right.data(), block_size, 16, right_order);
+    break;
+  case CHANNELS_MID_SIDE:
+    EncodeSubframe(m_mid.data(), block_size, 16, mid_order);
+    EncodeSubframe(m_side.data(), block_size, 17, side_order);
+    break;
+  }
+
+  m_bits.AlignToByte();
+  m_bits.Write(ComputeCRC16(m_bits.GetBytes().data(), m_bits.GetBytes().size()), 16);
+
+  m_file.WriteBytes(m_bits.GetBytes().data(), m_bits.GetBytes().size());
+  m_total_samples += block_size;
+  ++m_frame_number;
+}
+
+void FlacFileWriter::EncodeSubframe(const s32* samples, u32 block_size, u32 bits_per_sample,
+                                    u32 fixed_order)
+{
+  // Subframe headers are a zero bit, six bits of type and a "wasted bits" flag.
+  if (std::all_of(samples, samples + block_size, [&](s32 s) { return s == samples[0]; }))
+  {
+    m_bits.Write(0b00000000, 8);
+    m_bits.Write(static_cast<u32>(samples[0]), bits_per_sample);
+    return;
+  }
+
+  for (u32 i = fixed_order; i < block_size; ++i)
+    m_residual[i] = FixedResidual(samples, i, fixed_order);
+  const RiceCoding fixed_coding = ChooseRiceCoding(m_residual.data(), block_size, fixed_order);
+  const u64 fixed_bits = u64{fixed_order} * bits_per_sample + fixed_coding.bits;
+
+  std::array<s32, MAX_LPC_ORDER> coefficients;
+  u32 shift;
+  RiceCoding lpc_coding;
+  u64 lpc_bits = std::numeric_limits<u64>::max();
+  const u32 lpc_order = ComputeLPC(samples, block_size, coefficients.data(), &shift);
+  if (lpc_order != 0 && ComputeLPCResidual(samples, block_size, lpc_order, coefficients.data(),
+                                           shift, m_lpc_residual.data()))
+  {
+    lpc_coding = ChooseRiceCoding(m_lpc_residual.data(), block_size, lpc_order);
+    lpc_bits = u64{lpc_order} * (bits_per_sample + LPC_PRECISION) + 9 + lpc_coding.bits;
+  }
+
+  if (std::min(fixed_bits, lpc_bits) >= u64{block_size} * bits_per_sample)
+  {
+    m_bits.Write(0b00000010, 8);
+    for (u32 i = 0; i < block_size; ++i)
+      m_bits.Write(static_cast<u32>(samples[i]), bits_per_sample);
+    return;
+  }
+
+  if (lpc_bits < fixed_bits)
+  {
+    m_bits.Write(0b01000000 | ((lpc_order - 1) << 1), 8);
+    for (u32 i = 0; i < lpc_order; ++i)
+      m_bits.Write(static_cast<u32>(samples[i]), bits_per_sample);
+
+    m_bits.Write(LPC_PRECISION - 1, 4);
+    m_bits.Write(shift, 5);
+    for (u32 i = 0; i < lpc_order; ++i)
+      m_bits.Write(static_cast<u32>(coefficients[i]), LPC_PRECISION);
+
+    WriteResidual(m_lpc_residual.data(), block_size, lpc_order, lpc_coding);
+    return;
+  }
+
+  m_bits.Write(0b00010000 | (fixed_order << 1), 8);
+  for (u32 i = 0; i < fixed_order; ++i)
+    m_bits.Write(static_cast<u32>(samples[i]), bits_per_sample);
+
+  WriteResidual(m_residual.data(), block_size, fixed_order, fixed_coding);
+}
+
+// Linear prediction with the autocorrelation method, as described in the FLAC format
+// documentation: the block is windowed, the Levinson-Durbin recursion gives the predictors of all
+// orders up to MAX_LPC_ORDER, and the order with the smallest estimated size is quantized.
+u32 FlacFileWriter::ComputeLPC(const s32* samples, u32 block_size, s32* coefficients, u32* shift)
+{
+  if (block_size <= 2 * MAX_LPC_ORDER)
+    return 0;
+
+  // Welch window
+  const double half = (block_size - 1) / 2.0;
+  for (u32 i = 0; i < block_size; ++i)
+  {
+    const double x = (i - half) / half;
+    m_windowed[i] = samples[i] * (1.0 - x * x);
+  }
+
+  std::array<double, MAX_LPC_ORDER + 1> autocorrelation{};
+  for (u32 lag = 0; lag <= MAX_LPC_ORDER; ++lag)
+  {
+    for (u32 i = lag; i < block_size; ++i)
+      autocorrelation[lag] += m_windowed[i] * m_windowed[i - lag];
+  }
+  if (autocorrelation[0] == 0.0)
+    return 0;
+
+  std::array<std::array<double, MAX_LPC_ORDER>, MAX_LPC_ORDER> predictors{};
+  std::array<double, MAX_LPC_ORDER> errors{};
+  std::array<double, MAX_LPC_ORDER> lpc{};
+  double error = autocorrelation[0];
+  u32 max_order = MAX_LPC_ORDER;
+  for (u32 i = 0; i < max_order; ++i)
+  {
+    double reflection = -autocorrelation[i + 1];
+    for (u32 j = 0; j < i; ++j)
+      reflection -= lpc[j] * autocorrelation[i - j];
+    reflection /= error;
+
+    lpc[i] = reflection;
+    u32 j = 0;
+    for (; j < i / 2; ++j)
+    {
+      const double tmp = lpc[j];
+      lpc[j] += reflection * lpc[i - 1 - j];
+      lpc[i - 1 - j] += reflection * tmp;
+    }
+    if (i & 1)
+      lpc[j] += lpc[j] * reflection;
+
+    error *= 1.0 - reflection * reflection;
+    for (j = 0; j <= i; ++j)
+      predictors[i][j] = -lpc[j];
+    errors[i] = error;
+
+    // A perfect prediction can't be improved on, and the next step would divide by zero.
+    if (error <= 0.0)
+    {
+      max_order = i + 1;
+      break;
+    }
+  }
+
+  // Estimate the size of each order from its prediction error, assuming Laplacian residuals.
+  u32 order = 0;
+  double best_bits = std::numeric_limits<double>::max();
+  for (u32 i = 0; i < max_order; ++i)
+  {
+    const double bits_per_residual =
+        errors[i] > 0.0 ? std::max(0.0, 0.5 * std::log2(errors[i] * 0.5 / block_size)) : 0.0;
+    const double bits =
+        bits_per_residual * (block_size - i - 1) + (i + 1) * (16.0 + LPC_PRECISION);
+    if (bits < best_bits)
+    {
+      best_bits = bits;
+      order = i + 1;
+    }
+  }
+
+  const double* const predictor = predictors[order - 1].data();
+  const double max_coefficient =
+      std::abs(*std::max_element(predictor, predictor + order,
+                                 [](double a, double b) { return std::abs(a) < std::abs(b); }));
+  if (!(max_coefficient > 0.0))
+    return 0;
+
+  // Scale the coefficients so that the largest one uses the full precision.
+  int exponent;
+  std::frexp(max_coefficient, &exponent);
+  const int signed_shift = static_cast<int>(LPC_PRECISION) - exponent - 1;
+  if (signed_shift < 0)
+    return 0;
+  *shift = std::min(signed_shift, 15);
+
+  // Quantize while carrying the rounding error over to the next coefficient.
+  constexpr s32 max_quantized = (1 << (LPC_PRECISION - 1)) - 1;
+  constexpr s32 min_quantized = -(1 << (LPC_PRECISION - 1));
+  double rounding_error = 0.0;
+  for (u32 i = 0; i < order; ++i)
+  {
+    rounding_error += predictor[i] * (1 << *shift);
+    const s32 quantized =
+        std::clamp(static_cast<s32>(std::lround(rounding_error)), min_quantized, max_quantized);
+    rounding_error -= quantized;
+    coefficients[i] = quantized;
+  }
+
+  return order;
+}
+
+void FlacFileWriter::WriteResidual(const s32* residual, u32 block_size, u32 order,
+                                   const RiceCoding& coding)
+{
+  m_bits.Write(0, 2);  // Rice coding with 4-bit parameters
+  m_bits.Write(coding.partition_order, 4);
+  const u32 partition_size = block_size >> coding.partition_order;
+  u32 i = order;
+  for (u32 partition = 0; partition < (1u << coding.partition_order); ++partition)
+  {
+    const u32 parameter = coding.parameters[partition];
+    m_bits.Write(parameter, 4);
+    for (const u32 end = (partition + 1) * partition_size; i < end; ++i)
+      m_bits.WriteRice(residual[i], parameter);
+  }
+}
+
+FlacFileWriter::RiceCoding FlacFileWriter::ChooseRiceCoding(const s32* residual, u32 block_size,
+                                                            u32 order)
+{
+  // Partitions have to divide the block evenly, and the first one has to have room for the
+  // warm-up samples.
+  u32 max_partition_order = 0;
+  while (max_partition_order < MAX_PARTITION_ORDER &&
+         block_size % (2u << max_partition_order) == 0 &&
+         (block_size >> (max_partition_order + 1)) > order)
+  {
+    ++max_partition_order;
+  }
+
+  // Sum the folded residuals of the smallest partitions, then merge them pairwise for each lower
+  // partition order.
+  std::array<u64, 1 << MAX_PARTITION_ORDER> sums{};
+  const u32 smallest_size = block_size >> max_partition_order;
+  for (u32 i = order; i < block_size; ++i)
+    sums[i / smallest_size] += FoldResidual(residual[i]);
+
+  RiceCoding best;
+  best.bits = std::numeric_limits<u64>::max();
+  for (u32 partition_order = max_partition_order + 1; partition_order-- > 0;)
+  {
+    const u32 num_partitions = 1u << partition_order;
+    const u32 partition_size = block_size >> partition_order;
+
+    RiceCoding coding;
+    coding.partition_order = partition_order;
+    coding.bits = 6;
+    for (u32 partition = 0; partition < num_partitions; ++partition)
+    {
+      const u64 count = partition == 0 ? partition_size - order : partition_size;
+      u64 best_partition_bits = std::numeric_limits<u64>::max();
+      for (u32 parameter = 0; parameter <= MAX_RICE_PARAMETER; ++parameter)
+      {
+        // Slightly underestimates the unary parts, which is fine for comparing parameters.
+        const u64 bits = count * (parameter + 1) + (sums[partition] >> parameter);
+        if (bits < best_partition_bits)
+        {
+          best_partition_bits = bits;
+          coding.parameters[partition] = parameter;
+        }
+      }
+      coding.bits += 4 + best_partition_bits;
+    }
+
+    if (coding.bits < best.bits)
+      best = coding;
+
+    // Merge for the next lower partition order.
+    for (u32 partition = 0; partition < num_partitions / 2; ++partition)
+      sums[partition] = sums[2 * partition] + sums[2 * partition + 1];
+  }
+
+  return best;
+}
+}  // namespace AudioCommon
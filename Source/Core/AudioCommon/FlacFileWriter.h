@@ -0,0 +1,102 @@
+// Copyright 2022 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <array>
+#include <string>
+#include <vector>
+
+#include <mbedtls/md5.h>
+
+#include "Common/CommonTypes.h"
+#include "Common/IOFile.h"
+
+namespace AudioCommon
+{
+// Writes 16-bit stereo audio to a FLAC file.
+//
+// This is a small self-contained encoder rather than libFLAC: every subframe uses either one of the
+// fixed polynomial predictors or a quantized linear predictor (or is stored as a constant or
+// verbatim subframe), with partitioned Rice coding of the residual and a per-frame choice of stereo
+// decorrelation. That gets close to the compression of libFLAC's default presets, which is all that
+// audio dumping needs.
+class FlacFileWriter
+{
+public:
+  FlacFileWriter() = default;
+  ~FlacFileWriter();
+
+  FlacFileWriter(const FlacFileWriter&) = delete;
+  FlacFileWriter& operator=(const FlacFileWriter&) = delete;
+  FlacFileWriter(FlacFileWriter&&) = delete;
+  FlacFileWriter& operator=(FlacFileWriter&&) = delete;
+
+  // Overwrites the file if it already exists.
+  bool Start(const std::string& filename, u32 sample_rate);
+  void Stop();
+  bool IsOpen() const { return m_file.IsOpen(); }
+
+  // Takes interleaved left/right samples in native endianness.
+  void AddStereoSamples(const s16* samples, u32 count);
+
+private:
+  static constexpr u32 BLOCK_SIZE = 4096;
+  static constexpr u32 MAX_FIXED_ORDER = 4;
+  static constexpr u32 MAX_LPC_ORDER = 8;
+  static constexpr u32 LPC_PRECISION = 12;
+  static constexpr u32 MAX_PARTITION_ORDER = 6;
+
+  class BitWriter
+  {
+  public:
+    void Reset();
+    void Write(u32 value, u32 bits);
+    void WriteRice(s32 value, u32 parameter);
+    void AlignToByte();
+    const std::vector<u8>& GetBytes() const { return m_bytes; }
+
+  private:
+    std::vector<u8> m_bytes;
+    u64 m_accumulator = 0;
+    u32 m_bits = 0;
+  };
+
+  struct RiceCoding
+  {
+    u32 partition_order = 0;
+    std::array<u32, 1 << MAX_PARTITION_ORDER> parameters{};
+    u64 bits = 0;
+  };
+
+  void EncodeFrame(u32 block_size);
+  void EncodeSubframe(const s32* samples, u32 block_size, u32 bits_per_sample, u32 fixed_order);
+  // Returns the order of the chosen predictor, or 0 if linear prediction can't be used.
+  u32 ComputeLPC(const s32* samples, u32 block_size, s32* coefficients, u32* shift);
+  void WriteResidual(const s32* residual, u32 block_size, u32 order, const RiceCoding& coding);
+  static RiceCoding ChooseRiceCoding(const s32* residual, u32 block_size, u32 order);
+  void UpdateMD5(u32 block_size);
+  void WriteStreamInfo();
+
+  File::IOFile m_file;
+  u32 m_sample_rate = 0;
+  u64 m_total_samples = 0;
+  u32 m_frame_number = 0;
+
+  std::array<s32, BLOCK_SIZE> m_left{};
+  std::array<s32, BLOCK_SIZE> m_right{};
+  std::array<s32, BLOCK_SIZE> m_mid{};
+  std::array<s32, BLOCK_SIZE> m_side{};
+  std::array<s32, BLOCK_SIZE> m_residual{};
+  std::array<s32, BLOCK_SIZE> m_lpc_residual{};
+  std::array<double, BLOCK_SIZE> m_windowed{};
+  u32 m_buffered = 0;
+
+  // Of the unencoded samples, as little endian interleaved bytes.
+  mbedtls_md5_context m_md5{};
+  std::array<u8, 16> m_md5_digest{};
+  std::array<u8, BLOCK_SIZE * 4> m_md5_buffer{};
+
+  BitWriter m_bits;
+};
+}  // namespace AudioCommon
@@ -4,6 +4,7 @@
 #include "AudioCommon/Mixer.h"
 
 #include <algorithm>
+#include <chrono>
 #include <cmath>
 #include <cstring>
 
@@ -12,6 +13,7 @@
 #include "Common/CommonTypes.h"
 #include "Common/Logging/Log.h"
 #include "Common/Swap.h"
+#include "Common/Thread.h"
 #include "Core/Config/MainSettings.h"
 #include "Core/ConfigManager.h"
 
@@ -43,7 +45,12 @@ Mixer::Mixer(unsigned int BackendSampleRate)
 
 Mixer::~Mixer()
 {
+  StopSurroundThread();
   Config::RemoveConfigChangedCallback(m_config_changed_callback_id);
+
+  const LatencyStats stats = GetLatencyStats();
+  INFO_LOG_FMT(AUDIO_INTERFACE, "Mixer shut down with {} underruns and {} overruns", stats.underruns,
+               stats.overruns);
 }
 
 void Mixer::DoState(PointerWrap& p)
@@ -58,7 +65,8 @@ void Mixer::DoState(PointerWrap& p)
 // Executed from sound stream thread
 unsigned int Mixer::MixerFifo::Mix(short* samples, unsigned int numSamples,
                                    bool consider_framelimit, float emulationspeed,
-                                   int timing_variance)
+                                   int timing_variance, int target_latency,
+                                   bool sinc_resampling)
 {
   unsigned int currentSample = 0;
 
@@ -81,15 +89,23 @@ unsigned int Mixer::MixerFifo::Mix(short* samples, unsigned int numSamples,
   {
     float numLeft = static_cast<float>(((indexW - indexR) & INDEX_MASK) / 2);
 
-    u32 low_waterwark = m_input_sample_rate * timing_variance / 1000;
-    low_waterwark = std::min(low_waterwark, MAX_SAMPLES / 2);
-
-    m_numLeftI = (numLeft + m_numLeftI * (CONTROL_AVG - 1)) / CONTROL_AVG;
-    float offset = (m_numLeftI - low_waterwark) * CONTROL_FACTOR;
-    if (offset > MAX_FREQ_SHIFT)
-      offset = MAX_FREQ_SHIFT;
-    if (offset < -MAX_FREQ_SHIFT)
-      offset = -MAX_FREQ_SHIFT;
+    float offset;
+    if (target_latency > 0)
+    {
+      offset = UpdateLatencyControl(numLeft, numSamples, target_latency);
+    }
+    else
+    {
+      u32 low_waterwark = m_input_sample_rate * timing_variance / 1000;
+      low_waterwark = std::min(low_waterwark, MAX_SAMPLES / 2);
+
+      m_numLeftI = (numLeft + m_numLeftI * (CONTROL_AVG - 1)) / CONTROL_AVG;
+      offset = (m_numLeftI - low_waterwark) * CONTROL_FACTOR;
+      if (offset > MAX_FREQ_SHIFT)
+        offset = MAX_FREQ_SHIFT;
+      if (offset < -MAX_FREQ_SHIFT)
+        offset = -MAX_FREQ_SHIFT;
+    }
 
     aid_sample_rate = (aid_sample_rate + offset) * emulationspeed;
   }
@@ -103,28 +119,78 @@ unsigned int Mixer::MixerFifo::Mix(short* samples, unsigned int numSamples,
     return m_little_endian ? m_buffer[index] : Common::swap16(m_buffer[index]);
   };
 
-  // TODO: consider a higher-quality resampling algorithm.
-  for (; currentSample < numSamples * 2 && ((indexW - indexR) & INDEX_MASK) > 2; currentSample += 2)
+  if (sinc_resampling)
   {
-    u32 indexR2 = indexR + 2;  // next sample
-
-    s16 l1 = read_buffer(indexR & INDEX_MASK);   // current
-    s16 l2 = read_buffer(indexR2 & INDEX_MASK);  // next
-    int sampleL = ((l1 << 16) + (l2 - l1) * (u16)m_frac) >> 16;
-    sampleL = (sampleL * lvolume) >> 8;
-    sampleL += samples[currentSample + 1];
-    samples[currentSample + 1] = std::clamp(sampleL, -32767, 32767);
-
-    s16 r1 = read_buffer((indexR + 1) & INDEX_MASK);   // current
-    s16 r2 = read_buffer((indexR2 + 1) & INDEX_MASK);  // next
-    int sampleR = ((r1 << 16) + (r2 - r1) * (u16)m_frac) >> 16;
-    sampleR = (sampleR * rvolume) >> 8;
-    sampleR += samples[currentSample];
-    samples[currentSample] = std::clamp(sampleR, -32767, 32767);
-
-    m_frac += ratio;
-    indexR += 2 * (u16)(m_frac >> 16);
-    m_frac &= 0xffff;
+    using AudioCommon::SincFilterBank;
+
+    if (!m_sinc_filter.IsDesignedFor(m_input_sample_rate, m_mixer->m_sampleRate))
+      m_sinc_filter.Design(m_input_sample_rate, m_mixer->m_sampleRate);
+
+    // Convert the input that can be consumed by this call in one go, so that the filters can
+    // run over contiguous samples.
+    const u32 available_frames = ((indexW - indexR) & INDEX_MASK) / 2;
+    const u64 wanted_frames =
+        ((m_frac + u64(numSamples) * ratio) >> 16) + SincFilterBank::LOOKAHEAD + 1;
+    const u32 frames = static_cast<u32>(std::min<u64>(available_frames, wanted_frames));
+    for (u32 i = 0; i < frames; ++i)
+    {
+      m_sinc_left[SincFilterBank::HISTORY + i] = read_buffer((indexR + 2 * i) & INDEX_MASK);
+      m_sinc_right[SincFilterBank::HISTORY + i] = read_buffer((indexR + 2 * i + 1) & INDEX_MASK);
+    }
+
+    u32 position = 0;
+    for (; currentSample < numSamples * 2 && position + SincFilterBank::LOOKAHEAD < frames;
+         currentSample += 2)
+    {
+      const s16* taps = m_sinc_filter.GetTaps(m_frac);
+      constexpr u32 shift = SincFilterBank::COEFFICIENT_SHIFT;
+      constexpr s32 round = 1 << (shift - 1);
+
+      int sampleL = (SincFilterBank::Apply(&m_sinc_left[position], taps) + round) >> shift;
+      sampleL = (std::clamp(sampleL, -32768, 32767) * lvolume) >> 8;
+      sampleL += samples[currentSample + 1];
+      samples[currentSample + 1] = std::clamp(sampleL, -32767, 32767);
+
+      int sampleR = (SincFilterBank::Apply(&m_sinc_right[position], taps) + round) >> shift;
+      sampleR = (std::clamp(sampleR, -32768, 32767) * rvolume) >> 8;
+      sampleR += samples[currentSample];
+      samples[currentSample] = std::clamp(sampleR, -32767, 32767);
+
+      m_frac += ratio;
+      position += m_frac >> 16;
+      m_frac &= 0xffff;
+    }
+
+    // Keep the filter's history for the next call.
+    std::copy_n(&m_sinc_left[position], SincFilterBank::HISTORY, m_sinc_left.begin());
+    std::copy_n(&m_sinc_right[position], SincFilterBank::HISTORY, m_sinc_right.begin());
+    indexR += 2 * position;
+  }
+  else
+  {
+    for (; currentSample < numSamples * 2 && ((indexW - indexR) & INDEX_MASK) > 2;
+         currentSample += 2)
+    {
+      u32 indexR2 = indexR + 2;  // next sample
+
+      s16 l1 = read_buffer(indexR & INDEX_MASK);   // current
+      s16 l2 = read_buffer(indexR2 & INDEX_MASK);  // next
+      int sampleL = ((l1 << 16) + (l2 - l1) * (u16)m_frac) >> 16;
+      sampleL = (sampleL * lvolume) >> 8;
+      sampleL += samples[currentSample + 1];
+      samples[currentSample + 1] = std::clamp(sampleL, -32767, 32767);
+
+      s16 r1 = read_buffer((indexR + 1) & INDEX_MASK);   // current
+      s16 r2 = read_buffer((indexR2 + 1) & INDEX_MASK);  // next
+      int sampleR = ((r1 << 16) + (r2 - r1) * (u16)m_frac) >> 16;
+      sampleR = (sampleR * rvolume) >> 8;
+      sampleR += samples[currentSample];
+      samples[currentSample] = std::clamp(sampleR, -32767, 32767);
+
+      m_frac += ratio;
+      indexR += 2 * (u16)(m_frac >> 16);
+      m_frac &= 0xffff;
+    }
   }
 
   // Actual number of samples written to the buffer without padding.
@@ -151,15 +217,83 @@ unsigned int Mixer::MixerFifo::Mix(short* samples, unsigned int numSamples,
   return actual_sample_count;
 }
 
+// PI controller for the resampling ratio that holds the FIFO at the target latency. The FIFO level
+// is sampled right before the backend drains a callback's worth of samples, so it must hold at
+// least that much on top of any jitter, or every callback would underrun.
+float Mixer::MixerFifo::UpdateLatencyControl(float num_left, unsigned int num_samples,
+                                             int target_latency)
+{
+  // Don't wind up the integral while nothing is being pushed to this FIFO.
+  if (num_left == 0.0f)
+  {
+    m_latency_error_integral = 0.0f;
+    return 0.0f;
+  }
+
+  const float output_rate = static_cast<float>(m_mixer->m_sampleRate);
+  const float input_rate = static_cast<float>(m_input_sample_rate);
+  const float callback_samples = m_mixer->m_callback_samples.load() * input_rate / output_rate;
+  const float target = std::max(input_rate * target_latency / 1000.0f, callback_samples * 1.5f);
+
+  const float error = num_left - target;
+  constexpr float max_integral = MAX_FREQ_SHIFT / LATENCY_CONTROL_I;
+  m_latency_error_integral = std::clamp(m_latency_error_integral + error * num_samples / output_rate,
+                                        -max_integral, max_integral);
+
+  const float offset = LATENCY_CONTROL_P * error + LATENCY_CONTROL_I * m_latency_error_integral;
+  return std::clamp<float>(offset, -MAX_FREQ_SHIFT, MAX_FREQ_SHIFT);
+}
+
 unsigned int Mixer::Mix(short* samples, unsigned int num_samples)
 {
   if (!samples)
     return 0;
 
+  TrackCallback(num_samples);
+  CountUnderrun(MixStereo(samples, num_samples));
+  return num_samples;
+}
+
+// Track how often and for how many samples the backend calls us. This decides how full the FIFOs
+// must be kept in latency targeting mode.
+void Mixer::TrackCallback(unsigned int num_samples)
+{
+  const auto now = std::chrono::steady_clock::now();
+  if (m_last_mix_time != std::chrono::steady_clock::time_point())
+  {
+    const float interval_ms =
+        std::chrono::duration<float, std::milli>(now - m_last_mix_time).count();
+    const float avg_interval_ms = m_callback_interval_ms.load();
+    m_callback_interval_ms.store(avg_interval_ms +
+                                 (interval_ms - avg_interval_ms) * CALLBACK_AVG_FACTOR);
+    const float avg_samples = m_callback_samples.load();
+    m_callback_samples.store(avg_samples + (num_samples - avg_samples) * CALLBACK_AVG_FACTOR);
+  }
+  else
+  {
+    m_callback_samples.store(static_cast<float>(num_samples));
+  }
+  m_last_mix_time = now;
+  m_fifo_fill_ms.store(m_dma_mixer.AvailableSamples() * 1000.0f / m_sampleRate);
+}
+
+void Mixer::CountUnderrun(bool starved)
+{
+  // Only count the first of a run of starved callbacks, so that pausing doesn't count as one
+  // underrun per callback.
+  if (starved && !m_starved)
+    m_underruns.fetch_add(1, std::memory_order_relaxed);
+  m_starved = starved;
+}
+
+bool Mixer::MixStereo(short* samples, unsigned int num_samples)
+{
   memset(samples, 0, num_samples * 2 * sizeof(short));
 
   const float emulation_speed = m_config_emulation_speed;
   const int timing_variance = m_config_timing_variance;
+  const int target_latency = m_config_target_latency;
+  const bool sinc_resampling = m_config_sinc_resampling;
   if (m_config_audio_stretch)
   {
     unsigned int available_samples =
@@ -168,15 +302,15 @@ unsigned int Mixer::Mix(short* samples, unsigned int num_samples)
     m_scratch_buffer.fill(0);
 
     m_dma_mixer.Mix(m_scratch_buffer.data(), available_samples, false, emulation_speed,
-                    timing_variance);
+                    timing_variance, 0, sinc_resampling);
     m_streaming_mixer.Mix(m_scratch_buffer.data(), available_samples, false, emulation_speed,
-                          timing_variance);
+                          timing_variance, 0, sinc_resampling);
     m_wiimote_speaker_mixer.Mix(m_scratch_buffer.data(), available_samples, false, emulation_speed,
-                                timing_variance);
+                                timing_variance, 0, sinc_resampling);
     for (auto& mixer : m_gba_mixers)
     {
       mixer.Mix(m_scratch_buffer.data(), available_samples, false, emulation_speed,
-                timing_variance);
+                timing_variance, 0, sinc_resampling);
     }
 
     if (!m_is_stretching)
@@ -184,20 +318,29 @@ unsigned int Mixer::Mix(short* samples, unsigned int num_samples)
       m_stretcher.Clear();
       m_is_stretching = true;
     }
-    m_stretcher.ProcessSamples(m_scratch_buffer.data(), available_samples, num_samples);
+    m_stretcher.ProcessSamples(m_scratch_buffer.data(), available_samples, num_samples,
+                               m_speed.load());
     m_stretcher.GetStretchedSamples(samples, num_samples);
+    return false;
   }
   else
   {
-    m_dma_mixer.Mix(samples, num_samples, true, emulation_speed, timing_variance);
-    m_streaming_mixer.Mix(samples, num_samples, true, emulation_speed, timing_variance);
-    m_wiimote_speaker_mixer.Mix(samples, num_samples, true, emulation_speed, timing_variance);
+    const unsigned int dma_samples = m_dma_mixer.Mix(samples, num_samples, true, emulation_speed,
+                                                     timing_variance, target_latency,
+                                                     sinc_resampling);
+    m_streaming_mixer.Mix(samples, num_samples, true, emulation_speed, timing_variance,
+                          target_latency, sinc_resampling);
+    m_wiimote_speaker_mixer.Mix(samples, num_samples, true, emulation_speed, timing_variance,
+                                target_latency, sinc_resampling);
     for (auto& mixer : m_gba_mixers)
-      mixer.Mix(samples, num_samples, true, emulation_speed, timing_variance);
+    {
+      mixer.Mix(samples, num_samples, true, emulation_speed, timing_variance, target_latency,
+                sinc_resampling);
+    }
     m_is_stretching = false;
-  }
 
-  return num_samples;
+    return dma_samples < num_samples;
+  }
 }
 
 unsigned int Mixer::MixSurround(float* samples, unsigned int num_samples)
@@ -205,25 +348,103 @@ unsigned int Mixer::MixSurround(float* samples, unsigned int num_samples)
   if (!num_samples)
     return 0;
 
-  memset(samples, 0, num_samples * SURROUND_CHANNELS * sizeof(float));
+  TrackCallback(num_samples);
 
-  size_t needed_frames = m_surround_decoder.QueryFramesNeededForSurroundOutput(num_samples);
+  if (!m_surround_thread_running.IsSet())
+    StartSurroundThread(num_samples);
 
-  // Mix() may also use m_scratch_buffer internally, but is safe because it alternates reads
-  // and writes.
-  size_t available_frames = Mix(m_scratch_buffer.data(), static_cast<u32>(needed_frames));
-  if (available_frames != needed_frames)
+  const size_t wanted = num_samples * SURROUND_CHANNELS;
+  size_t written = 0;
+  while (written < wanted)
   {
-    ERROR_LOG_FMT(AUDIO, "Error decoding surround frames.");
-    return 0;
+    if (m_surround_current_position == m_surround_current_block.size())
+    {
+      if (!m_surround_current_block.empty())
+        m_surround_free_blocks.Push(std::move(m_surround_current_block));
+      m_surround_current_block.clear();
+      m_surround_current_position = 0;
+
+      if (!m_surround_blocks.Pop(m_surround_current_block))
+        break;
+    }
+
+    const size_t count = std::min(wanted - written,
+                                  m_surround_current_block.size() - m_surround_current_position);
+    std::copy_n(&m_surround_current_block[m_surround_current_position], count, &samples[written]);
+    m_surround_current_position += count;
+    written += count;
   }
 
-  m_surround_decoder.PutFrames(m_scratch_buffer.data(), needed_frames);
-  m_surround_decoder.ReceiveFrames(samples, num_samples);
+  // The decoder fell behind. Output silence rather than waiting for it.
+  std::fill(samples + written, samples + wanted, 0.0f);
+  CountUnderrun(written < wanted ||
+                m_surround_input_starved.exchange(false, std::memory_order_relaxed));
+
+  // Let the decoder pull as much stereo input as was just played, which keeps the surround
+  // latency constant and drains the FIFOs at the backend's pace.
+  m_surround_credit.fetch_add(num_samples, std::memory_order_release);
+  m_surround_wakeup.Set();
 
   return num_samples;
 }
 
+void Mixer::StartSurroundThread(unsigned int callback_samples)
+{
+  // The decoder needs a whole block of input before it outputs anything. Prime it with that plus
+  // enough to still have decoded audio queued when the next block is due.
+  const u32 queue_samples =
+      std::max(SURROUND_QUEUE_MS * m_sampleRate / 1000, 2 * static_cast<u32>(callback_samples));
+  m_surround_credit.store(m_surround_decoder.GetFrameBlockSize() + queue_samples);
+
+  m_surround_thread_running.Set();
+  m_surround_thread = std::thread(&Mixer::SurroundThread, this);
+}
+
+void Mixer::StopSurroundThread()
+{
+  if (!m_surround_thread_running.TestAndClear())
+    return;
+
+  m_surround_wakeup.Set();
+  m_surround_thread.join();
+}
+
+void Mixer::SurroundThread()
+{
+  Common::SetCurrentThreadName("Surround decoder");
+
+  const u32 block_size = m_surround_decoder.GetFrameBlockSize();
+  std::vector<short> stereo(block_size * 2);
+  u32 staged = 0;
+
+  while (m_surround_thread_running.IsSet())
+  {
+    const u32 credit = m_surround_credit.load(std::memory_order_acquire);
+    if (credit == 0)
+    {
+      m_surround_wakeup.Wait();
+      continue;
+    }
+
+    const u32 count = std::min(credit, block_size - staged);
+    if (MixStereo(&stereo[staged * 2], count))
+      m_surround_input_starved.store(true, std::memory_order_relaxed);
+    m_surround_credit.fetch_sub(count, std::memory_order_acq_rel);
+    staged += count;
+    if (staged < block_size)
+      continue;
+
+    staged = 0;
+    m_surround_decoder.PutFrames(stereo.data(), block_size);
+
+    std::vector<float> block;
+    if (!m_surround_free_blocks.Pop(block))
+      block.resize(block_size * SURROUND_CHANNELS);
+    m_surround_decoder.ReceiveFrames(block.data(), block_size);
+    m_surround_blocks.Push(std::move(block));
+  }
+}
+
 void Mixer::MixerFifo::PushSamples(const short* samples, unsigned int num_samples)
 {
   // Cache access in non-volatile variable
@@ -234,7 +455,10 @@ void Mixer::MixerFifo::PushSamples(const short* samples, unsigned int num_sample
   // Check if we have enough free space
   // indexW == m_indexR results in empty buffer, so indexR must always be smaller than indexW
   if (num_samples * 2 + ((indexW - m_indexR.load()) & INDEX_MASK) >= MAX_SAMPLES * 2)
+  {
+    m_overruns.fetch_add(1, std::memory_order_relaxed);
     return;
+  }
 
   // AyuanX: Actual re-sampling work has been moved to sound thread
   // to alleviate the workload on main thread
@@ -258,7 +482,7 @@ void Mixer::PushSamples(const short* samples, unsigned int num_samples)
   m_dma_mixer.PushSamples(samples, num_samples);
   int sample_rate = m_dma_mixer.GetInputSampleRate();
   if (m_log_dsp_audio)
-    m_wave_writer_dsp.AddStereoSamplesBE(samples, num_samples, sample_rate);
+    m_dumper_dsp.AddStereoSamplesBE(samples, num_samples, sample_rate);
 }
 
 void Mixer::PushStreamingSamples(const short* samples, unsigned int num_samples)
@@ -266,7 +490,7 @@ void Mixer::PushStreamingSamples(const short* samples, unsigned int num_samples)
   m_streaming_mixer.PushSamples(samples, num_samples);
   int sample_rate = m_streaming_mixer.GetInputSampleRate();
   if (m_log_dtk_audio)
-    m_wave_writer_dtk.AddStereoSamplesBE(samples, num_samples, sample_rate);
+    m_dumper_dtk.AddStereoSamplesBE(samples, num_samples, sample_rate);
 }
 
 void Mixer::PushWiimoteSpeakerSamples(const short* samples, unsigned int num_samples,
@@ -323,20 +547,18 @@ void Mixer::SetGBAVolume(int device_number, unsigned int lvolume, unsigned int r
   m_gba_mixers[device_number].SetVolume(lvolume, rvolume);
 }
 
-void Mixer::StartLogDTKAudio(const std::string& filename)
+void Mixer::StartLogDTKAudio(const std::string& base_path)
 {
   if (!m_log_dtk_audio)
   {
-    bool success = m_wave_writer_dtk.Start(filename, m_streaming_mixer.GetInputSampleRate());
+    bool success = m_dumper_dtk.Start(base_path, m_streaming_mixer.GetInputSampleRate());
     if (success)
     {
       m_log_dtk_audio = true;
-      m_wave_writer_dtk.SetSkipSilence(false);
       NOTICE_LOG_FMT(AUDIO, "Starting DTK Audio logging");
     }
     else
     {
-      m_wave_writer_dtk.Stop();
       NOTICE_LOG_FMT(AUDIO, "Unable to start DTK Audio logging");
     }
   }
@@ -351,7 +573,7 @@ void Mixer::StopLogDTKAudio()
   if (m_log_dtk_audio)
   {
     m_log_dtk_audio = false;
-    m_wave_writer_dtk.Stop();
+    m_dumper_dtk.Stop();
     NOTICE_LOG_FMT(AUDIO, "Stopping DTK Audio logging");
   }
   else
@@ -360,20 +582,18 @@ void Mixer::StopLogDTKAudio()
   }
 }
 
-void Mixer::StartLogDSPAudio(const std::string& filename)
+void Mixer::StartLogDSPAudio(const std::string& base_path)
 {
   if (!m_log_dsp_audio)
   {
-    bool success = m_wave_writer_dsp.Start(filename, m_dma_mixer.GetInputSampleRate());
+    bool success = m_dumper_dsp.Start(base_path, m_dma_mixer.GetInputSampleRate());
     if (success)
     {
       m_log_dsp_audio = true;
-      m_wave_writer_dsp.SetSkipSilence(false);
       NOTICE_LOG_FMT(AUDIO, "Starting DSP Audio logging");
     }
     else
     {
-      m_wave_writer_dsp.Stop();
       NOTICE_LOG_FMT(AUDIO, "Unable to start DSP Audio logging");
     }
   }
@@ -388,7 +608,7 @@ void Mixer::StopLogDSPAudio()
   if (m_log_dsp_audio)
   {
     m_log_dsp_audio = false;
-    m_wave_writer_dsp.Stop();
+    m_dumper_dsp.Stop();
     NOTICE_LOG_FMT(AUDIO, "Stopping DSP Audio logging");
   }
   else
@@ -402,6 +622,21 @@ void Mixer::RefreshConfig()
   m_config_emulation_speed = Config::Get(Config::MAIN_EMULATION_SPEED);
   m_config_timing_variance = Config::Get(Config::MAIN_TIMING_VARIANCE);
   m_config_audio_stretch = Config::Get(Config::MAIN_AUDIO_STRETCH);
+  m_config_target_latency = Config::Get(Config::MAIN_AUDIO_LATENCY_TARGETING) ?
+                                std::max(Config::Get(Config::MAIN_AUDIO_TARGET_LATENCY), 1) :
+                                0;
+  m_config_sinc_resampling = Config::Get(Config::MAIN_AUDIO_SINC_RESAMPLING);
+}
+
+Mixer::LatencyStats Mixer::GetLatencyStats() const
+{
+  LatencyStats stats;
+  stats.callback_interval_ms = m_callback_interval_ms.load();
+  stats.callback_samples = m_callback_samples.load();
+  stats.fifo_fill_ms = m_fifo_fill_ms.load();
+  stats.underruns = m_underruns.load();
+  stats.overruns = m_dma_mixer.GetOverrunCount();
+  return stats;
 }
 
 void Mixer::MixerFifo::DoState(PointerWrap& p)
@@ -5,11 +5,18 @@
 
 #include <array>
 #include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
 
+#include "AudioCommon/AudioDumper.h"
 #include "AudioCommon/AudioStretcher.h"
+#include "AudioCommon/SincFilterBank.h"
 #include "AudioCommon/SurroundDecoder.h"
-#include "AudioCommon/WaveFile.h"
 #include "Common/CommonTypes.h"
+#include "Common/Event.h"
+#include "Common/Flag.h"
+#include "Common/SPSCQueue.h"
 
 class PointerWrap;
 
@@ -42,21 +49,40 @@ public:
   void SetWiimoteSpeakerVolume(unsigned int lvolume, unsigned int rvolume);
   void SetGBAVolume(int device_number, unsigned int lvolume, unsigned int rvolume);
 
-  void StartLogDTKAudio(const std::string& filename);
+  void StartLogDTKAudio(const std::string& base_path);
   void StopLogDTKAudio();
 
-  void StartLogDSPAudio(const std::string& filename);
+  void StartLogDSPAudio(const std::string& base_path);
   void StopLogDSPAudio();
 
   float GetCurrentSpeed() const { return m_speed.load(); }
   void UpdateSpeed(float val) { m_speed.store(val); }
 
+  struct LatencyStats
+  {
+    // Averaged over the recent backend callbacks.
+    float callback_interval_ms;
+    float callback_samples;
+    // How much DMA audio was buffered when the backend last asked for samples.
+    float fifo_fill_ms;
+    // Runs of callbacks that couldn't be filled with DMA audio.
+    u64 underruns;
+    // DMA sample batches that were dropped because the FIFO was full.
+    u64 overruns;
+  };
+  LatencyStats GetLatencyStats() const;
+
 private:
   static constexpr u32 MAX_SAMPLES = 1024 * 4;  // 128 ms
   static constexpr u32 INDEX_MASK = MAX_SAMPLES * 2 - 1;
   static constexpr int MAX_FREQ_SHIFT = 200;  // Per 32000 Hz
   static constexpr float CONTROL_FACTOR = 0.2f;
   static constexpr u32 CONTROL_AVG = 32;  // In freq_shift per FIFO size offset
+  // Latency targeting: freq_shift per sample of FIFO level error, and per second that the error
+  // has persisted for.
+  static constexpr float LATENCY_CONTROL_P = 0.3f;
+  static constexpr float LATENCY_CONTROL_I = 1.0f;
+  static constexpr float CALLBACK_AVG_FACTOR = 1.0f / 16;
 
   const unsigned int SURROUND_CHANNELS = 6;
 
@@ -70,13 +96,17 @@ private:
     void DoState(PointerWrap& p);
     void PushSamples(const short* samples, unsigned int num_samples);
     unsigned int Mix(short* samples, unsigned int numSamples, bool consider_framelimit,
-                     float emulationspeed, int timing_variance);
+                     float emulationspeed, int timing_variance, int target_latency,
+                     bool sinc_resampling);
     void SetInputSampleRate(unsigned int rate);
     unsigned int GetInputSampleRate() const;
     void SetVolume(unsigned int lvolume, unsigned int rvolume);
     unsigned int AvailableSamples() const;
+    u64 GetOverrunCount() const { return m_overruns.load(); }
 
   private:
+    float UpdateLatencyControl(float num_left, unsigned int num_samples, int target_latency);
+
     Mixer* m_mixer;
     unsigned m_input_sample_rate;
     bool m_little_endian;
@@ -87,11 +117,28 @@ private:
     std::atomic<s32> m_LVolume{256};
     std::atomic<s32> m_RVolume{256};
     float m_numLeftI = 0.0f;
+    float m_latency_error_integral = 0.0f;
     u32 m_frac = 0;
+    std::atomic<u64> m_overruns{0};
+
+    AudioCommon::SincFilterBank m_sinc_filter;
+    // Deinterleaved, host endian copy of the input, which starts with the samples the previous
+    // call left in the filter's history.
+    std::array<s16, AudioCommon::SincFilterBank::HISTORY + MAX_SAMPLES> m_sinc_left{};
+    std::array<s16, AudioCommon::SincFilterBank::HISTORY + MAX_SAMPLES> m_sinc_right{};
   };
 
   void RefreshConfig();
 
+  void TrackCallback(unsigned int num_samples);
+  void CountUnderrun(bool starved);
+  // Returns whether there wasn't enough DMA audio to fill the buffer.
+  bool MixStereo(short* samples, unsigned int num_samples);
+
+  void StartSurroundThread(unsigned int callback_samples);
+  void StopSurroundThread();
+  void SurroundThread();
+
   MixerFifo m_dma_mixer{this, 32000, false};
   MixerFifo m_streaming_mixer{this, 48000, false};
   MixerFifo m_wiimote_speaker_mixer{this, 3000, true};
@@ -102,10 +149,28 @@ private:
   bool m_is_stretching = false;
   AudioCommon::AudioStretcher m_stretcher;
   AudioCommon::SurroundDecoder m_surround_decoder;
+
+  // Surround decoding runs ahead of the backend on its own thread, which hands decoded blocks
+  // (already in backend channel order) over to MixSurround. The thread only pulls as much stereo
+  // input as the backend has played, so surround output lags by one decoder block (512 to 4096
+  // frames depending on the DPL2 quality, 11 to 85 ms at 48 kHz) plus SURROUND_QUEUE_MS or two
+  // backend callbacks, whichever is longer.
+  static constexpr u32 SURROUND_QUEUE_MS = 20;
+  std::thread m_surround_thread;
+  Common::Flag m_surround_thread_running;
+  Common::Event m_surround_wakeup;
+  // Stereo frames the decoder may still pull.
+  std::atomic<u32> m_surround_credit{0};
+  std::atomic<bool> m_surround_input_starved{false};
+  Common::SPSCQueue<std::vector<float>> m_surround_blocks;
+  Common::SPSCQueue<std::vector<float>> m_surround_free_blocks;
+  // Only accessed by MixSurround.
+  std::vector<float> m_surround_current_block;
+  size_t m_surround_current_position = 0;
   std::array<short, MAX_SAMPLES * 2> m_scratch_buffer{};
 
-  WaveFileWriter m_wave_writer_dtk;
-  WaveFileWriter m_wave_writer_dsp;
+  AudioCommon::AudioDumper m_dumper_dtk;
+  AudioCommon::AudioDumper m_dumper_dsp;
 
   bool m_log_dtk_audio = false;
   bool m_log_dsp_audio = false;
@@ -113,9 +178,19 @@ private:
   // Current rate of emulation (1.0 = 100% speed)
   std::atomic<float> m_speed{0.0f};
 
+  // Only written by the backend's audio callback (Mix or MixSurround).
+  std::chrono::steady_clock::time_point m_last_mix_time{};
+  std::atomic<float> m_callback_interval_ms{0.0f};
+  std::atomic<float> m_callback_samples{0.0f};
+  std::atomic<float> m_fifo_fill_ms{0.0f};
+  std::atomic<u64> m_underruns{0};
+  bool m_starved = false;
+
   float m_config_emulation_speed;
   int m_config_timing_variance;
   bool m_config_audio_stretch;
+  int m_config_target_latency;
+  bool m_config_sinc_resampling;
 
   size_t m_config_changed_callback_id;
 };
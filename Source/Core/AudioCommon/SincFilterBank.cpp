@@ -0,0 +1,86 @@
+// Copyright 2022 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "AudioCommon/SincFilterBank.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "Common/Intrinsics.h"
+#include "Common/MathUtil.h"
+
+#ifdef _M_ARM_64
+#include <arm_neon.h>
+#endif
+
+namespace AudioCommon
+{
+void SincFilterBank::Design(u32 input_rate, u32 output_rate)
+{
+  m_input_rate = input_rate;
+  m_output_rate = output_rate;
+
+  // Cut off a bit below the Nyquist frequency of the lower of the two rates, so that the
+  // transition band of such a short filter doesn't let images through.
+  const double cutoff = 0.9 * std::min(1.0, static_cast<double>(output_rate) / input_rate);
+  constexpr double half_width = TAPS / 2;
+
+  for (u32 phase = 0; phase < PHASES; ++phase)
+  {
+    const double frac = static_cast<double>(phase) / PHASES;
+
+    std::array<double, TAPS> coefficients;
+    double sum = 0.0;
+    for (u32 i = 0; i < TAPS; ++i)
+    {
+      // Distance between this tap's input sample and the output sample.
+      const double x = static_cast<double>(i) - HISTORY - frac;
+      const double sinc =
+          x == 0.0 ? 1.0 : std::sin(MathUtil::PI * cutoff * x) / (MathUtil::PI * cutoff * x);
+      const double window = 0.42 + 0.5 * std::cos(MathUtil::PI * x / half_width) +
+                            0.08 * std::cos(2.0 * MathUtil::PI * x / half_width);
+      coefficients[i] = sinc * window;
+      sum += coefficients[i];
+    }
+
+    // Normalize to unity gain at DC, and put the rounding error on the largest tap so that the
+    // fixed point taps still sum up to exactly 1.0.
+    s16* taps = &m_taps[phase * TAPS];
+    s32 fixed_sum = 0;
+    u32 largest = 0;
+    for (u32 i = 0; i < TAPS; ++i)
+    {
+      taps[i] = static_cast<s16>(std::lround(coefficients[i] / sum * (1 << COEFFICIENT_SHIFT)));
+      fixed_sum += taps[i];
+      if (std::abs(taps[i]) > std::abs(taps[largest]))
+        largest = i;
+    }
+    taps[largest] += static_cast<s16>((1 << COEFFICIENT_SHIFT) - fixed_sum);
+  }
+}
+
+s32 SincFilterBank::Apply(const s16* samples, const s16* taps)
+{
+#if defined(_M_X86)
+  const __m128i lo = _mm_madd_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(samples)),
+                                    _mm_load_si128(reinterpret_cast<const __m128i*>(taps)));
+  const __m128i hi = _mm_madd_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(samples + 8)),
+                                    _mm_load_si128(reinterpret_cast<const __m128i*>(taps + 8)));
+  __m128i sum = _mm_add_epi32(lo, hi);
+  sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, _MM_SHUFFLE(1, 0, 3, 2)));
+  sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, _MM_SHUFFLE(2, 3, 0, 1)));
+  return _mm_cvtsi128_si32(sum);
+#elif defined(_M_ARM_64)
+  int32x4_t sum = vmull_s16(vld1_s16(samples), vld1_s16(taps));
+  sum = vmlal_s16(sum, vld1_s16(samples + 4), vld1_s16(taps + 4));
+  sum = vmlal_s16(sum, vld1_s16(samples + 8), vld1_s16(taps + 8));
+  sum = vmlal_s16(sum, vld1_s16(samples + 12), vld1_s16(taps + 12));
+  return vaddvq_s32(sum);
+#else
+  s32 sum = 0;
+  for (u32 i = 0; i < TAPS; ++i)
+    sum += s32(samples[i]) * taps[i];
+  return sum;
+#endif
+}
+}  // namespace AudioCommon
@@ -0,0 +1,46 @@
+// Copyright 2022 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <array>
+
+#include "Common/CommonTypes.h"
+
+namespace AudioCommon
+{
+// Polyphase bank of windowed-sinc interpolation filters.
+//
+// To produce an output sample at input position n + frac, the filter for frac is applied to the
+// input samples n - HISTORY to n + LOOKAHEAD.
+class SincFilterBank
+{
+public:
+  static constexpr u32 TAPS = 16;
+  static constexpr u32 HISTORY = TAPS / 2 - 1;
+  static constexpr u32 LOOKAHEAD = TAPS / 2;
+
+  // Designs the filters for the given input to output sample rate conversion.
+  void Design(u32 input_rate, u32 output_rate);
+  bool IsDesignedFor(u32 input_rate, u32 output_rate) const
+  {
+    return m_input_rate == input_rate && m_output_rate == output_rate;
+  }
+
+  // frac is the fractional part of the input position in 16.16 fixed point.
+  const s16* GetTaps(u32 frac) const { return &m_taps[(frac >> (16 - PHASE_BITS)) * TAPS]; }
+
+  // Returns the filtered sample, with the taps' 2.14 fixed point scale still applied.
+  static s32 Apply(const s16* samples, const s16* taps);
+
+  static constexpr u32 COEFFICIENT_SHIFT = 14;
+
+private:
+  static constexpr u32 PHASE_BITS = 8;
+  static constexpr u32 PHASES = 1 << PHASE_BITS;
+
+  alignas(16) std::array<s16, PHASES * TAPS> m_taps{};
+  u32 m_input_rate = 0;
+  u32 m_output_rate = 0;
+};
+}  // namespace AudioCommon
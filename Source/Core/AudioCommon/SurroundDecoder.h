@@ -23,6 +23,8 @@ public:
   void ReceiveFrames(float* out, const size_t num_frames_out);
   void Clear();
 
+  u32 GetFrameBlockSize() const { return m_frame_block_size; }
+
 private:
   u32 m_sample_rate;
   u32 m_frame_block_size;
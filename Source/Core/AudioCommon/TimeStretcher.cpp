@@ -0,0 +1,222 @@
+// Copyright 2022 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "AudioCommon/TimeStretcher.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#include "Common/Intrinsics.h"
+
+#ifdef _M_ARM_64
+#include <arm_neon.h>
+#endif
+
+namespace AudioCommon
+{
+// Converts a duration to a number of samples that is a multiple of 8, so that correlating two
+// stereo overlaps never needs the scalar tail.
+static u32 MillisecondsToSamples(u32 sample_rate, u32 ms)
+{
+  return std::max<u32>(sample_rate * ms / 1000 / 8 * 8, 8);
+}
+
+TimeStretcher::TimeStretcher(u32 sample_rate)
+    : m_sequence_length(MillisecondsToSamples(sample_rate, 40)),
+      m_overlap_length(MillisecondsToSamples(sample_rate, 8)),
+      m_seek_length(MillisecondsToSamples(sample_rate, 15))
+{
+  m_overlap.resize(m_overlap_length * 2);
+}
+
+void TimeStretcher::SetTempo(double tempo)
+{
+  m_tempo = tempo;
+  if (tempo > DECIMATE_TEMPO)
+    m_mode = Mode::Decimate;
+  else if (tempo > FAST_TEMPO)
+    m_mode = Mode::Fast;
+  else
+    m_mode = Mode::Quality;
+}
+
+void TimeStretcher::Clear()
+{
+  m_input.clear();
+  m_input_position = 0;
+  m_input_fraction = 0.0;
+  m_skip_samples = 0;
+  m_has_overlap = false;
+  m_output.clear();
+  m_output_position = 0;
+}
+
+void TimeStretcher::PutSamples(const s16* samples, u32 num_samples)
+{
+  // Input that the next grain starts beyond never needs to be buffered.
+  const u32 skipped = static_cast<u32>(std::min<u64>(m_skip_samples, num_samples));
+  m_skip_samples -= skipped;
+  samples += skipped * 2;
+  num_samples -= skipped;
+
+  m_input.insert(m_input.end(), samples, samples + num_samples * 2);
+  Process();
+}
+
+u32 TimeStretcher::GetAvailableSamples() const
+{
+  return static_cast<u32>(m_output.size() / 2 - m_output_position);
+}
+
+u32 TimeStretcher::ReceiveSamples(s16* samples, u32 max_samples)
+{
+  const u32 count = std::min(max_samples, GetAvailableSamples());
+  if (count == 0)
+    return 0;
+
+  std::memcpy(samples, &m_output[m_output_position * 2], count * 2 * sizeof(s16));
+  m_output_position += count;
+
+  if (m_output_position * 2 == m_output.size())
+  {
+    m_output.clear();
+    m_output_position = 0;
+  }
+
+  return count;
+}
+
+void TimeStretcher::Process()
+{
+  const u32 seek_length = m_mode == Mode::Decimate ? 0 : m_seek_length;
+  const u32 grain_length = m_sequence_length - m_overlap_length;
+
+  while (m_input.size() / 2 - m_input_position >= seek_length + m_sequence_length)
+  {
+    const s16* input = &m_input[m_input_position * 2];
+
+    u32 offset = 0;
+    if (m_has_overlap && m_mode == Mode::Quality)
+    {
+      offset = FindBestOffset(input, 0, seek_length, 1);
+    }
+    else if (m_has_overlap && m_mode == Mode::Fast)
+    {
+      // Only look at every fourth position, then refine around the best one.
+      const u32 coarse = FindBestOffset(input, 0, seek_length, 4);
+      offset = FindBestOffset(input, coarse > 3 ? coarse - 3 : 0,
+                              std::min(coarse + 4, seek_length), 1);
+    }
+
+    const s16* grain = input + offset * 2;
+    const size_t output_size = m_output.size();
+    m_output.resize(output_size + grain_length * 2);
+    s16* out = &m_output[output_size];
+
+    if (m_has_overlap)
+    {
+      for (u32 i = 0; i < m_overlap_length; ++i)
+      {
+        const s32 fade_in = static_cast<s32>(i);
+        const s32 fade_out = static_cast<s32>(m_overlap_length - i);
+        for (u32 channel = 0; channel < 2; ++channel)
+        {
+          const s32 mixed =
+              m_overlap[i * 2 + channel] * fade_out + grain[i * 2 + channel] * fade_in;
+          out[i * 2 + channel] = static_cast<s16>(mixed / static_cast<s32>(m_overlap_length));
+        }
+      }
+    }
+    else
+    {
+      std::copy_n(grain, m_overlap_length * 2, out);
+    }
+
+    std::copy(grain + m_overlap_length * 2, grain + grain_length * 2, out + m_overlap_length * 2);
+
+    // Keep what follows the grain in the input, so that the next grain fades in from the natural
+    // continuation of this one.
+    std::copy_n(grain + grain_length * 2, m_overlap_length * 2, m_overlap.begin());
+    m_has_overlap = true;
+
+    const double advance = m_tempo * grain_length + m_input_fraction;
+    const size_t whole_advance = static_cast<size_t>(advance);
+    m_input_fraction = advance - whole_advance;
+    m_input_position += whole_advance;
+
+    const size_t input_size = m_input.size() / 2;
+    if (m_input_position > input_size)
+    {
+      m_skip_samples += m_input_position - input_size;
+      m_input_position = input_size;
+    }
+  }
+
+  // Move the remaining input back to the front once enough of it has been consumed.
+  if (m_input_position >= m_sequence_length * 4)
+  {
+    m_input.erase(m_input.begin(), m_input.begin() + m_input_position * 2);
+    m_input_position = 0;
+  }
+}
+
+u32 TimeStretcher::FindBestOffset(const s16* input, u32 begin, u32 end, u32 step) const
+{
+  const u32 count = m_overlap_length * 2;
+
+  u32 best_offset = begin;
+  float best_score = -1.0f;
+  for (u32 offset = begin; offset < end; offset += step)
+  {
+    // Normalize by the energy of the candidate, so that loud positions aren't always preferred.
+    const s16* candidate = input + offset * 2;
+    const float correlation = Correlate(m_overlap.data(), candidate, count);
+    const float energy = Correlate(candidate, candidate, count);
+    const float score = correlation / std::sqrt(energy + 1.0f);
+    if (score > best_score)
+    {
+      best_score = score;
+      best_offset = offset;
+    }
+  }
+
+  return best_offset;
+}
+
+float TimeStretcher::Correlate(const s16* a, const s16* b, u32 count)
+{
+  u32 i = 0;
+  float sum = 0.0f;
+
+#if defined(_M_X86)
+  // The products of two halved samples still fit twice into an int32, which is what madd needs.
+  __m128 vector_sum = _mm_setzero_ps();
+  for (; i + 8 <= count; i += 8)
+  {
+    const __m128i va = _mm_srai_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i)), 1);
+    const __m128i vb = _mm_srai_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(b + i)), 1);
+    vector_sum = _mm_add_ps(vector_sum, _mm_cvtepi32_ps(_mm_madd_epi16(va, vb)));
+  }
+  vector_sum = _mm_add_ps(vector_sum, _mm_movehl_ps(vector_sum, vector_sum));
+  vector_sum = _mm_add_ss(vector_sum, _mm_shuffle_ps(vector_sum, vector_sum, 1));
+  sum = _mm_cvtss_f32(vector_sum);
+#elif defined(_M_ARM_64)
+  float32x4_t vector_sum = vdupq_n_f32(0.0f);
+  for (; i + 8 <= count; i += 8)
+  {
+    const int16x8_t va = vshrq_n_s16(vld1q_s16(a + i), 1);
+    const int16x8_t vb = vshrq_n_s16(vld1q_s16(b + i), 1);
+    int32x4_t products = vmull_s16(vget_low_s16(va), vget_low_s16(vb));
+    products = vmlal_s16(products, vget_high_s16(va), vget_high_s16(vb));
+    vector_sum = vaddq_f32(vector_sum, vcvtq_f32_s32(products));
+  }
+  sum = vaddvq_f32(vector_sum);
+#endif
+
+  for (; i < count; ++i)
+    sum += static_cast<float>((a[i] >> 1) * (b[i] >> 1));
+
+  return sum;
+}
+}  // namespace AudioCommon
@@ -0,0 +1,81 @@
+// Copyright 2022 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+
+namespace AudioCommon
+{
+// Changes the tempo of 16-bit stereo audio without changing its pitch, by waveform similarity
+// overlap-add (WSOLA).
+//
+// Grains of the input are copied to the output and cross-faded into each other. To play faster,
+// the input position advances by more than one grain per grain of output. Normally, each grain
+// is moved by up to a few milliseconds to where it lines up best with the end of the previous
+// one. How hard that search tries depends on the tempo, since artifacts matter less the faster
+// the emulated game runs.
+class TimeStretcher
+{
+public:
+  enum class Mode
+  {
+    // Full search for the best matching grain position.
+    Quality,
+    // Coarse search over a shorter window, for fast-forwarding.
+    Fast,
+    // No search at all. Above 2x, most of the input is never even buffered, because only every
+    // other grain (or fewer) is played.
+    Decimate,
+  };
+
+  explicit TimeStretcher(u32 sample_rate);
+
+  // The tempo is the number of input samples consumed per output sample.
+  void SetTempo(double tempo);
+  double GetTempo() const { return m_tempo; }
+  Mode GetMode() const { return m_mode; }
+
+  void PutSamples(const s16* samples, u32 num_samples);
+  u32 ReceiveSamples(s16* samples, u32 max_samples);
+  // Number of output samples that are ready to be received.
+  u32 GetAvailableSamples() const;
+  void Clear();
+
+  // Returns the sum of the products of count samples, each halved to avoid overflow.
+  static float Correlate(const s16* a, const s16* b, u32 count);
+
+private:
+  static constexpr double FAST_TEMPO = 1.5;
+  static constexpr double DECIMATE_TEMPO = 2.0;
+
+  void Process();
+  u32 FindBestOffset(const s16* input, u32 begin, u32 end, u32 step) const;
+
+  u32 m_sequence_length;
+  u32 m_overlap_length;
+  u32 m_seek_length;
+
+  double m_tempo = 1.0;
+  Mode m_mode = Mode::Quality;
+
+  // All lengths and positions are in stereo samples, while the buffers are interleaved.
+  // Consumed samples at the front of the input are only removed from time to time.
+  std::vector<s16> m_input;
+  size_t m_input_position = 0;
+  // Fractional part of the input position.
+  double m_input_fraction = 0.0;
+  // Input samples to drop as they come in, because the input position has advanced past them.
+  u64 m_skip_samples = 0;
+
+  // The input that followed the previous grain, which the next grain is cross-faded with.
+  std::vector<s16> m_overlap;
+  bool m_has_overlap = false;
+
+  std::vector<s16> m_output;
+  size_t m_output_position = 0;
+};
+}  // namespace AudioCommon
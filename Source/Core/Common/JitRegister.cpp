@@ -7,6 +7,7 @@
 #include <cstdio>
 #include <cstdlib>
 #include <fstream>
+#include <mutex>
 #include <string>
 
 #include <fmt/format.h>
@@ -21,6 +22,12 @@
 #include <unistd.h>
 #endif
 
+#ifdef __linux__
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <time.h>
+#endif
+
 #if defined USE_OPROFILE && USE_OPROFILE
 #include <opagent.h>
 #endif
@@ -36,11 +43,119 @@ static op_agent_t s_agent = nullptr;
 
 static File::IOFile s_perf_map_file;
 
+#ifdef __linux__
+// Linux perf jitdump format, see tools/perf/Documentation/jitdump-specification.txt.
+// Unlike the perf map, this includes the code itself, so perf can annotate JIT blocks.
+static File::IOFile s_jitdump_file;
+static void* s_jitdump_marker = nullptr;
+// Code is registered from both the CPU and GPU threads, and each record has to stay in one piece.
+static std::mutex s_jitdump_mutex;
+static u64 s_jitdump_code_index = 0;
+
+constexpr u32 JITDUMP_MAGIC = 0x4A695444;
+constexpr u32 JITDUMP_VERSION = 1;
+constexpr u32 JITDUMP_CODE_LOAD = 0;
+
+struct JitDumpHeader
+{
+  u32 magic;
+  u32 version;
+  u32 total_size;
+  u32 elf_mach;
+  u32 pad1;
+  u32 pid;
+  u64 timestamp;
+  u64 flags;
+};
+
+struct JitDumpCodeLoad
+{
+  u32 id;
+  u32 total_size;
+  u64 timestamp;
+  u32 pid;
+  u32 tid;
+  u64 vma;
+  u64 code_addr;
+  u64 code_size;
+  u64 code_index;
+};
+
+static u64 JitDumpTimestamp()
+{
+  // perf needs to be run with -k mono for the timestamps to match up.
+  timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return static_cast<u64>(ts.tv_sec) * 1000000000 + static_cast<u64>(ts.tv_nsec);
+}
+
+static void OpenJitDump(const std::string& dir)
+{
+  const std::string filename = fmt::format("{}/jit-{}.dump", dir, getpid());
+  if (!s_jitdump_file.Open(filename, "wb"))
+    return;
+
+  JitDumpHeader header{};
+  header.magic = JITDUMP_MAGIC;
+  header.version = JITDUMP_VERSION;
+  header.total_size = sizeof(header);
+#if defined(_M_X86_64)
+  header.elf_mach = 62;  // EM_X86_64
+#elif defined(_M_ARM_64)
+  header.elf_mach = 183;  // EM_AARCH64
+#endif
+  header.pid = static_cast<u32>(getpid());
+  header.timestamp = JitDumpTimestamp();
+  s_jitdump_file.WriteBytes(&header, sizeof(header));
+  s_jitdump_file.Flush();
+
+  // perf record finds the dump through an executable mapping of the file.
+  const long page_size = sysconf(_SC_PAGESIZE);
+  s_jitdump_marker = mmap(nullptr, page_size, PROT_READ | PROT_EXEC, MAP_PRIVATE,
+                          fileno(s_jitdump_file.GetHandle()), 0);
+  if (s_jitdump_marker == MAP_FAILED)
+    s_jitdump_marker = nullptr;
+}
+
+static void CloseJitDump()
+{
+  if (s_jitdump_marker)
+  {
+    munmap(s_jitdump_marker, sysconf(_SC_PAGESIZE));
+    s_jitdump_marker = nullptr;
+  }
+
+  if (s_jitdump_file.IsOpen())
+    s_jitdump_file.Close();
+}
+
+static void WriteJitDumpCodeLoad(const void* base_address, u32 code_size,
+                                 const std::string& symbol_name)
+{
+  std::lock_guard lk(s_jitdump_mutex);
+
+  JitDumpCodeLoad record{};
+  record.id = JITDUMP_CODE_LOAD;
+  record.total_size = static_cast<u32>(sizeof(record) + symbol_name.size() + 1 + code_size);
+  record.timestamp = JitDumpTimestamp();
+  record.pid = static_cast<u32>(getpid());
+  record.tid = static_cast<u32>(syscall(SYS_gettid));
+  record.vma = reinterpret_cast<u64>(base_address);
+  record.code_addr = reinterpret_cast<u64>(base_address);
+  record.code_size = code_size;
+  record.code_index = s_jitdump_code_index++;
+
+  s_jitdump_file.WriteBytes(&record, sizeof(record));
+  s_jitdump_file.WriteBytes(symbol_name.c_str(), symbol_name.size() + 1);
+  s_jitdump_file.WriteBytes(base_address, code_size);
+}
+#endif
+
 namespace JitRegister
 {
 static bool s_is_enabled = false;
 
-void Init(const std::string& perf_dir)
+void Init(const std::string& perf_dir, bool jitdump)
 {
 #if defined USE_OPROFILE && USE_OPROFILE
   s_agent = op_open_agent();
@@ -57,6 +172,14 @@ void Init(const std::string& perf_dir)
     std::setvbuf(s_perf_map_file.GetHandle(), nullptr, _IONBF, 0);
     s_is_enabled = true;
   }
+
+#ifdef __linux__
+  if (jitdump)
+  {
+    OpenJitDump(perf_dir.empty() ? "/tmp" : perf_dir);
+    s_is_enabled |= s_jitdump_file.IsOpen();
+  }
+#endif
 }
 
 void Shutdown()
@@ -73,6 +196,10 @@ void Shutdown()
   if (s_perf_map_file.IsOpen())
     s_perf_map_file.Close();
 
+#ifdef __linux__
+  CloseJitDump();
+#endif
+
   s_is_enabled = false;
 }
 
@@ -84,7 +211,7 @@ bool IsEnabled()
 void Register(const void* base_address, u32 code_size, const std::string& symbol_name)
 {
 #if !(defined USE_OPROFILE && USE_OPROFILE) && !defined(USE_VTUNE)
-  if (!s_perf_map_file.IsOpen())
+  if (!s_is_enabled)
     return;
 #endif
 
@@ -101,6 +228,11 @@ void Register(const void* base_address, u32 code_size, const std::string& symbol
   iJIT_NotifyEvent(iJVM_EVENT_TYPE_METHOD_LOAD_FINISHED, (void*)&jmethod);
 #endif
 
+#ifdef __linux__
+  if (s_jitdump_file.IsOpen())
+    WriteJitDumpCodeLoad(base_address, code_size, symbol_name);
+#endif
+
   // Linux perf /tmp/perf-$pid.map:
   if (!s_perf_map_file.IsOpen())
     return;
@@ -11,7 +11,8 @@
 
 namespace JitRegister
 {
-void Init(const std::string& perf_dir);
+// perf_dir is where the perf map (and, if jitdump is set, the perf jitdump file) is written.
+void Init(const std::string& perf_dir, bool jitdump);
 void Shutdown();
 void Register(const void* base_address, u32 code_size, const std::string& symbol_name);
 bool IsEnabled();
@@ -0,0 +1,83 @@
+// Copyright 2022 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+// a lockless thread-safe,
+// multiple producer, single consumer queue
+//
+// Push() is wait-free apart from the allocation and may be called from any thread.
+// Everything else must only be called from the consumer thread.
+
+#include <atomic>
+#include <utility>
+
+namespace Common
+{
+template <typename T>
+class MPSCQueue
+{
+public:
+  MPSCQueue()
+  {
+    m_read_ptr = new ElementPtr();
+    m_write_ptr.store(m_read_ptr, std::memory_order_relaxed);
+  }
+  ~MPSCQueue()
+  {
+    Clear();
+    delete m_read_ptr;
+  }
+
+  MPSCQueue(const MPSCQueue&) = delete;
+  MPSCQueue& operator=(const MPSCQueue&) = delete;
+
+  template <typename Arg>
+  void Push(Arg&& t)
+  {
+    ElementPtr* new_ptr = new ElementPtr();
+    new_ptr->current = std::forward<Arg>(t);
+    // Claim the tail first, then link it. Between the two steps the consumer sees the queue as
+    // ending at the previous element, which only delays the new element until the next Pop().
+    ElementPtr* prev_ptr = m_write_ptr.exchange(new_ptr, std::memory_order_acq_rel);
+    prev_ptr->next.store(new_ptr, std::memory_order_release);
+  }
+
+  // May return true while a Push() is still in progress on another thread.
+  bool Empty() const { return !m_read_ptr->next.load(std::memory_order_acquire); }
+
+  bool Pop(T& t)
+  {
+    // m_read_ptr is always an element whose value has already been consumed (or the initial
+    // dummy), so the next value to return lives in its successor.
+    ElementPtr* next_ptr = m_read_ptr->next.load(std::memory_order_acquire);
+    if (!next_ptr)
+      return false;
+
+    t = std::move(next_ptr->current);
+    delete m_read_ptr;
+    m_read_ptr = next_ptr;
+    return true;
+  }
+
+  // Only drops the elements that have been fully pushed.
+  void Clear()
+  {
+    for (T t; Pop(t);)
+    {
+    }
+  }
+
+private:
+  struct ElementPtr
+  {
+    T current{};
+    std::atomic<ElementPtr*> next{nullptr};
+  };
+
+  // Producers and the consumer touch different ends of the queue; keep them on separate cache
+  // lines so that pushing doesn't keep stealing the line the consumer polls.
+  alignas(64) std::atomic<ElementPtr*> m_write_ptr;
+  alignas(64) ElementPtr* m_read_ptr;
+};
+}  // namespace Common
@@ -21,6 +21,8 @@ struct WindowsMemoryRegion;
 class MemArena final
 {
 public:
+  static constexpr size_t HUGE_PAGE_SIZE = 0x200000;
+
   MemArena();
   ~MemArena();
   MemArena(const MemArena&) = delete;
@@ -34,8 +36,12 @@ public:
   /// CreateView() and ReleaseView(). Used to make a mappable region for emulated memory.
   ///
   /// @param size The amount of bytes that should be allocated in this region.
+  /// @param use_huge_pages Whether to ask the OS to back the segment with huge pages. Views only
+  /// benefit from this if both their offset and their address are aligned to HUGE_PAGE_SIZE.
+  /// On Linux, this tries to reserve pages from the hugetlb pool first and falls back to
+  /// transparent huge pages. Ignored on platforms that don't support it.
   ///
-  void GrabSHMSegment(size_t size);
+  void GrabSHMSegment(size_t size, bool use_huge_pages = false);
 
   ///
   /// Release the memory segment previously allocated with GrabSHMSegment().
@@ -43,6 +49,12 @@ public:
   ///
   void ReleaseSHMSegment();
 
+  ///
+  /// Get the alignment that the offset, size and address of every view into the segment must
+  /// have. This is HUGE_PAGE_SIZE if the segment was allocated from the hugetlb pool, 1 otherwise.
+  ///
+  size_t GetViewAlignment() const;
+
   ///
   /// Map a memory region in the memory segment previously allocated with GrabSHMSegment().
   ///
@@ -119,6 +131,14 @@ private:
   int m_shm_fd;
   void* m_reserved_region;
   std::size_t m_reserved_region_size;
+#ifdef __linux__
+  bool GrabHugeTLBSegment(size_t size);
+
+  bool m_use_huge_pages = false;
+  bool m_use_hugetlb = false;
+  void* m_hugetlb_reservation = nullptr;
+  std::size_t m_hugetlb_reservation_size = 0;
+#endif
 #endif
 #endif
 };
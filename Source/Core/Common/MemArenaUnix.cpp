@@ -5,6 +5,7 @@
 
 #include <cerrno>
 #include <cstddef>
+#include <cstdint>
 #include <cstdlib>
 #include <cstring>
 #include <set>
@@ -14,19 +15,144 @@
 #include <sys/mman.h>
 #include <unistd.h>
 
+#include "Common/Align.h"
 #include "Common/CommonFuncs.h"
 #include "Common/CommonTypes.h"
+#include "Common/FileUtil.h"
 #include "Common/Logging/Log.h"
 #include "Common/MsgHandler.h"
 #include "Common/StringUtil.h"
 
+#if defined(__linux__) && !defined(MFD_HUGE_2MB)
+// From <linux/memfd.h>, which can't be included together with glibc's definitions.
+#define MFD_HUGE_2MB (21U << 26)
+#endif
+
 namespace Common
 {
+#ifdef __linux__
+// Reserves address space that starts on a huge page boundary. mmap only guarantees alignment to
+// the base page size, so this over-reserves and trims both ends. Returns MAP_FAILED on failure.
+static void* ReserveHugePageAlignedRegion(size_t size)
+{
+  const size_t padded_size = size + MemArena::HUGE_PAGE_SIZE;
+  void* base = mmap(nullptr, padded_size, PROT_NONE, MAP_ANON | MAP_PRIVATE, -1, 0);
+  if (base == MAP_FAILED)
+    return MAP_FAILED;
+
+  u8* const start = static_cast<u8*>(base);
+  u8* const aligned = reinterpret_cast<u8*>(
+      Common::AlignUp(reinterpret_cast<uintptr_t>(start), MemArena::HUGE_PAGE_SIZE));
+  if (aligned != start)
+    munmap(start, aligned - start);
+  const size_t tail_size = (start + padded_size) - (aligned + size);
+  if (tail_size != 0)
+    munmap(aligned + size, tail_size);
+  return aligned;
+}
+
+static void AdviseHugePages(void* view, size_t size)
+{
+  if (madvise(view, size, MADV_HUGEPAGE) != 0)
+    WARN_LOG_FMT(MEMMAP, "madvise(MADV_HUGEPAGE) failed: {}", strerror(errno));
+}
+
+// memfd files live on the kernel's internal shmem mount, which only hands out transparent huge
+// pages to madvised mappings if shmem_enabled allows it.
+static void ReportShmemHugePageSupport()
+{
+  std::string shmem_enabled;
+  if (!File::ReadFileToString("/sys/kernel/mm/transparent_hugepage/shmem_enabled", shmem_enabled))
+  {
+    WARN_LOG_FMT(MEMMAP, "Huge pages were requested, but the kernel doesn't support transparent "
+                         "huge pages for shared memory");
+    return;
+  }
+
+  if (shmem_enabled.find("[never]") != std::string::npos ||
+      shmem_enabled.find("[deny]") != std::string::npos)
+  {
+    WARN_LOG_FMT(MEMMAP,
+                 "Huge pages were requested, but transparent huge pages are disabled for shared "
+                 "memory (shmem_enabled: {}). Emulated RAM will use regular pages.",
+                 StripSpaces(shmem_enabled));
+  }
+}
+
+bool MemArena::GrabHugeTLBSegment(size_t size)
+{
+  const int fd = memfd_create("dolphin-emu", MFD_CLOEXEC | MFD_HUGETLB | MFD_HUGE_2MB);
+  if (fd == -1)
+  {
+    WARN_LOG_FMT(MEMMAP, "Huge pages were requested, but memfd_create(MFD_HUGETLB) failed: {}",
+                 strerror(errno));
+    return false;
+  }
+
+  const size_t segment_size = Common::AlignUp(size, HUGE_PAGE_SIZE);
+  if (ftruncate(fd, segment_size) != 0)
+  {
+    WARN_LOG_FMT(MEMMAP, "Huge pages were requested, but resizing the hugetlb segment failed: {}",
+                 strerror(errno));
+    close(fd);
+    return false;
+  }
+
+  // Huge pages are only reserved from the pool once the file is mapped. Keeping a mapping of the
+  // whole segment around for its lifetime makes a short pool fail here rather than as a SIGBUS
+  // on first touch.
+  void* reservation = mmap(nullptr, segment_size, PROT_NONE, MAP_SHARED, fd, 0);
+  if (reservation == MAP_FAILED)
+  {
+    WARN_LOG_FMT(MEMMAP,
+                 "Huge pages were requested, but the hugetlb pool doesn't have {} free 2 MiB "
+                 "pages ({}). Falling back to transparent huge pages.",
+                 segment_size / HUGE_PAGE_SIZE, strerror(errno));
+    close(fd);
+    return false;
+  }
+
+  m_shm_fd = fd;
+  m_hugetlb_reservation = reservation;
+  m_hugetlb_reservation_size = segment_size;
+  NOTICE_LOG_FMT(MEMMAP, "Emulated RAM is backed by {} 2 MiB hugetlb pages",
+                 segment_size / HUGE_PAGE_SIZE);
+  return true;
+}
+#endif
+
 MemArena::MemArena() = default;
 MemArena::~MemArena() = default;
 
-void MemArena::GrabSHMSegment(size_t size)
+void MemArena::GrabSHMSegment(size_t size, bool use_huge_pages)
 {
+#ifdef __linux__
+  m_use_huge_pages = use_huge_pages;
+  m_use_hugetlb = use_huge_pages && GrabHugeTLBSegment(size);
+  if (m_use_hugetlb)
+    return;
+
+  // Unlike files in /dev/shm, which only get transparent huge pages if tmpfs was mounted with
+  // huge=, memfd files follow the shmem_enabled policy, which allows madvised mappings by default.
+  m_shm_fd = memfd_create("dolphin-emu", MFD_CLOEXEC);
+  if (m_shm_fd != -1)
+  {
+    if (ftruncate(m_shm_fd, size) < 0)
+      ERROR_LOG_FMT(MEMMAP, "Failed to allocate low memory space");
+    if (use_huge_pages)
+      ReportShmemHugePageSupport();
+    return;
+  }
+
+  // Kernels before 3.17 don't have memfd_create.
+  if (use_huge_pages)
+  {
+    WARN_LOG_FMT(MEMMAP, "Huge pages were requested, but memfd_create failed ({}). Emulated RAM "
+                         "will only use huge pages if /dev/shm is mounted with huge=.",
+                 strerror(errno));
+  }
+#endif
+
   const std::string file_name = "/dolphin-emu." + std::to_string(getpid());
   m_shm_fd = shm_open(file_name.c_str(), O_RDWR | O_CREAT | O_EXCL, 0600);
   if (m_shm_fd == -1)
@@ -41,21 +167,55 @@ void MemArena::GrabSHMSegment(size_t size)
 
 void MemArena::ReleaseSHMSegment()
 {
+#ifdef __linux__
+  if (m_hugetlb_reservation)
+  {
+    munmap(m_hugetlb_reservation, m_hugetlb_reservation_size);
+    m_hugetlb_reservation = nullptr;
+  }
+  m_use_hugetlb = false;
+#endif
   close(m_shm_fd);
 }
 
+size_t MemArena::GetViewAlignment() const
+{
+#ifdef __linux__
+  if (m_use_hugetlb)
+    return HUGE_PAGE_SIZE;
+#endif
+  return 1;
+}
+
 void* MemArena::CreateView(s64 offset, size_t size)
 {
-  void* retval = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, m_shm_fd, offset);
+  void* base = nullptr;
+  int flags = MAP_SHARED;
+#ifdef __linux__
+  if (m_use_huge_pages)
+  {
+    base = ReserveHugePageAlignedRegion(size);
+    if (base != MAP_FAILED)
+      flags |= MAP_FIXED;
+    else
+      base = nullptr;
+  }
+#endif
+
+  void* retval = mmap(base, size, PROT_READ | PROT_WRITE, flags, m_shm_fd, offset);
   if (retval == MAP_FAILED)
   {
     NOTICE_LOG_FMT(MEMMAP, "mmap failed");
+    if (base)
+      munmap(base, size);
     return nullptr;
   }
-  else
-  {
-    return retval;
-  }
+
+#ifdef __linux__
+  if (m_use_huge_pages && !m_use_hugetlb)
+    AdviseHugePages(retval, size);
+#endif
+  return retval;
 }
 
 void MemArena::ReleaseView(void* view, size_t size)
@@ -66,7 +226,13 @@ void MemArena::ReleaseView(void* view, size_t size)
 u8* MemArena::ReserveMemoryRegion(size_t memory_size)
 {
   const int flags = MAP_ANON | MAP_PRIVATE;
+#ifdef __linux__
+  // Huge pages can only be used for views whose address is aligned as well.
+  void* base = m_use_huge_pages ? ReserveHugePageAlignedRegion(memory_size) :
+                                  mmap(nullptr, memory_size, PROT_NONE, flags, -1, 0);
+#else
   void* base = mmap(nullptr, memory_size, PROT_NONE, flags, -1, 0);
+#endif
   if (base == MAP_FAILED)
   {
     PanicAlertFmt("Failed to map enough memory space: {}", LastStrerrorString());
@@ -94,10 +260,12 @@ void* MemArena::MapInMemoryRegion(s64 offset, size_t size, void* base)
     NOTICE_LOG_FMT(MEMMAP, "mmap failed");
     return nullptr;
   }
-  else
-  {
-    return retval;
-  }
+
+#ifdef __linux__
+  if (m_use_huge_pages && !m_use_hugetlb)
+    AdviseHugePages(retval, size);
+#endif
+  return retval;
 }
 
 void MemArena::UnmapFromMemoryRegion(void* view, size_t size)
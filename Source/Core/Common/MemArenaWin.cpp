@@ -97,7 +97,7 @@ MemArena::~MemArena()
   ReleaseSHMSegment();
 }
 
-void MemArena::GrabSHMSegment(size_t size)
+void MemArena::GrabSHMSegment(size_t size, bool use_huge_pages)
 {
   const std::string name = "dolphin-emu." + std::to_string(GetCurrentProcessId());
   m_memory_handle = CreateFileMapping(INVALID_HANDLE_VALUE, nullptr, PAGE_READWRITE, 0,
@@ -112,6 +112,11 @@ void MemArena::ReleaseSHMSegment()
   m_memory_handle = nullptr;
 }
 
+size_t MemArena::GetViewAlignment() const
+{
+  return 1;
+}
+
 void* MemArena::CreateView(s64 offset, size_t size)
 {
   return MapViewOfFileEx(m_memory_handle, FILE_MAP_ALL_ACCESS, 0, (DWORD)((u64)offset), size,
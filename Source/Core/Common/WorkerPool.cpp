@@ -0,0 +1,112 @@
+// Copyright 2022 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "Common/WorkerPool.h"
+
+#include <utility>
+
+#include "Common/Thread.h"
+
+namespace Common
+{
+void WorkerPool::Start(u32 num_workers, std::string thread_name)
+{
+  Stop();
+
+  m_shutdown = false;
+  m_workers.reserve(num_workers);
+  for (u32 i = 0; i < num_workers; ++i)
+    m_workers.emplace_back(&WorkerPool::WorkerLoop, this, thread_name);
+}
+
+void WorkerPool::Stop()
+{
+  if (m_workers.empty())
+    return;
+
+  {
+    std::lock_guard lk(m_mutex);
+    m_shutdown = true;
+  }
+  m_wakeup.notify_all();
+
+  for (std::thread& worker : m_workers)
+    worker.join();
+  m_workers.clear();
+}
+
+void WorkerPool::ParallelFor(u32 count, const std::function<void(u32)>& function)
+{
+  if (count == 0)
+    return;
+
+  if (m_workers.empty() || count == 1)
+  {
+    for (u32 i = 0; i < count; ++i)
+      function(i);
+    return;
+  }
+
+  {
+    std::unique_lock lk(m_mutex);
+
+    // A worker that woke up late for the previous loop may still be about to find out that there
+    // is nothing left to do. Don't pull the loop state from under it.
+    m_idle.wait(lk, [this] { return m_busy_workers == 0; });
+
+    m_function = &function;
+    m_count = count;
+    m_next_index.store(0, std::memory_order_relaxed);
+    m_remaining.store(count, std::memory_order_relaxed);
+    ++m_generation;
+  }
+  m_wakeup.notify_all();
+
+  RunIterations();
+
+  // Exactly one thread finishes the last iteration and sets the event.
+  m_done.Wait();
+}
+
+void WorkerPool::WorkerLoop(std::string thread_name)
+{
+  Common::SetCurrentThreadName(thread_name.c_str());
+
+  u64 last_generation = 0;
+  while (true)
+  {
+    {
+      std::unique_lock lk(m_mutex);
+      m_wakeup.wait(lk, [&] { return m_shutdown || m_generation != last_generation; });
+      if (m_shutdown)
+        return;
+
+      last_generation = m_generation;
+      ++m_busy_workers;
+    }
+
+    RunIterations();
+
+    {
+      std::lock_guard lk(m_mutex);
+      --m_busy_workers;
+    }
+    m_idle.notify_one();
+  }
+}
+
+void WorkerPool::RunIterations()
+{
+  while (true)
+  {
+    const u32 index = m_next_index.fetch_add(1, std::memory_order_relaxed);
+    if (index >= m_count)
+      return;
+
+    (*m_function)(index);
+
+    if (m_remaining.fetch_sub(1, std::memory_order_acq_rel) == 1)
+      m_done.Set();
+  }
+}
+}  // namespace Common
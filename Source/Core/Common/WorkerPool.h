@@ -0,0 +1,63 @@
+// Copyright 2022 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+#include "Common/Event.h"
+
+// A small set of threads that help the calling thread run the iterations of a loop.
+//
+// Iterations are handed out dynamically, so which thread runs a given iteration is not
+// deterministic. Callers that need deterministic results should have each iteration write to its
+// own output and combine the outputs in order afterwards.
+
+namespace Common
+{
+class WorkerPool
+{
+public:
+  WorkerPool() = default;
+  ~WorkerPool() { Stop(); }
+
+  WorkerPool(const WorkerPool&) = delete;
+  WorkerPool& operator=(const WorkerPool&) = delete;
+
+  // Starts the given number of worker threads, in addition to the thread calling ParallelFor.
+  void Start(u32 num_workers, std::string thread_name);
+  void Stop();
+
+  u32 GetWorkerCount() const { return static_cast<u32>(m_workers.size()); }
+
+  // Calls function(i) for every i in [0, count) on the calling thread and the workers, and
+  // returns once all calls have completed. Must only be called from one thread at a time.
+  void ParallelFor(u32 count, const std::function<void(u32)>& function);
+
+private:
+  void WorkerLoop(std::string thread_name);
+  void RunIterations();
+
+  std::vector<std::thread> m_workers;
+
+  std::mutex m_mutex;
+  std::condition_variable m_wakeup;
+  std::condition_variable m_idle;
+  u64 m_generation = 0;
+  u32 m_busy_workers = 0;
+  bool m_shutdown = false;
+
+  const std::function<void(u32)>* m_function = nullptr;
+  u32 m_count = 0;
+  std::atomic<u32> m_next_index{0};
+  std::atomic<u32> m_remaining{0};
+  Common::Event m_done;
+};
+}  // namespace Common
@@ -1137,6 +1137,17 @@ public:
     ABI_CallFunction(func);
   }
 
+  template <typename FunctionPointer>
+  void ABI_CallFunctionPCA(int bits, FunctionPointer func, const void* param1, u32 param2,
+                           const Gen::OpArg& arg3)
+  {
+    if (!arg3.IsSimpleReg(ABI_PARAM3))
+      MOV(bits, R(ABI_PARAM3), arg3);
+    MOV(64, R(ABI_PARAM1), Imm64(reinterpret_cast<u64>(param1)));
+    MOV(32, R(ABI_PARAM2), Imm32(param2));
+    ABI_CallFunction(func);
+  }
+
   template <typename FunctionPointer>
   void ABI_CallFunctionA(int bits, FunctionPointer func, const Gen::OpArg& arg1)
   {
@@ -1173,6 +1184,13 @@ public:
     auto trampoline = &XEmitter::CallLambdaTrampoline<T, Args...>;
     ABI_CallFunctionPC(trampoline, reinterpret_cast<const void*>(f), p1);
   }
+
+  template <typename T, typename... Args>
+  void ABI_CallLambdaCA(int bits, const std::function<T(Args...)>* f, u32 p1, const Gen::OpArg& p2)
+  {
+    auto trampoline = &XEmitter::CallLambdaTrampoline<T, Args...>;
+    ABI_CallFunctionPCA(bits, trampoline, reinterpret_cast<const void*>(f), p1, p2);
+  }
 };  // class XEmitter
 
 class X64CodeBlock : public Common::CodeBlock<XEmitter>
@@ -64,6 +64,9 @@ bool IsSettingSaveable(const Config::Location& config_location)
       &Config::MAIN_AUDIO_LATENCY.GetLocation(),
       &Config::MAIN_AUDIO_STRETCH.GetLocation(),
       &Config::MAIN_AUDIO_STRETCH_LATENCY.GetLocation(),
+      &Config::MAIN_AUDIO_LATENCY_TARGETING.GetLocation(),
+      &Config::MAIN_AUDIO_TARGET_LATENCY.GetLocation(),
+      &Config::MAIN_AUDIO_SINC_RESAMPLING.GetLocation(),
       &Config::MAIN_OVERCLOCK.GetLocation(),
       &Config::MAIN_OVERCLOCK_ENABLE.GetLocation(),
       &Config::MAIN_RAM_OVERRIDE_ENABLE.GetLocation(),
@@ -101,11 +104,15 @@ bool IsSettingSaveable(const Config::Location& config_location)
       &Config::GetInfoForSimulateKonga(3).GetLocation(),
       &Config::MAIN_EMULATION_SPEED.GetLocation(),
       &Config::MAIN_PERF_MAP_DIR.GetLocation(),
+      &Config::MAIN_PERF_JIT_DUMP.GetLocation(),
+      &Config::MAIN_SAMPLING_PROFILER_INTERVAL.GetLocation(),
+      &Config::MAIN_CORE_TIMING_TRACE_SIZE.GetLocation(),
       &Config::MAIN_GPU_DETERMINISM_MODE.GetLocation(),
       &Config::MAIN_DISABLE_ICACHE.GetLocation(),
       &Config::MAIN_FAST_DISC_SPEED.GetLocation(),
       &Config::MAIN_SYNC_ON_SKIP_IDLE.GetLocation(),
       &Config::MAIN_FASTMEM.GetLocation(),
+      &Config::MAIN_HUGE_PAGES.GetLocation(),
       &Config::MAIN_TIMING_VARIANCE.GetLocation(),
       &Config::MAIN_WII_SD_CARD.GetLocation(),
       &Config::MAIN_WII_KEYBOARD.GetLocation(),
@@ -66,6 +66,7 @@
 #include "Core/PowerPC/GDBStub.h"
 #include "Core/PowerPC/JitInterface.h"
 #include "Core/PowerPC/PowerPC.h"
+#include "Core/PowerPC/SamplingProfiler.h"
 #include "Core/State.h"
 #include "Core/System.h"
 #include "Core/WiiRoot.h"
@@ -390,9 +391,28 @@ static void CpuThread(const std::optional<std::string>& savestate_path, bool del
     }
   }
 
+  SamplingProfiler::Start(Config::Get(Config::MAIN_SAMPLING_PROFILER_INTERVAL));
+  CoreTiming::StartEventTrace(Config::Get(Config::MAIN_CORE_TIMING_TRACE_SIZE));
+
   // Enter CPU run loop. When we leave it - we are done.
   CPU::Run();
 
+  if (SamplingProfiler::IsRunning())
+  {
+    SamplingProfiler::Stop();
+    SamplingProfiler::WriteFoldedStacks(File::GetUserPath(D_DUMP_IDX) +
+                                        SConfig::GetInstance().GetGameID() + ".folded");
+  }
+
+  if (CoreTiming::IsEventTraceRunning())
+  {
+    CoreTiming::StopEventTrace();
+    const std::string path =
+        File::GetUserPath(D_DUMP_IDX) + SConfig::GetInstance().GetGameID() + "_coretiming";
+    CoreTiming::WriteEventTrace(path + ".json");
+    File::WriteStringToFile(path + ".txt", CoreTiming::GetEventTraceSummary());
+  }
+
 #ifdef USE_MEMORYWATCHER
   s_memory_watcher.reset();
 #endif
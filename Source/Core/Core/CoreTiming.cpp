@@ -4,7 +4,8 @@
 #include "Core/CoreTiming.h"
 
 #include <algorithm>
-#include <mutex>
+#include <array>
+#include <chrono>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -13,8 +14,9 @@
 
 #include "Common/Assert.h"
 #include "Common/ChunkFile.h"
+#include "Common/IOFile.h"
 #include "Common/Logging/Log.h"
-#include "Common/SPSCQueue.h"
+#include "Common/MPSCQueue.h"
 
 #include "Core/Config/MainSettings.h"
 #include "Core/Core.h"
@@ -25,10 +27,34 @@
 
 namespace CoreTiming
 {
+// Buckets are powers of two: bucket i counts values in [2^(i-1), 2^i).
+constexpr size_t TRACE_HISTOGRAM_BUCKETS = 24;
+using TraceHistogram = std::array<u64, TRACE_HISTOGRAM_BUCKETS>;
+
+struct EventTraceStats
+{
+  u64 count;
+  u64 total_host_ns;
+  u64 max_host_ns;
+  s64 max_cycles_late;
+  TraceHistogram host_ns;
+  TraceHistogram cycles_late;
+};
+
 struct EventType
 {
   TimedCallback callback;
   const std::string* name;
+  EventTraceStats trace_stats;
+};
+
+struct EventTraceRecord
+{
+  const EventType* type;
+  s64 scheduled_tick;
+  s64 tick;
+  u64 host_start_ns;
+  u64 host_ns;
 };
 
 struct Event
@@ -58,10 +84,14 @@ static std::unordered_map<std::string, EventType> s_event_types;
 // We don't use std::priority_queue because we need to be able to serialize, unserialize and
 // erase arbitrary events (RemoveEvent()) regardless of the queue order. These aren't accomodated
 // by the standard adaptor class.
+// A pairing heap was measured as well, but with the few hundred events that are pending at most,
+// the contiguous binary heap is faster.
 static std::vector<Event> s_event_queue;
 static u64 s_event_fifo_id;
-static std::mutex s_ts_write_lock;
-static Common::SPSCQueue<Event, false> s_ts_queue;
+// Events scheduled from other threads. Only the CPU thread pops from it, in MoveEvents().
+// Their time is relative to the global timer when they are moved, since other threads can't read
+// the global timer safely.
+static Common::MPSCQueue<Event> s_ts_queue;
 
 static float s_last_OC_factor;
 static constexpr int MAX_SLICE_LENGTH = 20000;
@@ -77,6 +107,12 @@ Globals g;
 
 static EventType* s_ev_lost = nullptr;
 
+static bool s_trace_running = false;
+static std::vector<EventTraceRecord> s_trace_records;
+static size_t s_trace_next_record;
+static u64 s_trace_total_records;
+static std::chrono::steady_clock::time_point s_trace_start;
+
 static size_t s_registered_config_callback_id;
 static float s_config_OC_factor;
 static float s_config_OC_inv_factor;
@@ -112,7 +148,7 @@ EventType* RegisterEvent(const std::string& name, TimedCallback callback)
              "during Init to avoid breaking save states.",
              name);
 
-  auto info = s_event_types.emplace(name, EventType{callback, nullptr});
+  auto info = s_event_types.emplace(name, EventType{callback, nullptr, {}});
   EventType* event_type = &info.first->second;
   event_type->name = &info.first->first;
   return event_type;
@@ -149,7 +185,7 @@ void Init()
 
 void Shutdown()
 {
-  std::lock_guard lk(s_ts_write_lock);
+  StopEventTrace();
   MoveEvents();
   ClearPendingEvents();
   UnregisterAllEvents();
@@ -166,7 +202,6 @@ void RefreshConfig()
 
 void DoState(PointerWrap& p)
 {
-  std::lock_guard lk(s_ts_write_lock);
   p.Do(g.slice_length);
   p.Do(g.global_timer);
   p.Do(s_idled_cycles);
@@ -282,8 +317,7 @@ void ScheduleEvent(s64 cycles_into_future, EventType* event_type, u64 userdata,
                     *event_type->name);
     }
 
-    std::lock_guard lk(s_ts_write_lock);
-    s_ts_queue.Push(Event{g.global_timer + cycles_into_future, 0, userdata, event_type});
+    s_ts_queue.Push(Event{cycles_into_future, 0, userdata, event_type});
   }
 }
 
@@ -322,12 +356,51 @@ void MoveEvents()
 {
   for (Event ev; s_ts_queue.Pop(ev);)
   {
+    ev.time += g.global_timer;
     ev.fifo_order = s_event_fifo_id++;
     s_event_queue.emplace_back(std::move(ev));
     std::push_heap(s_event_queue.begin(), s_event_queue.end(), std::greater<Event>());
   }
 }
 
+static size_t GetHistogramBucket(u64 value)
+{
+  size_t bucket = 0;
+  while (value != 0 && bucket < TRACE_HISTOGRAM_BUCKETS - 1)
+  {
+    value >>= 1;
+    ++bucket;
+  }
+  return bucket;
+}
+
+static void RunTracedCallback(const Event& evt)
+{
+  const s64 cycles_late = g.global_timer - evt.time;
+
+  const auto start = std::chrono::steady_clock::now();
+  evt.type->callback(evt.userdata, cycles_late);
+  const auto end = std::chrono::steady_clock::now();
+
+  const u64 host_start_ns = static_cast<u64>(
+      std::chrono::duration_cast<std::chrono::nanoseconds>(start - s_trace_start).count());
+  const u64 host_ns =
+      static_cast<u64>(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count());
+
+  s_trace_records[s_trace_next_record] = {evt.type, evt.time, g.global_timer, host_start_ns,
+                                          host_ns};
+  s_trace_next_record = (s_trace_next_record + 1) % s_trace_records.size();
+  ++s_trace_total_records;
+
+  EventTraceStats& stats = evt.type->trace_stats;
+  ++stats.count;
+  stats.total_host_ns += host_ns;
+  stats.max_host_ns = std::max(stats.max_host_ns, host_ns);
+  stats.max_cycles_late = std::max(stats.max_cycles_late, cycles_late);
+  ++stats.host_ns[GetHistogramBucket(host_ns)];
+  ++stats.cycles_late[GetHistogramBucket(static_cast<u64>(std::max<s64>(cycles_late, 0)))];
+}
+
 void Advance()
 {
   MoveEvents();
@@ -345,7 +418,10 @@ void Advance()
     Event evt = std::move(s_event_queue.front());
     std::pop_heap(s_event_queue.begin(), s_event_queue.end(), std::greater<Event>());
     s_event_queue.pop_back();
-    evt.type->callback(evt.userdata, g.global_timer - evt.time);
+    if (s_trace_running)
+      RunTracedCallback(evt);
+    else
+      evt.type->callback(evt.userdata, g.global_timer - evt.time);
   }
 
   s_is_global_timer_sane = false;
@@ -416,6 +492,107 @@ std::string GetScheduledEventsSummary()
   return text;
 }
 
+void StartEventTrace(u32 capacity)
+{
+  if (s_trace_running || capacity == 0)
+    return;
+
+  for (auto& [name, type] : s_event_types)
+    type.trace_stats = {};
+
+  s_trace_records.assign(capacity, EventTraceRecord{});
+  s_trace_next_record = 0;
+  s_trace_total_records = 0;
+  s_trace_start = std::chrono::steady_clock::now();
+  s_trace_running = true;
+  INFO_LOG_FMT(POWERPC, "CoreTiming event trace started ({} records)", capacity);
+}
+
+void StopEventTrace()
+{
+  if (!s_trace_running)
+    return;
+
+  s_trace_running = false;
+  INFO_LOG_FMT(POWERPC, "CoreTiming event trace stopped ({} callbacks)", s_trace_total_records);
+}
+
+bool IsEventTraceRunning()
+{
+  return s_trace_running;
+}
+
+bool WriteEventTrace(const std::string& filename)
+{
+  File::IOFile file(filename, "w");
+  if (!file)
+    return false;
+
+  // Only the last s_trace_records.size() callbacks were kept. Write them oldest first.
+  const size_t count =
+      static_cast<size_t>(std::min<u64>(s_trace_total_records, s_trace_records.size()));
+  const size_t first = count < s_trace_records.size() ? 0 : s_trace_next_record;
+
+  std::string json = "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n";
+  for (size_t i = 0; i < count; ++i)
+  {
+    const EventTraceRecord& record = s_trace_records[(first + i) % s_trace_records.size()];
+    // Timestamps are in microseconds. Event names are identifiers, so they need no escaping.
+    json += fmt::format("{}{{\"name\":\"{}\",\"cat\":\"CoreTiming\",\"ph\":\"X\",\"pid\":1,"
+                        "\"tid\":1,\"ts\":{:.3f},\"dur\":{:.3f},\"args\":{{\"scheduled_tick\":{},"
+                        "\"tick\":{},\"cycles_late\":{}}}}}",
+                        i == 0 ? "" : ",\n", *record.type->name, record.host_start_ns / 1000.0,
+                        record.host_ns / 1000.0, record.scheduled_tick, record.tick,
+                        record.tick - record.scheduled_tick);
+  }
+  json += "\n]}\n";
+
+  return file.WriteString(json);
+}
+
+static std::string FormatHistogram(const TraceHistogram& histogram)
+{
+  std::string text;
+  for (size_t i = 0; i < histogram.size(); ++i)
+  {
+    if (histogram[i] == 0)
+      continue;
+
+    // The last bucket also counts everything that is too large for the others.
+    if (i == histogram.size() - 1)
+      text += fmt::format(" >={}:{}", u64{1} << (i - 1), histogram[i]);
+    else
+      text += fmt::format(" <{}:{}", u64{1} << i, histogram[i]);
+  }
+  return text;
+}
+
+std::string GetEventTraceSummary()
+{
+  std::vector<const EventType*> types;
+  for (const auto& [name, type] : s_event_types)
+  {
+    if (type.trace_stats.count != 0)
+      types.push_back(&type);
+  }
+  std::sort(types.begin(), types.end(), [](const EventType* a, const EventType* b) {
+    return a->trace_stats.total_host_ns > b->trace_stats.total_host_ns;
+  });
+
+  std::string text = "Event callbacks by host time\n";
+  for (const EventType* type : types)
+  {
+    const EventTraceStats& stats = type->trace_stats;
+    text += fmt::format("{}: {} calls, {} us total, {} ns avg, {} ns max, {} cycles max late\n",
+                        *type->name, stats.count, stats.total_host_ns / 1000,
+                        stats.total_host_ns / stats.count, stats.max_host_ns,
+                        stats.max_cycles_late);
+    text += fmt::format("  host ns:{}\n", FormatHistogram(stats.host_ns));
+    text += fmt::format("  cycles late:{}\n", FormatHistogram(stats.cycles_late));
+  }
+  return text;
+}
+
 u32 GetFakeDecStartValue()
 {
   return s_fake_dec_start_value;
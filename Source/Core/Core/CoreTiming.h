@@ -96,6 +96,17 @@ void LogPendingEvents();
 
 std::string GetScheduledEventsSummary();
 
+// Opt-in tracing of event callbacks. Every dispatch is recorded in a ring buffer holding the last
+// `capacity` callbacks, and aggregated into per-event-type histograms of host time and lateness.
+// Must be called from the CPU thread.
+void StartEventTrace(u32 capacity);
+void StopEventTrace();
+bool IsEventTraceRunning();
+// Writes the recorded callbacks in the Chrome trace event format (chrome://tracing, Perfetto).
+bool WriteEventTrace(const std::string& filename);
+// Per-event-type statistics, sorted by the total host time spent in the callbacks.
+std::string GetEventTraceSummary();
+
 void AdjustEventQueueTimes(u32 new_ppc_clock, u32 old_ppc_clock);
 
 u32 GetFakeDecStartValue();
@@ -60,6 +60,44 @@ constexpr u16 idle_skip_sigs[NUM_IDLE_SIGS][MAX_IDLE_SIG_SIZE + 1] = {
      0, 0},
 };
 
+// Longest loop body (in instructions, including the branch) that FindWaitLoops considers.
+constexpr size_t MAX_WAIT_LOOP_SIZE = 8;
+
+// Whether reading the given data memory address has no side effects. Data memory itself and the
+// mailbox and DMA status registers are fine; reading CMBL acknowledges the mail and reading the
+// accelerator advances it.
+static bool IsSideEffectFreeRead(u16 address)
+{
+  if (address < 0xff00)
+    return true;
+
+  switch (address & 0xff)
+  {
+  case DSP_DSCR:
+  case DSP_DMBH:
+  case DSP_DMBL:
+  case DSP_CMBH:
+    return true;
+  default:
+    return false;
+  }
+}
+
+// Whether the instruction only sets flags in $sr based on registers, without an extension op.
+static bool IsTestInstruction(UDSPInstruction inst)
+{
+  const bool is_test = (inst & 0xfeff) == 0x0280 ||  // CMPI
+                       (inst & 0xfeff) == 0x02a0 ||  // ANDF
+                       (inst & 0xfeff) == 0x02c0 ||  // ANDCF
+                       (inst & 0xfe00) == 0x8600 ||  // TSTAXH
+                       (inst & 0xf700) == 0xb100;    // TST
+  if (!is_test)
+    return false;
+
+  const DSPOPCTemplate* opcode = GetOpTemplate(inst);
+  return !opcode->extended || GetExtOpTemplate(inst)->opcode == 0x0000;
+}
+
 Analyzer::Analyzer() = default;
 Analyzer::~Analyzer() = default;
 
@@ -83,6 +121,7 @@ void Analyzer::AnalyzeRange(const SDSP& dsp, u16 start_addr, u16 end_addr)
 
   // Next, we'll scan for potential idle skips.
   FindIdleSkips(dsp, start_addr, end_addr);
+  FindWaitLoops(dsp, start_addr, end_addr);
 
   INFO_LOG_FMT(DSPLLE, "Finished analysis.");
 }
@@ -170,4 +209,66 @@ void Analyzer::FindIdleSkips(const SDSP& dsp, u16 start_addr, u16 end_addr)
     }
   }
 }
+
+void Analyzer::FindWaitLoops(const SDSP& dsp, u16 start_addr, u16 end_addr)
+{
+  // Look for short loops that only read mailbox/DMA status registers or data memory and test the
+  // values that were read, e.g.
+  //   wait: LRS $AC0.M, @CMBH
+  //         ANDCF $AC0.M, #0x8000
+  //         JLNZ wait
+  // Every iteration recomputes the same state from memory, so nothing can change until the CPU,
+  // DMA or an interrupt does, and the DSP may as well give up its time slice.
+  for (u16 addr = start_addr; addr < end_addr; addr++)
+  {
+    if ((m_code_flags[addr] & (CODE_START_OF_INST | CODE_IDLE_SKIP)) != CODE_START_OF_INST)
+      continue;
+
+    bool reads_memory = false;
+    u16 pc = addr;
+    for (size_t i = 0; i < MAX_WAIT_LOOP_SIZE; i++)
+    {
+      const UDSPInstruction inst = dsp.ReadIMEM(pc);
+      const DSPOPCTemplate* opcode = GetOpTemplate(inst);
+      if (!opcode || (m_code_flags[pc] & (CODE_LOOP_START | CODE_LOOP_END)) != 0)
+        break;
+
+      if ((inst & 0xfff0) == 0x0290)  // Jcc
+      {
+        if (dsp.ReadIMEM(static_cast<u16>(pc + 1)) == addr && reads_memory)
+        {
+          INFO_LOG_FMT(DSPLLE, "Wait loop found at {:04x}", addr);
+          m_code_flags[addr] |= CODE_IDLE_SKIP;
+        }
+        break;
+      }
+
+      if ((inst & 0xffe0) == 0x00c0)  // LR
+      {
+        // Loading a stack register pushes, and loading $cr or $sr changes how other instructions
+        // behave.
+        const u16 reg = inst & 0x1f;
+        if ((reg >= DSP_REG_ST0 && reg <= DSP_REG_ST3) || reg == DSP_REG_CR || reg == DSP_REG_SR)
+          break;
+        if (!IsSideEffectFreeRead(dsp.ReadIMEM(static_cast<u16>(pc + 1))))
+          break;
+        reads_memory = true;
+      }
+      else if ((inst & 0xf800) == 0x2000)  // LRS
+      {
+        // The high byte of the address comes from $cr. Ucode sets it to 0xff so that this reads
+        // hardware registers, and anything else is a plain data memory read.
+        if (!IsSideEffectFreeRead(0xff00 | (inst & 0xff)))
+          break;
+        reads_memory = true;
+      }
+      else if (inst != 0x0000 && !IsTestInstruction(inst))  // NOP
+      {
+        break;
+      }
+
+      pc += opcode->size;
+    }
+  }
+}
 }  // namespace DSP
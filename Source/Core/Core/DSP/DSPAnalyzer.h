@@ -110,6 +110,10 @@ private:
   // Finds locations within the range [start_addr, end_addr) that may contain idle skips.
   void FindIdleSkips(const SDSP& dsp, u16 start_addr, u16 end_addr);
 
+  // Finds loops within the range [start_addr, end_addr) that wait for a mailbox, DMA or memory
+  // change without doing anything else, and marks them as idle skips.
+  void FindWaitLoops(const SDSP& dsp, u16 start_addr, u16 end_addr);
+
   // Retrieves the flags set during analysis for code in memory.
   [[nodiscard]] u8 GetCodeFlags(u16 address) const { return m_code_flags[address]; }
 
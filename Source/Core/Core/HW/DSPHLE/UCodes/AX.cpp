@@ -8,6 +8,8 @@
 #include <cstring>
 #include <iterator>
 
+#include "Common/Assert.h"
+#include "Common/CPUDetect.h"
 #include "Common/ChunkFile.h"
 #include "Common/CommonTypes.h"
 #include "Common/FileUtil.h"
@@ -15,6 +17,7 @@
 #include "Common/IOFile.h"
 #include "Common/Logging/Log.h"
 #include "Common/Swap.h"
+#include "Core/Config/MainSettings.h"
 #include "Core/Core.h"
 #include "Core/DolphinAnalytics.h"
 #include "Core/HW/DSP.h"
@@ -30,6 +33,12 @@ namespace DSP::HLE
 AXUCode::AXUCode(DSPHLE* dsphle, u32 crc) : UCodeInterface(dsphle, crc)
 {
   INFO_LOG_FMT(DSPHLE, "Instantiating AXUCode: crc={:08x}", crc);
+
+  // Leave a core each for the CPU and GPU threads.
+  const int num_threads =
+      std::min(Config::Get(Config::MAIN_AX_VOICE_THREADS), cpu_info.num_cores - 2);
+  if (num_threads > 0)
+    m_voice_workers.Start(static_cast<u32>(num_threads), "AX voice worker");
 }
 
 AXUCode::~AXUCode()
@@ -403,21 +412,124 @@ void AXUCode::DownloadAndMixWithVolume(u32 addr, u16 vol_main, u16 vol_auxa, u16
   }
 }
 
+void AXUCode::ProcessPBListOnWorkers(u32 pb_addr, u32 millis, const BufferDesc* output_buffers,
+                                     size_t num_buffers, const std::function<u32(u32)>& get_next_pb,
+                                     const std::function<u32(u32, int* const*)>& process_pb)
+{
+  ASSERT(num_buffers <= MAX_MIX_BUFFERS);
+
+  // Without workers, mix straight into the output buffers and follow the links of the processed
+  // PBs, so the list doesn't have to be walked twice.
+  if (m_voice_workers.GetWorkerCount() == 0)
+  {
+    std::array<int*, MAX_MIX_BUFFERS> buffers{};
+    for (size_t i = 0; i < num_buffers; ++i)
+      buffers[i] = output_buffers[i].ptr;
+
+    while (pb_addr)
+      pb_addr = process_pb(pb_addr, buffers.data());
+  }
+  else
+  {
+    ProcessPBListOnWorkerRuns(pb_addr, millis, output_buffers, num_buffers, get_next_pb,
+                              process_pb);
+  }
+
+  // Analytics aren't thread-safe, so quirks noticed by the workers are reported from here.
+  if (m_voices_use_initial_time_delay.exchange(false, std::memory_order_relaxed))
+    DolphinAnalytics::Instance().ReportGameQuirk(GameQuirk::USES_AX_INITIAL_TIME_DELAY);
+}
+
+void AXUCode::ProcessPBListOnWorkerRuns(u32 pb_addr, u32 millis, const BufferDesc* output_buffers,
+                                        size_t num_buffers,
+                                        const std::function<u32(u32)>& get_next_pb,
+                                        const std::function<u32(u32, int* const*)>& process_pb)
+{
+  m_pb_addresses.clear();
+  for (; pb_addr; pb_addr = get_next_pb(pb_addr))
+    m_pb_addresses.push_back(pb_addr);
+
+  const u32 num_voices = static_cast<u32>(m_pb_addresses.size());
+  const u32 num_runs =
+      std::clamp(num_voices / MIN_VOICES_PER_THREAD, 1u, m_voice_workers.GetWorkerCount() + 1);
+
+  size_t run_buffer_size = 0;
+  for (size_t i = 0; i < num_buffers; ++i)
+    run_buffer_size += millis * output_buffers[i].samples_per_milli;
+
+  // The first run mixes straight into the output buffers.
+  m_voice_mix_buffers.assign(run_buffer_size * (num_runs - 1), 0);
+
+  m_voice_workers.ParallelFor(num_runs, [&](u32 run) {
+    std::array<int*, MAX_MIX_BUFFERS> buffers{};
+    int* run_buffer = run == 0 ? nullptr : &m_voice_mix_buffers[run_buffer_size * (run - 1)];
+    for (size_t i = 0; i < num_buffers; ++i)
+    {
+      if (run == 0)
+      {
+        buffers[i] = output_buffers[i].ptr;
+      }
+      else
+      {
+        buffers[i] = run_buffer;
+        run_buffer += millis * output_buffers[i].samples_per_milli;
+      }
+    }
+
+    const u32 first_voice = run * num_voices / num_runs;
+    const u32 last_voice = (run + 1) * num_voices / num_runs;
+    for (u32 i = first_voice; i < last_voice; ++i)
+      process_pb(m_pb_addresses[i], buffers.data());
+  });
+
+  const int* run_buffer = m_voice_mix_buffers.data();
+  for (u32 run = 1; run < num_runs; ++run)
+  {
+    for (size_t i = 0; i < num_buffers; ++i)
+    {
+      const BufferDesc& buffer = output_buffers[i];
+      for (u32 j = 0; j < millis * buffer.samples_per_milli; ++j)
+        buffer.ptr[j] += *run_buffer++;
+    }
+  }
+}
+
 void AXUCode::ProcessPBList(u32 pb_addr)
 {
   // Samples per millisecond. In theory DSP sampling rate can be changed from
   // 32KHz to 48KHz, but AX always process at 32KHz.
   constexpr u32 spms = 32;
 
-  AXPB pb;
+  const std::array<BufferDesc, 9> output_buffers = {{
+      {m_samples_main_left, spms},
+      {m_samples_main_right, spms},
+      {m_samples_main_surround, spms},
+      {m_samples_auxA_left, spms},
+      {m_samples_auxA_right, spms},
+      {m_samples_auxA_surround, spms},
+      {m_samples_auxB_left, spms},
+      {m_samples_auxB_right, spms},
+      {m_samples_auxB_surround, spms},
+  }};
 
-  while (pb_addr)
-  {
-    AXBuffers buffers = {{m_samples_main_left, m_samples_main_right, m_samples_main_surround,
-                          m_samples_auxA_left, m_samples_auxA_right, m_samples_auxA_surround,
-                          m_samples_auxB_left, m_samples_auxB_right, m_samples_auxB_surround}};
+  const auto get_next_pb = [this](u32 addr) {
+    AXPB pb;
+    ReadPB(addr, pb, m_crc);
 
-    ReadPB(pb_addr, pb, m_crc);
+    // Updates may change the link to the next PB, so apply them like ProcessVoice would.
+    u16* updates = (u16*)HLEMemory_Get_Pointer(HILO_TO_32(pb.updates.data));
+    for (int curr_ms = 0; curr_ms < 5; ++curr_ms)
+      ApplyUpdatesForMs(curr_ms, pb, pb.updates.num_updates, updates);
+
+    return HILO_TO_32(pb.next_pb);
+  };
+
+  const auto process_pb = [this](u32 addr, int* const* buffer_ptrs) {
+    AXBuffers buffers;
+    std::copy_n(buffer_ptrs, std::size(buffers.ptrs), buffers.ptrs);
+
+    AXPB pb;
+    ReadPB(addr, pb, m_crc);
 
     u32 updates_addr = HILO_TO_32(pb.updates.data);
     u16* updates = (u16*)HLEMemory_Get_Pointer(updates_addr);
@@ -426,17 +538,23 @@ void AXUCode::ProcessPBList(u32 pb_addr)
     {
       ApplyUpdatesForMs(curr_ms, pb, pb.updates.num_updates, updates);
 
-      ProcessVoice(pb, buffers, spms, ConvertMixerControl(pb.mixer_control),
-                   m_coeffs_checksum ? m_coeffs.data() : nullptr);
+      if (ProcessVoice(pb, buffers, spms, ConvertMixerControl(pb.mixer_control),
+                       m_coeffs_checksum ? m_coeffs.data() : nullptr))
+      {
+        m_voices_use_initial_time_delay.store(true, std::memory_order_relaxed);
+      }
 
       // Forward the buffers
       for (auto& ptr : buffers.ptrs)
         ptr += spms;
     }
 
-    WritePB(pb_addr, pb, m_crc);
-    pb_addr = HILO_TO_32(pb.next_pb);
-  }
+    WritePB(addr, pb, m_crc);
+    return HILO_TO_32(pb.next_pb);
+  };
+
+  ProcessPBListOnWorkers(pb_addr, 5, output_buffers.data(), output_buffers.size(), get_next_pb,
+                         process_pb);
 }
 
 void AXUCode::MixAUXSamples(int aux_id, u32 write_addr, u32 read_addr)
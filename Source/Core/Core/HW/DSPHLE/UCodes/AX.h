@@ -12,11 +12,15 @@
 #pragma once
 
 #include <array>
+#include <atomic>
+#include <functional>
 #include <optional>
+#include <vector>
 
 #include "Common/BitUtils.h"
 #include "Common/CommonTypes.h"
 #include "Common/Swap.h"
+#include "Common/WorkerPool.h"
 #include "Core/HW/DSPHLE/UCodes/UCodes.h"
 #include "Core/HW/Memmap.h"
 
@@ -108,6 +112,15 @@ protected:
 
   u16 m_compressor_pos = 0;
 
+  // Voices are mixed in contiguous runs of at least this many voices per thread.
+  static constexpr u32 MIN_VOICES_PER_THREAD = 8;
+  static constexpr size_t MAX_MIX_BUFFERS = 20;
+
+  Common::WorkerPool m_voice_workers;
+  std::vector<u32> m_pb_addresses;
+  std::vector<int> m_voice_mix_buffers;
+  std::atomic<bool> m_voices_use_initial_time_delay{false};
+
   bool LoadResamplingCoefficients(bool require_same_checksum, u32 desired_checksum);
 
   // Copy a command list from memory to our temp buffer
@@ -182,6 +195,17 @@ protected:
   void SendAUXAndMix(u32 main_auxa_up, u32 auxb_s_up, u32 main_l_dl, u32 main_r_dl, u32 auxb_l_dl,
                      u32 auxb_r_dl);
 
+  // Calls process_pb for each PB of a list with the buffers it should mix into. process_pb returns
+  // the address of the next PB. With voice workers, the list is walked with get_next_pb first, and
+  // runs of voices are mixed on the workers into separate buffers, which are added to the output
+  // buffers in list order afterwards, so the result doesn't depend on the number of threads.
+  void ProcessPBListOnWorkers(u32 pb_addr, u32 millis, const BufferDesc* output_buffers,
+                              size_t num_buffers, const std::function<u32(u32)>& get_next_pb,
+                              const std::function<u32(u32, int* const*)>& process_pb);
+  void ProcessPBListOnWorkerRuns(u32 pb_addr, u32 millis, const BufferDesc* output_buffers,
+                                 size_t num_buffers, const std::function<u32(u32)>& get_next_pb,
+                                 const std::function<u32(u32, int* const*)>& process_pb);
+
   // Handle save states for main AX.
   void DoAXState(PointerWrap& p);
 
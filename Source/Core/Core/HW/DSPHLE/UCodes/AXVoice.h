@@ -16,13 +16,17 @@
 #include <memory>
 
 #include "Common/CommonTypes.h"
+#include "Common/Intrinsics.h"
 #include "Core/DSP/DSPAccelerator.h"
-#include "Core/DolphinAnalytics.h"
 #include "Core/HW/DSP.h"
 #include "Core/HW/DSPHLE/UCodes/AX.h"
 #include "Core/HW/DSPHLE/UCodes/AXStructs.h"
 #include "Core/HW/Memmap.h"
 
+#ifdef _M_ARM_64
+#include <arm_neon.h>
+#endif
+
 namespace DSP::HLE
 {
 #ifdef AX_GC
@@ -145,8 +149,9 @@ void WritePB(u32 addr, const PB_TYPE& pb, u32 crc)
   }
 }
 
-// Simulated accelerator state.
-static PB_TYPE* acc_pb;
+// Simulated accelerator state. Voices can be processed on several threads at once, so each thread
+// gets its own accelerator.
+static thread_local PB_TYPE* acc_pb;
 
 class HLEAccelerator final : public Accelerator
 {
@@ -184,19 +189,19 @@ protected:
   void WriteMemory(u32 address, u8 value) override { WriteARAM(value, address); }
 };
 
-static std::unique_ptr<Accelerator> s_accelerator = std::make_unique<HLEAccelerator>();
+static thread_local HLEAccelerator s_accelerator;
 
 // Sets up the simulated accelerator.
 void AcceleratorSetup(PB_TYPE* pb)
 {
   acc_pb = pb;
-  s_accelerator->SetStartAddress(HILO_TO_32(pb->audio_addr.loop_addr));
-  s_accelerator->SetEndAddress(HILO_TO_32(pb->audio_addr.end_addr));
-  s_accelerator->SetCurrentAddress(HILO_TO_32(pb->audio_addr.cur_addr));
-  s_accelerator->SetSampleFormat(pb->audio_addr.sample_format);
-  s_accelerator->SetYn1(pb->adpcm.yn1);
-  s_accelerator->SetYn2(pb->adpcm.yn2);
-  s_accelerator->SetPredScale(pb->adpcm.pred_scale);
+  s_accelerator.SetStartAddress(HILO_TO_32(pb->audio_addr.loop_addr));
+  s_accelerator.SetEndAddress(HILO_TO_32(pb->audio_addr.end_addr));
+  s_accelerator.SetCurrentAddress(HILO_TO_32(pb->audio_addr.cur_addr));
+  s_accelerator.SetSampleFormat(pb->audio_addr.sample_format);
+  s_accelerator.SetYn1(pb->adpcm.yn1);
+  s_accelerator.SetYn2(pb->adpcm.yn2);
+  s_accelerator.SetPredScale(pb->adpcm.pred_scale);
 }
 
 // Reads a sample from the accelerator. Also handles looping and
@@ -204,7 +209,7 @@ void AcceleratorSetup(PB_TYPE* pb)
 // by the accelerator on real hardware).
 u16 AcceleratorGetSample()
 {
-  return s_accelerator->Read(acc_pb->adpcm.coefs);
+  return s_accelerator.Read(acc_pb->adpcm.coefs);
 }
 
 // Reads samples from the input callback, resamples them to <count> samples at
@@ -353,37 +358,91 @@ void GetInputSamples(PB_TYPE& pb, s16* samples, u16 count, const s16* coeffs)
   pb.src.cur_addr_frac = (curr_pos & 0xFFFF);
 
   // Update current position, YN1, YN2 and pred scale in the PB.
-  pb.audio_addr.cur_addr_hi = static_cast<u16>(s_accelerator->GetCurrentAddress() >> 16);
-  pb.audio_addr.cur_addr_lo = static_cast<u16>(s_accelerator->GetCurrentAddress());
-  pb.adpcm.yn1 = s_accelerator->GetYn1();
-  pb.adpcm.yn2 = s_accelerator->GetYn2();
-  pb.adpcm.pred_scale = s_accelerator->GetPredScale();
+  pb.audio_addr.cur_addr_hi = static_cast<u16>(s_accelerator.GetCurrentAddress() >> 16);
+  pb.audio_addr.cur_addr_lo = static_cast<u16>(s_accelerator.GetCurrentAddress());
+  pb.adpcm.yn1 = s_accelerator.GetYn1();
+  pb.adpcm.yn2 = s_accelerator.GetYn2();
+  pb.adpcm.pred_scale = s_accelerator.GetPredScale();
+}
+
+// Multiply samples by a 1.15 fixed point volume which is increased by <volume_delta> after each
+// sample, and clamp the results. Returns the volume following the last sample.
+u16 ApplyVolume(s16* output, const s16* input, u32 count, u16 volume, u16 volume_delta)
+{
+  u32 i = 0;
+
+#if defined(_M_X86)
+  // x * v == x * (v - 0x8000) + (x << 15), and v - 0x8000 fits in a signed 16-bit lane. The second
+  // term is a multiple of 1 << 15, so adding x after the shift gives the exact same result.
+  const __m128i lane_volume_steps = _mm_mullo_epi16(_mm_set1_epi16(static_cast<s16>(volume_delta)),
+                                                    _mm_setr_epi16(0, 1, 2, 3, 4, 5, 6, 7));
+  const __m128i volume_bias = _mm_set1_epi16(-0x8000);
+  const __m128i min_sample = _mm_set1_epi16(-32767);
+  for (; i + 8 <= count; i += 8)
+  {
+    const __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&input[i]));
+    const __m128i v = _mm_xor_si128(
+        _mm_add_epi16(_mm_set1_epi16(static_cast<s16>(volume)), lane_volume_steps), volume_bias);
+
+    const __m128i product_lo = _mm_mullo_epi16(x, v);
+    const __m128i product_hi = _mm_mulhi_epi16(x, v);
+    __m128i samples_lo = _mm_srai_epi32(_mm_unpacklo_epi16(product_lo, product_hi), 15);
+    __m128i samples_hi = _mm_srai_epi32(_mm_unpackhi_epi16(product_lo, product_hi), 15);
+    samples_lo = _mm_add_epi32(samples_lo, _mm_srai_epi32(_mm_unpacklo_epi16(x, x), 16));
+    samples_hi = _mm_add_epi32(samples_hi, _mm_srai_epi32(_mm_unpackhi_epi16(x, x), 16));
+
+    const __m128i samples = _mm_max_epi16(_mm_packs_epi32(samples_lo, samples_hi), min_sample);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(&output[i]), samples);
+    volume += 8 * volume_delta;
+  }
+#elif defined(_M_ARM_64)
+  static constexpr u16 lane_indices[8] = {0, 1, 2, 3, 4, 5, 6, 7};
+  const uint16x8_t lane_volume_steps = vmulq_n_u16(vld1q_u16(lane_indices), volume_delta);
+  const int16x8_t min_sample = vdupq_n_s16(-32767);
+  for (; i + 8 <= count; i += 8)
+  {
+    const int16x8_t x = vld1q_s16(&input[i]);
+    const uint16x8_t v = vaddq_u16(vdupq_n_u16(volume), lane_volume_steps);
+
+    const int32x4_t samples_lo =
+        vmulq_s32(vmovl_s16(vget_low_s16(x)), vreinterpretq_s32_u32(vmovl_u16(vget_low_u16(v))));
+    const int32x4_t samples_hi =
+        vmulq_s32(vmovl_high_s16(x), vreinterpretq_s32_u32(vmovl_high_u16(v)));
+    const int16x8_t samples = vcombine_s16(vqmovn_s32(vshrq_n_s32(samples_lo, 15)),
+                                           vqmovn_s32(vshrq_n_s32(samples_hi, 15)));
+
+    vst1q_s16(&output[i], vmaxq_s16(samples, min_sample));
+    volume += 8 * volume_delta;
+  }
+#endif
+
+  for (; i < count; ++i)
+  {
+    const s32 sample = (s32(input[i]) * volume) >> 15;
+    output[i] = std::clamp(sample, -32767, 32767);  // -32768 ?
+    volume += volume_delta;
+  }
+
+  return volume;
 }
 
 // Add samples to an output buffer, with optional volume ramping.
 void MixAdd(int* out, const s16* input, u32 count, VolumeData* vd, s16* dpop, bool ramp)
 {
-  u16& volume = vd->volume;
-  u16 volume_delta = vd->volume_delta;
+  if (count == 0)
+    return;
 
   // If volume ramping is disabled, set volume_delta to 0. That way, the
-  // mixing loop can avoid testing if volume ramping is enabled at each step,
-  // and just add volume_delta.
-  if (!ramp)
-    volume_delta = 0;
+  // volume kernel doesn't need a separate path for constant volumes.
+  const u16 volume_delta = ramp ? vd->volume_delta : 0;
 
-  for (u32 i = 0; i < count; ++i)
-  {
-    s64 sample = input[i];
-    sample *= volume;
-    sample >>= 15;
-    sample = std::clamp((s32)sample, -32767, 32767);  // -32768 ?
+  s16 samples[MAX_SAMPLES_PER_FRAME];
+  vd->volume = ApplyVolume(samples, input, count, vd->volume, volume_delta);
 
-    out[i] += (s16)sample;
-    volume += volume_delta;
+  for (u32 i = 0; i < count; ++i)
+    out[i] += samples[i];
 
-    *dpop = (s16)sample;
-  }
+  *dpop = samples[count - 1];
 }
 
 // Execute a low pass filter on the samples using one history value. Returns
@@ -396,25 +455,22 @@ s16 LowPassFilter(s16* samples, u32 count, s16 yn1, u16 a0, u16 b0)
 }
 
 // Process 1ms of audio (for AX GC) or 3ms of audio (for AX Wii) from a PB and
-// mix it to the output buffers.
-void ProcessVoice(PB_TYPE& pb, const AXBuffers& buffers, u16 count, AXMixControl mctrl,
+// mix it to the output buffers. Returns whether the voice asked for an initial time delay, which
+// isn't implemented. This runs on the voice workers, so the caller reports that quirk.
+bool ProcessVoice(PB_TYPE& pb, const AXBuffers& buffers, u16 count, AXMixControl mctrl,
                   const s16* coeffs)
 {
   // If the voice is not running, nothing to do.
   if (pb.running != 1)
-    return;
+    return false;
 
   // Read input samples, performing sample rate conversion if needed.
   s16 samples[MAX_SAMPLES_PER_FRAME];
   GetInputSamples(pb, samples, count, coeffs);
 
   // Apply a global volume ramp using the volume envelope parameters.
-  for (u32 i = 0; i < count; ++i)
-  {
-    const s32 sample = ((s32)samples[i] * pb.vol_env.cur_volume) >> 15;
-    samples[i] = std::clamp(sample, -32767, 32767);  // -32768 ?
-    pb.vol_env.cur_volume += pb.vol_env.cur_volume_delta;
-  }
+  pb.vol_env.cur_volume = ApplyVolume(samples, samples, count, pb.vol_env.cur_volume,
+                                      static_cast<u16>(pb.vol_env.cur_volume_delta));
 
   // Optionally, execute a low pass filter
   if (pb.lpf.enabled)
@@ -497,13 +553,6 @@ void ProcessVoice(PB_TYPE& pb, const AXBuffers& buffers, u16 count, AXMixControl
 #undef MIX_ON
 #undef RAMP_ON
 
-  // Optionally, phase shift left or right channel to simulate 3D sound.
-  if (pb.initial_time_delay.on)
-  {
-    // TODO
-    DolphinAnalytics::Instance().ReportGameQuirk(GameQuirk::USES_AX_INITIAL_TIME_DELAY);
-  }
-
 #ifdef AX_WII
   // Wiimote mixing.
   if (pb.remote)
@@ -553,6 +602,10 @@ void ProcessVoice(PB_TYPE& pb, const AXBuffers& buffers, u16 count, AXMixControl
 #undef WMCHAN_MIX_RAMP
 #undef WMCHAN_MIX_ON
 #endif
+
+  // Optionally, phase shift left or right channel to simulate 3D sound.
+  // TODO
+  return pb.initial_time_delay.on != 0;
 }
 
 }  // namespace
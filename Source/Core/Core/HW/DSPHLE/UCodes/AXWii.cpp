@@ -7,6 +7,7 @@
 
 #include <algorithm>
 #include <array>
+#include <iterator>
 
 #include "Common/ChunkFile.h"
 #include "Common/CommonTypes.h"
@@ -418,46 +419,76 @@ void AXWiiUCode::ProcessPBList(u32 pb_addr)
   // 32KHz to 48KHz, but AX always process at 32KHz.
   constexpr u32 spms = 32;
 
-  AXPBWii pb;
+  const std::array<BufferDesc, 20> output_buffers = {{
+      {m_samples_main_left, 32}, {m_samples_main_right, 32}, {m_samples_main_surround, 32},
+      {m_samples_auxA_left, 32}, {m_samples_auxA_right, 32}, {m_samples_auxA_surround, 32},
+      {m_samples_auxB_left, 32}, {m_samples_auxB_right, 32}, {m_samples_auxB_surround, 32},
+      {m_samples_auxC_left, 32}, {m_samples_auxC_right, 32}, {m_samples_auxC_surround, 32},
 
-  while (pb_addr)
-  {
-    AXBuffers buffers = {{m_samples_main_left, m_samples_main_right, m_samples_main_surround,
-                          m_samples_auxA_left, m_samples_auxA_right, m_samples_auxA_surround,
-                          m_samples_auxB_left, m_samples_auxB_right, m_samples_auxB_surround,
-                          m_samples_auxC_left, m_samples_auxC_right, m_samples_auxC_surround,
-                          m_samples_wm0,       m_samples_aux0,       m_samples_wm1,
-                          m_samples_aux1,      m_samples_wm2,        m_samples_aux2,
-                          m_samples_wm3,       m_samples_aux3}};
+      {m_samples_wm0, 6},        {m_samples_aux0, 6},        {m_samples_wm1, 6},
+      {m_samples_aux1, 6},       {m_samples_wm2, 6},         {m_samples_aux2, 6},
+      {m_samples_wm3, 6},        {m_samples_aux3, 6},
+  }};
 
-    ReadPB(pb_addr, pb, m_crc);
+  const auto get_next_pb = [this](u32 addr) {
+    AXPBWii pb;
+    ReadPB(addr, pb, m_crc);
 
+    // Updates may change the link to the next PB, so apply them like ProcessVoice would.
     u16 num_updates[3];
     u16 updates[1024];
     u32 updates_addr;
     if (ExtractUpdatesFields(pb, num_updates, updates, &updates_addr))
     {
       for (int curr_ms = 0; curr_ms < 3; ++curr_ms)
-      {
         ApplyUpdatesForMs(curr_ms, pb, num_updates, updates);
-        ProcessVoice(pb, buffers, spms, ConvertMixerControl(HILO_TO_32(pb.mixer_control)),
-                     m_coeffs_checksum ? m_coeffs.data() : nullptr);
+    }
+
+    return HILO_TO_32(pb.next_pb);
+  };
+
+  const auto process_pb = [this, &output_buffers](u32 addr, int* const* buffer_ptrs) {
+    AXBuffers buffers;
+    std::copy_n(buffer_ptrs, std::size(buffers.ptrs), buffers.ptrs);
 
-        // Forward the buffers
-        for (auto& ptr : buffers.ptrs)
-          ptr += spms;
+    AXPBWii pb;
+    ReadPB(addr, pb, m_crc);
+
+    u16 num_updates[3];
+    u16 updates[1024];
+    u32 updates_addr;
+    if (ExtractUpdatesFields(pb, num_updates, updates, &updates_addr))
+    {
+      for (int curr_ms = 0; curr_ms < 3; ++curr_ms)
+      {
+        ApplyUpdatesForMs(curr_ms, pb, num_updates, updates);
+        if (ProcessVoice(pb, buffers, spms, ConvertMixerControl(HILO_TO_32(pb.mixer_control)),
+                         m_coeffs_checksum ? m_coeffs.data() : nullptr))
+        {
+          m_voices_use_initial_time_delay.store(true, std::memory_order_relaxed);
+        }
+
+        // Forward the buffers. The Wii Remote buffers hold fewer samples per millisecond.
+        for (size_t i = 0; i < output_buffers.size(); ++i)
+          buffers.ptrs[i] += output_buffers[i].samples_per_milli;
       }
       ReinjectUpdatesFields(pb, num_updates, updates_addr);
     }
     else
     {
-      ProcessVoice(pb, buffers, 96, ConvertMixerControl(HILO_TO_32(pb.mixer_control)),
-                   m_coeffs_checksum ? m_coeffs.data() : nullptr);
+      if (ProcessVoice(pb, buffers, 96, ConvertMixerControl(HILO_TO_32(pb.mixer_control)),
+                       m_coeffs_checksum ? m_coeffs.data() : nullptr))
+      {
+        m_voices_use_initial_time_delay.store(true, std::memory_order_relaxed);
+      }
     }
 
-    WritePB(pb_addr, pb, m_crc);
-    pb_addr = HILO_TO_32(pb.next_pb);
-  }
+    WritePB(addr, pb, m_crc);
+    return HILO_TO_32(pb.next_pb);
+  };
+
+  ProcessPBListOnWorkers(pb_addr, 3, output_buffers.data(), output_buffers.size(), get_next_pb,
+                         process_pb);
 }
 
 void AXWiiUCode::MixAUXSamples(int aux_id, u32 write_addr, u32 read_addr, u16 volume)
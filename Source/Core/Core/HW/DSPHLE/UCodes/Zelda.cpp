@@ -6,9 +6,11 @@
 #include <algorithm>
 #include <array>
 #include <map>
+#include <type_traits>
 
 #include "Common/ChunkFile.h"
 #include "Common/CommonTypes.h"
+#include "Common/Intrinsics.h"
 #include "Common/Logging/Log.h"
 #include "Common/Swap.h"
 #include "Core/HW/DSP.h"
@@ -17,6 +19,10 @@
 #include "Core/HW/DSPHLE/UCodes/GBA.h"
 #include "Core/HW/DSPHLE/UCodes/UCodes.h"
 
+#ifdef _M_ARM_64
+#include <arm_neon.h>
+#endif
+
 namespace DSP::HLE
 {
 // Uncomment this to have a strict version of the HLE implementation, which
@@ -965,6 +971,265 @@ struct ReverbPB
 };
 #pragma pack(pop)
 
+#if defined(_M_X86)
+// Multiplies 8 samples by an unsigned 16-bit volume, shifts the 32-bit products right and
+// saturates them back to 16 bits.
+static __m128i MultiplyByVolume(__m128i samples, u16 vol, __m128i shift)
+{
+  // There is no signed by unsigned multiplication, so multiply by the volume reinterpreted as
+  // signed, and add back the missing samples * 0x10000 if that changed its value.
+  const __m128i signed_vol = _mm_set1_epi16(static_cast<s16>(vol));
+  const __m128i lo = _mm_mullo_epi16(samples, signed_vol);
+  const __m128i hi = _mm_mulhi_epi16(samples, signed_vol);
+  __m128i products_lo = _mm_unpacklo_epi16(lo, hi);
+  __m128i products_hi = _mm_unpackhi_epi16(lo, hi);
+  if (vol & 0x8000)
+  {
+    products_lo = _mm_add_epi32(products_lo, _mm_unpacklo_epi16(_mm_setzero_si128(), samples));
+    products_hi = _mm_add_epi32(products_hi, _mm_unpackhi_epi16(_mm_setzero_si128(), samples));
+  }
+  return _mm_packs_epi32(_mm_sra_epi32(products_lo, shift), _mm_sra_epi32(products_hi, shift));
+}
+#elif defined(_M_ARM_64)
+static int16x8_t MultiplyByVolume(int16x8_t samples, u16 vol, int32x4_t shift)
+{
+  const int32x4_t products_lo = vmulq_n_s32(vmovl_s16(vget_low_s16(samples)), vol);
+  const int32x4_t products_hi = vmulq_n_s32(vmovl_s16(vget_high_s16(samples)), vol);
+  return vcombine_s16(vqmovn_s32(vshlq_s32(products_lo, shift)),
+                      vqmovn_s32(vshlq_s32(products_hi, shift)));
+}
+#endif
+
+void ZeldaAudioRenderer::ApplyVolumeInPlace(s16* buf, size_t count, u16 vol, u32 shift)
+{
+  size_t i = 0;
+#if defined(_M_X86)
+  const __m128i shift_vec = _mm_cvtsi32_si128(static_cast<int>(shift));
+  for (; i < count / 8 * 8; i += 8)
+  {
+    __m128i* ptr = reinterpret_cast<__m128i*>(buf + i);
+    _mm_storeu_si128(ptr, MultiplyByVolume(_mm_loadu_si128(ptr), vol, shift_vec));
+  }
+#elif defined(_M_ARM_64)
+  const int32x4_t shift_vec = vdupq_n_s32(-static_cast<s32>(shift));
+  for (; i < count / 8 * 8; i += 8)
+    vst1q_s16(buf + i, MultiplyByVolume(vld1q_s16(buf + i), vol, shift_vec));
+#endif
+
+  for (; i < count; ++i)
+  {
+    s32 tmp = (u32)buf[i] * (u32)vol;
+    tmp >>= shift;
+
+    buf[i] = (s16)std::clamp(tmp, -0x8000, 0x7FFF);
+  }
+}
+
+s32 ZeldaAudioRenderer::AddBuffersWithVolumeRamp(s16* dst, const s16* src, size_t count, s32 vol,
+                                                 s32 step)
+{
+  if (!vol && !step)
+    return vol;
+
+  // The volume is allowed to wrap around, like the 32-bit accumulator on the DSP, so do the
+  // arithmetic on unsigned values.
+  u32 current_vol = static_cast<u32>(vol);
+  const u32 unsigned_step = static_cast<u32>(step);
+
+  size_t i = 0;
+#if defined(_M_X86)
+  const __m128i step_vec = _mm_set1_epi32(step);
+  __m128i vol_lo = _mm_add_epi32(_mm_set1_epi32(vol),
+                                 _mm_set_epi32(static_cast<s32>(unsigned_step * 3),
+                                               static_cast<s32>(unsigned_step * 2), step, 0));
+  __m128i vol_hi = _mm_add_epi32(vol_lo, _mm_slli_epi32(step_vec, 2));
+  const __m128i step8 = _mm_slli_epi32(step_vec, 3);
+  for (; i < count / 8 * 8; i += 8)
+  {
+    // Only the integer part of the volume is used.
+    const __m128i vol_int =
+        _mm_packs_epi32(_mm_srai_epi32(vol_lo, 16), _mm_srai_epi32(vol_hi, 16));
+    const __m128i samples = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+    __m128i* out = reinterpret_cast<__m128i*>(dst + i);
+    _mm_storeu_si128(out,
+                     _mm_add_epi16(_mm_loadu_si128(out), _mm_mulhi_epi16(vol_int, samples)));
+    vol_lo = _mm_add_epi32(vol_lo, step8);
+    vol_hi = _mm_add_epi32(vol_hi, step8);
+  }
+  current_vol += static_cast<u32>(i) * unsigned_step;
+#elif defined(_M_ARM_64)
+  const s32 ramp[4] = {0, step, static_cast<s32>(unsigned_step * 2),
+                       static_cast<s32>(unsigned_step * 3)};
+  int32x4_t vol_lo = vaddq_s32(vdupq_n_s32(vol), vld1q_s32(ramp));
+  int32x4_t vol_hi = vaddq_s32(vol_lo, vdupq_n_s32(static_cast<s32>(unsigned_step * 4)));
+  const int32x4_t step8 = vdupq_n_s32(static_cast<s32>(unsigned_step * 8));
+  for (; i < count / 8 * 8; i += 8)
+  {
+    const int16x8_t samples = vld1q_s16(src + i);
+    const int32x4_t products_lo = vmull_s16(vshrn_n_s32(vol_lo, 16), vget_low_s16(samples));
+    const int32x4_t products_hi = vmull_s16(vshrn_n_s32(vol_hi, 16), vget_high_s16(samples));
+    const int16x8_t mixed =
+        vcombine_s16(vshrn_n_s32(products_lo, 16), vshrn_n_s32(products_hi, 16));
+    vst1q_s16(dst + i, vaddq_s16(vld1q_s16(dst + i), mixed));
+    vol_lo = vaddq_s32(vol_lo, step8);
+    vol_hi = vaddq_s32(vol_hi, step8);
+  }
+  current_vol += static_cast<u32>(i) * unsigned_step;
+#endif
+
+  for (; i < count; ++i)
+  {
+    dst[i] += ((static_cast<s32>(current_vol) >> 16) * src[i]) >> 16;
+    current_vol += unsigned_step;
+  }
+
+  return static_cast<s32>(current_vol);
+}
+
+void ZeldaAudioRenderer::AddBuffersWithVolume(s16* dst, const s16* src, size_t count, u16 vol)
+{
+  size_t i = 0;
+#if defined(_M_X86)
+  const __m128i shift = _mm_cvtsi32_si128(15);
+  for (; i < count / 8 * 8; i += 8)
+  {
+    const __m128i samples = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+    __m128i* out = reinterpret_cast<__m128i*>(dst + i);
+    _mm_storeu_si128(out,
+                     _mm_add_epi16(_mm_loadu_si128(out), MultiplyByVolume(samples, vol, shift)));
+  }
+#elif defined(_M_ARM_64)
+  const int32x4_t shift = vdupq_n_s32(-15);
+  for (; i < count / 8 * 8; i += 8)
+  {
+    const int16x8_t scaled = MultiplyByVolume(vld1q_s16(src + i), vol, shift);
+    vst1q_s16(dst + i, vaddq_s16(vld1q_s16(dst + i), scaled));
+  }
+#endif
+
+  for (; i < count; ++i)
+  {
+    s32 vol_src = ((s32)src[i] * (s32)vol) >> 15;
+    dst[i] += std::clamp(vol_src, -0x8000, 0x7FFF);
+  }
+}
+
+u32 ZeldaAudioRenderer::ResampleWithFilter(s16* dst, size_t count, const s16* src, u32 pos,
+                                           u32 ratio, const s16* coeffs)
+{
+  // We have 0x40 * 4 coeffs that need to be selected based on the
+  // most significant bits of the fractional part of the position. 12
+  // bits >> 6 = 6 bits = 0x40. Multiply by 4 since there are 4
+  // consecutive coeffs.
+  const auto coeffs_for = [coeffs](u32 p) { return &coeffs[((p & 0xFFF) >> 6) * 4]; };
+
+  size_t i = 0;
+#if defined(_M_X86)
+  // Four output samples at a time. The sum of the four products of an output sample can take up
+  // to 33 bits, so instead of adding them up directly, add up their quarters and the remainders
+  // of those separately, which gives exactly the sum divided by 4.
+  const __m128i remainder_mask = _mm_set1_epi32(3);
+  for (; i < count / 4 * 4; i += 4)
+  {
+    __m128i products[4];
+    for (__m128i& product : products)
+    {
+      const __m128i input = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(&src[pos >> 12]));
+      const __m128i taps = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(coeffs_for(pos)));
+      product = _mm_unpacklo_epi16(_mm_mullo_epi16(input, taps), _mm_mulhi_epi16(input, taps));
+      pos += ratio;
+    }
+
+    // Transpose, so that each vector holds the same tap for the four output samples.
+    const __m128i t0 = _mm_unpacklo_epi32(products[0], products[1]);
+    const __m128i t1 = _mm_unpackhi_epi32(products[0], products[1]);
+    const __m128i t2 = _mm_unpacklo_epi32(products[2], products[3]);
+    const __m128i t3 = _mm_unpackhi_epi32(products[2], products[3]);
+    const __m128i taps[4] = {_mm_unpacklo_epi64(t0, t2), _mm_unpackhi_epi64(t0, t2),
+                             _mm_unpacklo_epi64(t1, t3), _mm_unpackhi_epi64(t1, t3)};
+
+    __m128i quarters = _mm_setzero_si128();
+    __m128i remainders = _mm_setzero_si128();
+    for (const __m128i& tap : taps)
+    {
+      quarters = _mm_add_epi32(quarters, _mm_srai_epi32(tap, 2));
+      remainders = _mm_add_epi32(remainders, _mm_and_si128(tap, remainder_mask));
+    }
+    const __m128i sum_quarter = _mm_add_epi32(quarters, _mm_srai_epi32(remainders, 2));
+
+    // (2 * sum) >> 16 == (sum / 4) >> 13
+    const __m128i result = _mm_srai_epi32(sum_quarter, 13);
+    _mm_storel_epi64(reinterpret_cast<__m128i*>(dst + i), _mm_packs_epi32(result, result));
+  }
+#elif defined(_M_ARM_64)
+  for (; i < count; ++i)
+  {
+    const int32x4_t products = vmull_s16(vld1_s16(&src[pos >> 12]), vld1_s16(coeffs_for(pos)));
+    const s64 sum = vaddlvq_s32(products);
+    dst[i] = static_cast<s16>(std::clamp<s64>((2 * sum) >> 16, -0x8000, 0x7FFF));
+    pos += ratio;
+  }
+#endif
+
+  for (; i < count; ++i)
+  {
+    const s16* c = coeffs_for(pos);
+    const s16* input = &src[pos >> 12];
+
+    s64 dst_sample_unclamped = 0;
+    for (size_t j = 0; j < 4; ++j)
+      dst_sample_unclamped += (s64)2 * c[j] * input[j];
+    dst_sample_unclamped >>= 16;
+
+    dst[i] = (s16)std::clamp<s64>(dst_sample_unclamped, -0x8000, 0x7FFF);
+
+    pos += ratio;
+  }
+
+  return pos;
+}
+
+void ZeldaAudioRenderer::ByteSwapSamples(s16* dst, const s16* src, size_t count)
+{
+  size_t i = 0;
+#if defined(_M_X86)
+  for (; i < count / 8 * 8; i += 8)
+  {
+    const __m128i samples = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+    const __m128i swapped = _mm_or_si128(_mm_slli_epi16(samples, 8), _mm_srli_epi16(samples, 8));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), swapped);
+  }
+#elif defined(_M_ARM_64)
+  for (; i < count / 8 * 8; i += 8)
+  {
+    const uint8x16_t samples = vld1q_u8(reinterpret_cast<const u8*>(src + i));
+    vst1q_u8(reinterpret_cast<u8*>(dst + i), vrev16q_u8(samples));
+  }
+#endif
+
+  for (; i < count; ++i)
+    dst[i] = Common::swap16(src[i]);
+}
+
+void ZeldaAudioRenderer::ExpandPCM8Samples(s16* dst, const s8* src, size_t count)
+{
+  size_t i = 0;
+#if defined(_M_X86)
+  for (; i < count / 8 * 8; i += 8)
+  {
+    const __m128i samples = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(src + i));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i),
+                     _mm_unpacklo_epi8(_mm_setzero_si128(), samples));
+  }
+#elif defined(_M_ARM_64)
+  for (; i < count / 8 * 8; i += 8)
+    vst1q_s16(dst + i, vshll_n_s8(vld1_s8(src + i), 8));
+#endif
+
+  for (; i < count; ++i)
+    dst[i] = src[i] << 8;
+}
+
 void ZeldaAudioRenderer::PrepareFrame()
 {
   if (m_prepared)
@@ -1072,8 +1337,7 @@ void ZeldaAudioRenderer::ApplyReverb(bool post_rendering)
       for (u16 i = 0; i < 8; ++i)
         buffer[i] = (*last8_samples_buffers[rpb_idx])[i];
 
-      for (u16 i = 0; i < 0x50; ++i)
-        buffer[8 + i] = Common::swap16(mram_ptr[i]);
+      ByteSwapSamples(buffer.data() + 8, mram_ptr, 0x50);
 
       for (u16 i = 0; i < 8; ++i)
         (*last8_samples_buffers[rpb_idx])[i] = buffer[0x50 + i];
@@ -1122,8 +1386,7 @@ void ZeldaAudioRenderer::ApplyReverb(bool post_rendering)
       MixingBuffer* buffer = reverb_buffers[rpb_idx];
 
       // Upload the reverb data to RAM.
-      for (auto sample : *buffer)
-        *mram_ptr++ = Common::swap16(sample);
+      ByteSwapSamples(mram_ptr, buffer->data(), buffer->size());
 
       mram_buffer_idx = (mram_buffer_idx + 1) % rpb.circular_buffer_size;
       m_reverb_pb_frames_count[rpb_idx] = mram_buffer_idx;
@@ -1319,13 +1582,10 @@ void ZeldaAudioRenderer::FinalizeFrame()
   ApplyVolumeInPlace_4_12(&m_buf_front_left, m_output_volume);
   ApplyVolumeInPlace_4_12(&m_buf_front_right, m_output_volume);
 
-  u16* ram_left_buffer = (u16*)HLEMemory_Get_Pointer(m_output_lbuf_addr);
-  u16* ram_right_buffer = (u16*)HLEMemory_Get_Pointer(m_output_rbuf_addr);
-  for (size_t i = 0; i < m_buf_front_left.size(); ++i)
-  {
-    ram_left_buffer[i] = Common::swap16(m_buf_front_left[i]);
-    ram_right_buffer[i] = Common::swap16(m_buf_front_right[i]);
-  }
+  s16* ram_left_buffer = (s16*)HLEMemory_Get_Pointer(m_output_lbuf_addr);
+  s16* ram_right_buffer = (s16*)HLEMemory_Get_Pointer(m_output_rbuf_addr);
+  ByteSwapSamples(ram_left_buffer, m_buf_front_left.data(), m_buf_front_left.size());
+  ByteSwapSamples(ram_right_buffer, m_buf_front_right.data(), m_buf_front_right.size());
   m_output_lbuf_addr += sizeof(u16) * (u32)m_buf_front_left.size();
   m_output_rbuf_addr += sizeof(u16) * (u32)m_buf_front_right.size();
 
@@ -1511,25 +1771,8 @@ void ZeldaAudioRenderer::Resample(VPB* vpb, const s16* src, MixingBuffer* dst)
   }
   else
   {
-    for (auto& dst_sample : *dst)
-    {
-      // We have 0x40 * 4 coeffs that need to be selected based on the
-      // most significant bits of the fractional part of the position. 12
-      // bits >> 6 = 6 bits = 0x40. Multiply by 4 since there are 4
-      // consecutive coeffs.
-      u32 coeffs_idx = ((pos & 0xFFF) >> 6) * 4;
-      const s16* coeffs = &m_resampling_coeffs[coeffs_idx];
-      const s16* input = &src[pos >> 12];
-
-      s64 dst_sample_unclamped = 0;
-      for (size_t i = 0; i < 4; ++i)
-        dst_sample_unclamped += (s64)2 * coeffs[i] * input[i];
-      dst_sample_unclamped >>= 16;
-
-      dst_sample = (s16)std::clamp<s64>(dst_sample_unclamped, -0x8000, 0x7FFF);
-
-      pos += ratio;
-    }
+    pos = ResampleWithFilter(dst->data(), dst->size(), src, pos, ratio,
+                             m_resampling_coeffs.data());
   }
 
   for (u32 i = 0; i < 4; ++i)
@@ -1583,8 +1826,11 @@ void ZeldaAudioRenderer::DownloadPCMSamplesFromARAM(s16* dst, VPB* vpb, u16 requ
     T* src_ptr = (T*)((u8*)GetARAMPtr() + vpb->GetCurrentARAMAddr());
     u16 samples_to_download = std::min(vpb->GetRemainingLength(), (u32)requested_samples_count);
 
-    for (u16 i = 0; i < samples_to_download; ++i)
-      *dst++ = Common::FromBigEndian<T>(*src_ptr++) << (16 - 8 * sizeof(T));
+    if constexpr (std::is_same_v<T, s8>)
+      ExpandPCM8Samples(dst, src_ptr, samples_to_download);
+    else
+      ByteSwapSamples(dst, src_ptr, samples_to_download);
+    dst += samples_to_download;
 
     vpb->SetRemainingLength(vpb->GetRemainingLength() - samples_to_download);
     vpb->SetCurrentARAMAddr(vpb->GetCurrentARAMAddr() + samples_to_download * sizeof(T));
@@ -1797,18 +2043,16 @@ void ZeldaAudioRenderer::DownloadRawSamplesFromMRAM(s16* dst, VPB* vpb, u16 requ
     vpb->samples_before_loop = vpb->loop_start_position_h - vpb->current_position_h;
     if (requested_samples_count <= vpb->samples_before_loop)
     {
-      for (u16 i = 0; i < requested_samples_count; ++i)
-        *dst++ = Common::swap16(*src_ptr++);
+      ByteSwapSamples(dst, src_ptr, requested_samples_count);
       vpb->current_position_h += requested_samples_count;
     }
     else
     {
-      for (u16 i = 0; i < vpb->samples_before_loop; ++i)
-        *dst++ = Common::swap16(*src_ptr++);
+      ByteSwapSamples(dst, src_ptr, vpb->samples_before_loop);
       vpb->SetBaseAddress(vpb->GetLoopAddress());
       src_ptr = (s16*)HLEMemory_Get_Pointer(vpb->GetLoopAddress());
-      for (u16 i = vpb->samples_before_loop; i < requested_samples_count; ++i)
-        *dst++ = Common::swap16(*src_ptr++);
+      ByteSwapSamples(dst + vpb->samples_before_loop, src_ptr,
+                      requested_samples_count - vpb->samples_before_loop);
       vpb->current_position_h = requested_samples_count - vpb->samples_before_loop;
     }
   }
@@ -3,7 +3,6 @@
 
 #pragma once
 
-#include <algorithm>
 #include <array>
 
 #include "Common/CommonTypes.h"
@@ -33,68 +32,56 @@ public:
   void SetARAMBaseAddr(u32 addr) { m_aram_base_addr = addr; }
   void DoState(PointerWrap& p);
 
+  // The sample processing kernels below are vectorized where the host supports it, and produce
+  // exactly the same results as the scalar code modelled after the DSP ucode.
+
+  // Apply volume to a buffer. The volume is a fixed point integer, usually
+  // 1.15 or 4.12 in the DAC UCode, so the product is shifted right by 15 or 12.
+  static void ApplyVolumeInPlace(s16* buf, size_t count, u16 vol, u32 shift);
+
+  // Mixes two buffers together while applying a volume to one of them. The
+  // volume ramps up/down in count steps using the provided step delta value.
+  // Returns the volume after the last step.
+  //
+  // Note: On a real GC, the stepping happens in 32 steps instead. But hey,
+  // we can do better here with very low risk. Why not? :)
+  static s32 AddBuffersWithVolumeRamp(s16* dst, const s16* src, size_t count, s32 vol, s32 step);
+
+  // Same without a ramp. Volume is in 1.15 format.
+  static void AddBuffersWithVolume(s16* dst, const s16* src, size_t count, u16 vol);
+
+  // Resamples src into count samples with a 4-tap filter, whose coefficients are selected by the
+  // fractional part of the position. The position and ratio are in 20.12 format. Returns the
+  // position after the last sample.
+  static u32 ResampleWithFilter(s16* dst, size_t count, const s16* src, u32 pos, u32 ratio,
+                                const s16* coeffs);
+
+  // Convert between big endian samples in emulated memory and host samples.
+  static void ByteSwapSamples(s16* dst, const s16* src, size_t count);
+  static void ExpandPCM8Samples(s16* dst, const s8* src, size_t count);
+
 private:
   struct VPB;
 
   // See Zelda.cpp for the list of possible flags.
   u32 m_flags;
 
-  // Utility functions for audio operations.
-
-  // Apply volume to a buffer. The volume is a fixed point integer, usually
-  // 1.15 or 4.12 in the DAC UCode.
-  template <size_t N, size_t B>
-  void ApplyVolumeInPlace(std::array<s16, N>* buf, u16 vol)
-  {
-    for (size_t i = 0; i < N; ++i)
-    {
-      s32 tmp = (u32)(*buf)[i] * (u32)vol;
-      tmp >>= 16 - B;
-
-      (*buf)[i] = (s16)std::clamp(tmp, -0x8000, 0x7FFF);
-    }
-  }
+  // Utility functions for audio operations, applied to whole buffers at once.
   template <size_t N>
   void ApplyVolumeInPlace_1_15(std::array<s16, N>* buf, u16 vol)
   {
-    ApplyVolumeInPlace<N, 1>(buf, vol);
+    ApplyVolumeInPlace(buf->data(), N, vol, 15);
   }
   template <size_t N>
   void ApplyVolumeInPlace_4_12(std::array<s16, N>* buf, u16 vol)
   {
-    ApplyVolumeInPlace<N, 4>(buf, vol);
+    ApplyVolumeInPlace(buf->data(), N, vol, 12);
   }
-
-  // Mixes two buffers together while applying a volume to one of them. The
-  // volume ramps up/down in N steps using the provided step delta value.
-  //
-  // Note: On a real GC, the stepping happens in 32 steps instead. But hey,
-  // we can do better here with very low risk. Why not? :)
   template <size_t N>
   s32 AddBuffersWithVolumeRamp(std::array<s16, N>* dst, const std::array<s16, N>& src, s32 vol,
                                s32 step)
   {
-    if (!vol && !step)
-      return vol;
-
-    for (size_t i = 0; i < N; ++i)
-    {
-      (*dst)[i] += ((vol >> 16) * src[i]) >> 16;
-      vol += step;
-    }
-
-    return vol;
-  }
-
-  // Does not use std::array because it needs to be able to process partial
-  // buffers. Volume is in 1.15 format.
-  void AddBuffersWithVolume(s16* dst, const s16* src, size_t count, u16 vol)
-  {
-    while (count--)
-    {
-      s32 vol_src = ((s32)*src++ * (s32)vol) >> 15;
-      *dst++ += std::clamp(vol_src, -0x8000, 0x7FFF);
-    }
+    return AddBuffersWithVolumeRamp(dst->data(), src.data(), N, vol, step);
   }
 
   // Whether the frame needs to be prepared or not.
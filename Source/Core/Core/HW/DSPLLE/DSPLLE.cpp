@@ -60,21 +60,27 @@ void DSPLLE::DSPThread(DSPLLE* dsp_lle)
 
   while (dsp_lle->m_is_running.IsSet())
   {
-    const int cycles = static_cast<int>(dsp_lle->m_cycle_count.load());
-    if (cycles > 0)
+    if (dsp_lle->m_cycle_count.load(std::memory_order_acquire) > 0)
     {
+      // Only contended while the CPU thread pauses the DSP (e.g. for savestates) or stops using
+      // this thread. The latter runs the pending cycles itself, so they are read under the lock.
       std::unique_lock dsp_thread_lock(dsp_lle->m_dsp_thread_mutex, std::try_to_lock);
-      if (dsp_thread_lock)
+      const u32 cycles =
+          dsp_thread_lock ? dsp_lle->m_cycle_count.load(std::memory_order_acquire) : 0;
+      if (cycles != 0)
       {
         if (dsp_lle->m_dsp_core.IsJITCreated())
         {
-          dsp_lle->m_dsp_core.RunCycles(cycles);
+          dsp_lle->m_dsp_core.RunCycles(static_cast<int>(cycles));
         }
         else
         {
-          dsp_lle->m_dsp_core.GetInterpreter().RunCyclesThread(cycles);
+          dsp_lle->m_dsp_core.GetInterpreter().RunCyclesThread(static_cast<int>(cycles));
         }
-        dsp_lle->m_cycle_count.store(0);
+        // The CPU thread may have handed out more cycles in the meantime, so only take away the
+        // ones that were just run (or skipped by an idle skip).
+        dsp_lle->m_cycle_count.fetch_sub(cycles, std::memory_order_acq_rel);
+        dsp_lle->m_ppc_event.Set();
         continue;
       }
     }
@@ -265,6 +271,13 @@ void DSPLLE::DSP_Update(int cycles)
       m_is_dsp_on_thread = false;
       m_request_disable_thread = false;
       Config::SetBaseOrCurrent(Config::MAIN_DSP_THREAD, false);
+
+      // Catch up on the slices the thread hadn't gotten to, so that from here on the DSP runs in
+      // lockstep with the CPU. The lock keeps the thread from running the same cycles.
+      std::lock_guard lk(m_dsp_thread_mutex);
+      const u32 pending = m_cycle_count.exchange(0, std::memory_order_acq_rel);
+      if (pending != 0)
+        m_dsp_core.RunCycles(static_cast<int>(pending));
     }
   }
 
@@ -276,10 +289,18 @@ void DSPLLE::DSP_Update(int cycles)
   }
   else
   {
-    // Wait for DSP thread to complete its cycle. Note: this logic should be thought through.
-    m_ppc_event.Wait();
-    m_cycle_count.fetch_add(dsp_cycles);
+    // Hand the cycles to the DSP thread without waiting for it. The CPU thread only blocks if
+    // the DSP falls behind by more than a couple of slices, which bounds the mailbox latency the
+    // emulated CPU can observe.
+    const u32 pending = m_cycle_count.fetch_add(dsp_cycles, std::memory_order_acq_rel);
     m_dsp_event.Set();
+
+    const u32 max_pending = MAX_PENDING_SLICES * static_cast<u32>(dsp_cycles);
+    if (pending >= max_pending)
+    {
+      while (m_is_running.IsSet() && m_cycle_count.load(std::memory_order_acquire) > max_pending)
+        m_ppc_event.Wait();
+    }
   }
 }
 
@@ -301,7 +322,6 @@ void DSPLLE::PauseAndLock(bool do_lock, bool unpause_on_unlock)
     if (m_is_dsp_on_thread)
     {
       // Signal the DSP thread so it can perform any outstanding work now (if any)
-      m_ppc_event.Wait();
       m_dsp_event.Set();
     }
   }
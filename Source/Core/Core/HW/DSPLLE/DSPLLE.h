@@ -41,6 +41,12 @@ public:
 private:
   static void DSPThread(DSPLLE* dsp_lle);
 
+  // How many DSP_Update slices the DSP thread may lag behind before the CPU thread waits for it.
+  // Within that window, the cycle at which the CPU sees mailbox values and DSP interrupts depends
+  // on host scheduling, as does the timing of DSP DMA against main memory. The thread is
+  // therefore never used when determinism is required (NetPlay, movies).
+  static constexpr u32 MAX_PENDING_SLICES = 2;
+
   DSPCore m_dsp_core;
   std::thread m_dsp_thread;
   std::mutex m_dsp_thread_mutex;
@@ -4,6 +4,7 @@
 #include "Core/HW/DVD/DVDInterface.h"
 
 #include <algorithm>
+#include <cstring>
 #include <memory>
 #include <optional>
 #include <string>
@@ -144,8 +145,6 @@ static UDICR s_DICR;
 static u32 s_DIIMMBUF;
 static UDICFG s_DICFG;
 
-static StreamADPCM::ADPCMDecoder s_adpcm_decoder;
-
 // DTK
 static bool s_stream = false;
 static bool s_stop_at_track_end = false;
@@ -233,26 +232,6 @@ void DoState(PointerWrap& p)
 
   DVDThread::DoState(p);
 
-  s_adpcm_decoder.DoState(p);
-}
-
-static size_t ProcessDTKSamples(std::vector<s16>* temp_pcm, const std::vector<u8>& audio_data)
-{
-  size_t samples_processed = 0;
-  size_t bytes_processed = 0;
-  while (samples_processed < temp_pcm->size() / 2 && bytes_processed < audio_data.size())
-  {
-    s_adpcm_decoder.DecodeBlock(&(*temp_pcm)[samples_processed * 2], &audio_data[bytes_processed]);
-    for (size_t i = 0; i < StreamADPCM::SAMPLES_PER_BLOCK * 2; ++i)
-    {
-      // TODO: Fix the mixer so it can accept non-byte-swapped samples.
-      s16* sample = &(*temp_pcm)[samples_processed * 2 + i];
-      *sample = Common::swap16(*sample);
-    }
-    samples_processed += StreamADPCM::SAMPLES_PER_BLOCK;
-    bytes_processed += StreamADPCM::ONE_BLOCK_SIZE;
-  }
-  return samples_processed;
 }
 
 static u32 AdvanceDTK(u32 maximum_samples, u32* samples_to_process)
@@ -280,7 +259,7 @@ static u32 AdvanceDTK(u32 maximum_samples, u32* samples_to_process)
         break;
       }
 
-      s_adpcm_decoder.ResetFilter();
+      DVDThread::ResetDTKDecoder();
     }
 
     s_audio_position += StreamADPCM::ONE_BLOCK_SIZE;
@@ -305,10 +284,20 @@ static void DTKStreamingCallback(DIInterruptType interrupt_type, const std::vect
 
   if (interrupt_type == DIInterruptType::TCINT)
   {
-    // Send audio to the mixer.
-    std::vector<s16> temp_pcm(s_pending_samples * 2, 0);
-    ProcessDTKSamples(&temp_pcm, audio_data);
-    g_sound_stream->GetMixer()->PushStreamingSamples(temp_pcm.data(), s_pending_samples);
+    // Send audio to the mixer. DVDThread has already decoded it, so unless there was nothing to
+    // read, it can be passed on as is.
+    Mixer* mixer = g_sound_stream->GetMixer();
+    if (audio_data.size() >= s_pending_samples * 2 * sizeof(s16))
+    {
+      mixer->PushStreamingSamples(reinterpret_cast<const s16*>(audio_data.data()),
+                                  s_pending_samples);
+    }
+    else
+    {
+      std::vector<s16> temp_pcm(s_pending_samples * 2, 0);
+      std::memcpy(temp_pcm.data(), audio_data.data(), audio_data.size());
+      mixer->PushStreamingSamples(temp_pcm.data(), s_pending_samples);
+    }
 
     if (s_stream && AudioInterface::IsPlaying())
     {
@@ -332,8 +321,7 @@ static void DTKStreamingCallback(DIInterruptType interrupt_type, const std::vect
   ticks_to_dtk -= cycles_late;
   if (read_length > 0)
   {
-    DVDThread::StartRead(read_offset, read_length, DiscIO::PARTITION_NONE, ReplyType::DTK,
-                         ticks_to_dtk);
+    DVDThread::StartDTKRead(read_offset, read_length, ticks_to_dtk);
   }
   else
   {
@@ -1060,7 +1048,7 @@ void ExecuteCommand(ReplyType reply_type)
           s_current_start = s_next_start;
           s_current_length = s_next_length;
           s_audio_position = s_current_start;
-          s_adpcm_decoder.ResetFilter();
+          DVDThread::ResetDTKDecoder();
           s_stream = true;
         }
       }
@@ -3,6 +3,7 @@
 
 #include "Core/HW/DVD/DVDThread.h"
 
+#include <cstring>
 #include <map>
 #include <memory>
 #include <mutex>
@@ -18,6 +19,7 @@
 #include "Common/Logging/Log.h"
 #include "Common/MsgHandler.h"
 #include "Common/SPSCQueue.h"
+#include "Common/Swap.h"
 #include "Common/Thread.h"
 #include "Common/Timer.h"
 
@@ -27,6 +29,7 @@
 #include "Core/HW/DVD/DVDInterface.h"
 #include "Core/HW/DVD/FileMonitor.h"
 #include "Core/HW/Memmap.h"
+#include "Core/HW/StreamADPCM.h"
 #include "Core/HW/SystemTimers.h"
 #include "Core/IOS/ES/Formats.h"
 
@@ -48,6 +51,9 @@ struct ReadRequest
   // because function pointers can't be stored in savestates.
   DVDInterface::ReplyType reply_type = DVDInterface::ReplyType::NoReply;
 
+  // Only used for ReplyType::DTK
+  bool reset_dtk_decoder = false;
+
   // IDs are used to uniquely identify a request. They must not be
   // identical to IDs of any other requests that currently exist, but
   // it's fine to re-use IDs of requests that have existed in the past.
@@ -69,9 +75,11 @@ static void WaitUntilIdle();
 
 static void StartReadInternal(bool copy_to_ram, u32 output_address, u64 dvd_offset, u32 length,
                               const DiscIO::Partition& partition,
-                              DVDInterface::ReplyType reply_type, s64 ticks_until_completion);
+                              DVDInterface::ReplyType reply_type, s64 ticks_until_completion,
+                              bool reset_dtk_decoder = false);
 
 static void FinishRead(u64 id, s64 cycles_late);
+static std::vector<u8> DecodeDTK(const std::vector<u8>& adpcm);
 static CoreTiming::EventType* s_finish_read;
 
 static u64 s_next_id = 0;
@@ -87,6 +95,15 @@ static std::map<u64, ReadResult> s_result_map;
 
 static std::unique_ptr<DiscIO::Volume> s_disc;
 
+// Only used by the DVD thread while a DTK read is queued. The CPU thread can use them otherwise,
+// since DTK reads are requested one at a time.
+static StreamADPCM::ADPCMDecoder s_dtk_decoder;
+static std::vector<u8> s_dtk_adpcm;
+
+// Only used by the CPU thread. Set by ResetDTKDecoder and consumed by the next DTK read that is
+// started or finished.
+static bool s_reset_dtk_decoder = false;
+
 void Start()
 {
   s_finish_read = CoreTiming::RegisterEvent("FinishReadDVDThread", FinishRead);
@@ -95,6 +112,9 @@ void Start()
   s_result_queue_expanded.Reset();
   s_request_queue.Clear();
   s_result_queue.Clear();
+  s_dtk_decoder.ResetFilter();
+  s_dtk_adpcm.clear();
+  s_reset_dtk_decoder = false;
 
   // This is reset on every launch for determinism, but it doesn't matter
   // much, because this will never get exposed to the emulated game.
@@ -146,6 +166,9 @@ void DoState(PointerWrap& p)
   // Both queues are now empty, so we don't need to savestate them.
   p.Do(s_result_map);
   p.Do(s_next_id);
+  s_dtk_decoder.DoState(p);
+  p.Do(s_dtk_adpcm);
+  p.Do(s_reset_dtk_decoder);
 
   // s_disc isn't savestated (because it points to files on the
   // local system). Instead, we check that the status of the disc
@@ -267,9 +290,24 @@ void StartReadToEmulatedRAM(u32 output_address, u64 dvd_offset, u32 length,
                     ticks_until_completion);
 }
 
+void StartDTKRead(u64 dvd_offset, u32 length, s64 ticks_until_completion)
+{
+  StartReadInternal(false, 0, dvd_offset, length, DiscIO::PARTITION_NONE,
+                    DVDInterface::ReplyType::DTK, ticks_until_completion, s_reset_dtk_decoder);
+  s_reset_dtk_decoder = false;
+}
+
+void ResetDTKDecoder()
+{
+  ASSERT(Core::IsCPUThread());
+
+  s_reset_dtk_decoder = true;
+}
+
 static void StartReadInternal(bool copy_to_ram, u32 output_address, u64 dvd_offset, u32 length,
                               const DiscIO::Partition& partition,
-                              DVDInterface::ReplyType reply_type, s64 ticks_until_completion)
+                              DVDInterface::ReplyType reply_type, s64 ticks_until_completion,
+                              bool reset_dtk_decoder)
 {
   ASSERT(Core::IsCPUThread());
 
@@ -281,6 +319,7 @@ static void StartReadInternal(bool copy_to_ram, u32 output_address, u64 dvd_offs
   request.length = length;
   request.partition = partition;
   request.reply_type = reply_type;
+  request.reset_dtk_decoder = reset_dtk_decoder;
 
   u64 id = s_next_id++;
   request.id = id;
@@ -294,6 +333,15 @@ static void StartReadInternal(bool copy_to_ram, u32 output_address, u64 dvd_offs
   CoreTiming::ScheduleEvent(ticks_until_completion, s_finish_read, id);
 }
 
+static size_t GetResultSize(const ReadRequest& request)
+{
+  if (request.reply_type != DVDInterface::ReplyType::DTK)
+    return request.length;
+
+  return request.length / StreamADPCM::ONE_BLOCK_SIZE * StreamADPCM::SAMPLES_PER_BLOCK * 2 *
+         sizeof(s16);
+}
+
 static void FinishRead(u64 id, s64 cycles_late)
 {
   // We can't simply pop s_result_queue and always get the ReadResult
@@ -329,7 +377,17 @@ static void FinishRead(u64 id, s64 cycles_late)
   // We have now obtained the right ReadResult.
 
   const ReadRequest& request = result.first;
-  const std::vector<u8>& buffer = result.second;
+  std::vector<u8>& buffer = result.second;
+
+  // The DVD thread has already decoded this read, so a reset that was requested while it was in
+  // flight means decoding it again. Nothing else touches the decoder until the next DTK read.
+  if (request.reply_type == DVDInterface::ReplyType::DTK && s_reset_dtk_decoder)
+  {
+    s_reset_dtk_decoder = false;
+    s_dtk_decoder.ResetFilter();
+    if (!buffer.empty())
+      buffer = DecodeDTK(s_dtk_adpcm);
+  }
 
   DEBUG_LOG_FMT(DVDINTERFACE,
                 "Disc has been read. Real time: {} us. "
@@ -341,7 +399,7 @@ static void FinishRead(u64 id, s64 cycles_late)
                     (SystemTimers::GetTicksPerSecond() / 1000000));
 
   DVDInterface::DIInterruptType interrupt;
-  if (buffer.size() != request.length)
+  if (buffer.size() != GetResultSize(request))
   {
     PanicAlertFmtT("The disc could not be read (at {0:#x} - {1:#x}).", request.dvd_offset,
                    request.dvd_offset + request.length);
@@ -361,6 +419,24 @@ static void FinishRead(u64 id, s64 cycles_late)
   DVDInterface::FinishExecutingCommand(request.reply_type, interrupt, cycles_late, buffer);
 }
 
+// Decoding the streamed audio on the DVD thread keeps it off the CPU thread. DTK reads are
+// requested one at a time and processed in order, so the decoder history carries over exactly like
+// it would if the CPU thread decoded each read when it completes.
+static std::vector<u8> DecodeDTK(const std::vector<u8>& adpcm)
+{
+  const size_t num_blocks = adpcm.size() / StreamADPCM::ONE_BLOCK_SIZE;
+  std::vector<s16> pcm(num_blocks * StreamADPCM::SAMPLES_PER_BLOCK * 2);
+  s_dtk_decoder.DecodeBlocks(pcm.data(), adpcm.data(), num_blocks);
+
+  // TODO: Fix the mixer so it can accept non-byte-swapped samples.
+  for (s16& sample : pcm)
+    sample = Common::swap16(sample);
+
+  std::vector<u8> result(pcm.size() * sizeof(s16));
+  std::memcpy(result.data(), pcm.data(), result.size());
+  return result;
+}
+
 static void DVDThread()
 {
   Common::SetCurrentThreadName("DVD thread");
@@ -381,6 +457,16 @@ static void DVDThread()
       if (!s_disc->Read(request.dvd_offset, request.length, buffer.data(), request.partition))
         buffer.resize(0);
 
+      if (request.reply_type == DVDInterface::ReplyType::DTK)
+      {
+        // Reset even if the read failed, since the reset must not get lost. The ADPCM data is kept
+        // in case the CPU thread has to decode it again.
+        if (request.reset_dtk_decoder)
+          s_dtk_decoder.ResetFilter();
+        s_dtk_adpcm = std::move(buffer);
+        buffer = DecodeDTK(s_dtk_adpcm);
+      }
+
       request.realtime_done_us = Common::Timer::GetTimeUs();
 
       s_result_queue.Push(ReadResult(std::move(request), std::move(buffer)));
@@ -59,4 +59,11 @@ void StartRead(u64 dvd_offset, u32 length, const DiscIO::Partition& partition,
 void StartReadToEmulatedRAM(u32 output_address, u64 dvd_offset, u32 length,
                             const DiscIO::Partition& partition, DVDInterface::ReplyType reply_type,
                             s64 ticks_until_completion);
+// Reads streamed audio and decodes it on the DVD thread. The result that is passed to
+// DVDInterface contains big endian stereo samples instead of the ADPCM data. The decoder's
+// history carries over from one DTK read to the next unless ResetDTKDecoder is called.
+void StartDTKRead(u64 dvd_offset, u32 length, s64 ticks_until_completion);
+// Resets the decoder before the DTK read that is in flight is decoded, or before the next one if
+// there is none. A failed read doesn't consume the reset.
+void ResetDTKDecoder();
 }  // namespace DVDThread
@@ -289,45 +289,39 @@ void ReadHandler<T>::Visit(ReadHandlingMethodVisitor<T>& visitor)
   m_Method->AcceptReadVisitor(visitor);
 }
 
-template <typename T>
-T ReadHandler<T>::Read(u32 addr)
-{
-  // Check if the handler has already been initialized. For real
-  // handlers, this will always be the case, so this branch should be
-  // easily predictable.
-  if (!m_Method)
-    InitializeInvalid();
-
-  return m_ReadFunc(addr);
-}
-
 template <typename T>
 void ReadHandler<T>::ResetMethod(ReadHandlingMethod<T>* method)
 {
   m_Method.reset(method);
 
-  struct FuncCreatorVisitor : public ReadHandlingMethodVisitor<T>
+  struct KindDecoderVisitor : public ReadHandlingMethodVisitor<T>
   {
-    virtual ~FuncCreatorVisitor() = default;
+    explicit KindDecoderVisitor(ReadHandler* handler_) : handler(handler_) {}
+    virtual ~KindDecoderVisitor() = default;
 
-    std::function<T(u32)> ret;
+    ReadHandler* handler;
 
     void VisitConstant(T value) override
     {
-      ret = [value](u32) { return value; };
+      handler->m_Kind = Kind::Constant;
+      handler->m_Constant = value;
     }
 
     void VisitDirect(const T* addr, u32 mask) override
     {
-      ret = [addr, mask](u32) { return *addr & mask; };
+      handler->m_Kind = Kind::Direct;
+      handler->m_Direct = {addr, mask};
     }
 
-    void VisitComplex(const std::function<T(u32)>* lambda) override { ret = *lambda; }
+    void VisitComplex(const std::function<T(u32)>* lambda) override
+    {
+      handler->m_Kind = Kind::Complex;
+      handler->m_Complex = lambda;
+    }
   };
 
-  FuncCreatorVisitor v;
+  KindDecoderVisitor v(this);
   Visit(v);
-  m_ReadFunc = v.ret;
 }
 
 template <typename T>
@@ -361,45 +355,35 @@ void WriteHandler<T>::Visit(WriteHandlingMethodVisitor<T>& visitor)
   m_Method->AcceptWriteVisitor(visitor);
 }
 
-template <typename T>
-void WriteHandler<T>::Write(u32 addr, T val)
-{
-  // Check if the handler has already been initialized. For real
-  // handlers, this will always be the case, so this branch should be
-  // easily predictable.
-  if (!m_Method)
-    InitializeInvalid();
-
-  m_WriteFunc(addr, val);
-}
-
 template <typename T>
 void WriteHandler<T>::ResetMethod(WriteHandlingMethod<T>* method)
 {
   m_Method.reset(method);
 
-  struct FuncCreatorVisitor : public WriteHandlingMethodVisitor<T>
+  struct KindDecoderVisitor : public WriteHandlingMethodVisitor<T>
   {
-    virtual ~FuncCreatorVisitor() = default;
+    explicit KindDecoderVisitor(WriteHandler* handler_) : handler(handler_) {}
+    virtual ~KindDecoderVisitor() = default;
 
-    std::function<void(u32, T)> ret;
+    WriteHandler* handler;
 
-    void VisitNop() override
-    {
-      ret = [](u32, T) {};
-    }
+    void VisitNop() override { handler->m_Kind = Kind::Nop; }
 
     void VisitDirect(T* ptr, u32 mask) override
     {
-      ret = [ptr, mask](u32, T val) { *ptr = val & mask; };
+      handler->m_Kind = Kind::Direct;
+      handler->m_Direct = {ptr, mask};
     }
 
-    void VisitComplex(const std::function<void(u32, T)>* lambda) override { ret = *lambda; }
+    void VisitComplex(const std::function<void(u32, T)>* lambda) override
+    {
+      handler->m_Kind = Kind::Complex;
+      handler->m_Complex = lambda;
+    }
   };
 
-  FuncCreatorVisitor v;
+  KindDecoderVisitor v(this);
   Visit(v);
-  m_WriteFunc = v.ret;
 }
 
 template <typename T>
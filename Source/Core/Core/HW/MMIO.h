@@ -41,10 +41,12 @@ const u32 NUM_MMIOS = NUM_BLOCKS * BLOCK_SIZE;
 // We have a special exception here for FIFO writes: these are handled via a
 // different mechanism and should not go through the normal MMIO access
 // interface.
-inline bool IsMMIOAddress(u32 address)
+inline bool IsMMIOAddress(u32 address, bool is_write = false)
 {
   if (address == 0x0C008000)
     return false;  // WG Pipe
+  if (is_write && (address & 0xFFFFF000) == 0x0C008000)
+    return false;  // Writes anywhere in the WG Pipe page go to the GPFifo
   if ((address & 0xFFFF0000) == 0x0C000000)
     return true;  // GameCube MMIOs
 
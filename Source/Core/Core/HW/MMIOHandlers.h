@@ -126,18 +126,56 @@ public:
   // Entry point for read handling method visitors.
   void Visit(ReadHandlingMethodVisitor<T>& visitor);
 
-  T Read(u32 addr);
+  T Read(u32 addr)
+  {
+    // Constant and Direct handlers are by far the most common ones, and
+    // handling them here avoids an indirect call through a std::function.
+    switch (m_Kind)
+    {
+    case Kind::Constant:
+      return m_Constant;
+    case Kind::Direct:
+      return static_cast<T>(*m_Direct.addr & m_Direct.mask);
+    case Kind::Complex:
+      return (*m_Complex)(addr);
+    default:
+      // Only reached once per unused handler, see InitializeInvalid.
+      InitializeInvalid();
+      return (*m_Complex)(addr);
+    }
+  }
 
   // Internal method called when changing the internal method object. Its
   // main role is to make sure the read function is updated at the same time.
   void ResetMethod(ReadHandlingMethod<T>* method);
 
 private:
+  enum class Kind : u8
+  {
+    Uninitialized,
+    Constant,
+    Direct,
+    Complex,
+  };
+
   // Initialize this handler to an invalid handler. Done lazily to avoid
   // useless initialization of thousands of unused handler objects.
   void InitializeInvalid();
   std::unique_ptr<ReadHandlingMethod<T>> m_Method;
-  std::function<T(u32)> m_ReadFunc;
+
+  // Decoded copy of m_Method, filled by ResetMethod. Complex points into
+  // m_Method, which owns the lambda.
+  Kind m_Kind = Kind::Uninitialized;
+  union
+  {
+    T m_Constant;
+    struct
+    {
+      const T* addr;
+      u32 mask;
+    } m_Direct;
+    const std::function<T(u32)>* m_Complex;
+  };
 };
 template <typename T>
 class WriteHandler
@@ -153,7 +191,25 @@ public:
   // Entry point for write handling method visitors.
   void Visit(WriteHandlingMethodVisitor<T>& visitor);
 
-  void Write(u32 addr, T val);
+  void Write(u32 addr, T val)
+  {
+    switch (m_Kind)
+    {
+    case Kind::Nop:
+      break;
+    case Kind::Direct:
+      *m_Direct.addr = static_cast<T>(val & m_Direct.mask);
+      break;
+    case Kind::Complex:
+      (*m_Complex)(addr, val);
+      break;
+    default:
+      // Only reached once per unused handler, see InitializeInvalid.
+      InitializeInvalid();
+      (*m_Complex)(addr, val);
+      break;
+    }
+  }
 
   // Internal method called when changing the internal method object. Its
   // main role is to make sure the write function is updated at the same
@@ -161,11 +217,31 @@ public:
   void ResetMethod(WriteHandlingMethod<T>* method);
 
 private:
+  enum class Kind : u8
+  {
+    Uninitialized,
+    Nop,
+    Direct,
+    Complex,
+  };
+
   // Initialize this handler to an invalid handler. Done lazily to avoid
   // useless initialization of thousands of unused handler objects.
   void InitializeInvalid();
   std::unique_ptr<WriteHandlingMethod<T>> m_Method;
-  std::function<void(u32, T)> m_WriteFunc;
+
+  // Decoded copy of m_Method, filled by ResetMethod. Complex points into
+  // m_Method, which owns the lambda.
+  Kind m_Kind = Kind::Uninitialized;
+  union
+  {
+    struct
+    {
+      T* addr;
+      u32 mask;
+    } m_Direct;
+    const std::function<void(u32, T)>* m_Complex;
+  };
 };
 
 // Boilerplate boilerplate boilerplate.
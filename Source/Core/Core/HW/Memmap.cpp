@@ -13,7 +13,13 @@
 #include <cstring>
 #include <memory>
 #include <tuple>
+#include <vector>
 
+#ifndef _WIN32
+#include <unistd.h>
+#endif
+
+#include "Common/Align.h"
 #include "Common/ChunkFile.h"
 #include "Common/CommonTypes.h"
 #include "Common/Logging/Log.h"
@@ -223,6 +229,23 @@ static std::array<PhysicalMemoryRegion, 4> s_physical_regions;
 
 static std::vector<LogicalMemoryView> logical_mapped_entries;
 
+// Logical addresses of the pages mapped from the page table, bucketed by the TLB index (the
+// congruence class tlbie operates on).
+static std::array<std::vector<u32>, PowerPC::HW_PAGE_INDEX_MASK + 1> s_page_table_mappings;
+static u32 s_page_table_mapping_count = 0;
+static bool s_page_table_mappings_supported = false;
+
+// Every mapped page may become a separate host mapping, and the number of those per process is
+// limited (vm.max_map_count on Linux). Further pages simply keep using the slow path.
+constexpr u32 MAX_PAGE_TABLE_MAPPINGS = 0x8000;
+
+// Views of a hugetlb segment have to cover whole huge pages. The padding between regions in the
+// segment leaves room for that.
+static u32 GetViewSize(const PhysicalMemoryRegion& region)
+{
+  return static_cast<u32>(Common::AlignUp<size_t>(region.size, g_arena.GetViewAlignment()));
+}
+
 void Init()
 {
   const auto get_mem1_size = [] {
@@ -266,6 +289,11 @@ void Init()
   fake_vmem = !wii && !mmu;
 #endif
 
+  // With huge pages, every region has to start on a huge page boundary within the segment, as
+  // their physical addresses do. The padding in between is never touched, so it costs nothing.
+  const bool huge_pages = Config::Get(Config::MAIN_HUGE_PAGES);
+  const u32 region_alignment = huge_pages ? Common::MemArena::HUGE_PAGE_SIZE : 1;
+
   u32 mem_size = 0;
   for (PhysicalMemoryRegion& region : s_physical_regions)
   {
@@ -274,11 +302,11 @@ void Init()
     if (!fake_vmem && (region.flags & PhysicalMemoryRegion::FAKE_VMEM))
       continue;
 
-    region.shm_position = mem_size;
+    region.shm_position = Common::AlignUp(mem_size, region_alignment);
     region.active = true;
-    mem_size += region.size;
+    mem_size = region.shm_position + region.size;
   }
-  g_arena.GrabSHMSegment(mem_size);
+  g_arena.GrabSHMSegment(mem_size, huge_pages);
 
   // Create an anonymous view of the physical memory
   for (const PhysicalMemoryRegion& region : s_physical_regions)
@@ -286,7 +314,7 @@ void Init()
     if (!region.active)
       continue;
 
-    *region.out_pointer = (u8*)g_arena.CreateView(region.shm_position, region.size);
+    *region.out_pointer = (u8*)g_arena.CreateView(region.shm_position, GetViewSize(region));
 
     if (!*region.out_pointer)
     {
@@ -326,7 +354,7 @@ bool InitFastmemArena()
       continue;
 
     u8* base = physical_base + region.physical_address;
-    u8* view = (u8*)g_arena.MapInMemoryRegion(region.shm_position, region.size, base);
+    u8* view = (u8*)g_arena.MapInMemoryRegion(region.shm_position, GetViewSize(region), base);
 
     if (base != view)
     {
@@ -341,6 +369,15 @@ bool InitFastmemArena()
   logical_base = physical_base + 0x200000000;
 #endif
 
+  // Guest pages can only be mapped individually if host pages are no larger. Views on Windows
+  // additionally have to be aligned to the 64 KiB allocation granularity.
+#if defined(_WIN32) || defined(_ARCH_32)
+  s_page_table_mappings_supported = false;
+#else
+  s_page_table_mappings_supported = sysconf(_SC_PAGESIZE) == PowerPC::HW_PAGE_SIZE &&
+                                    g_arena.GetViewAlignment() <= PowerPC::HW_PAGE_SIZE;
+#endif
+
   is_fastmem_arena_initialized = true;
   return true;
 }
@@ -350,41 +387,63 @@ void UpdateLogicalMemory(const PowerPC::BatTable& dbat_table)
   if (!is_fastmem_arena_initialized)
     return;
 
+  // The new BATs may cover pages that were mapped through the page table.
+  ClearPageTableMappings();
+
   for (auto& entry : logical_mapped_entries)
   {
     g_arena.UnmapFromMemoryRegion(entry.mapped_pointer, entry.mapped_size);
   }
   logical_mapped_entries.clear();
+  const size_t view_alignment = g_arena.GetViewAlignment();
   for (u32 i = 0; i < dbat_table.size(); ++i)
   {
     if (dbat_table[i] & PowerPC::BAT_PHYSICAL_BIT)
     {
       u32 logical_address = i << PowerPC::BAT_INDEX_SHIFT;
-      // TODO: Merge adjacent mappings to make this faster.
-      u32 logical_size = PowerPC::BAT_PAGE_SIZE;
       u32 translated_address = dbat_table[i] & PowerPC::BAT_RESULT_MASK;
+
+      // Merge BAT pages that are also contiguous in physical memory into one mapping. Besides
+      // needing fewer mmap calls, this is what lets huge page aligned views span them.
+      u64 logical_size = PowerPC::BAT_PAGE_SIZE;
+      while (i + 1 < dbat_table.size() && (dbat_table[i + 1] & PowerPC::BAT_PHYSICAL_BIT) &&
+             (dbat_table[i + 1] & PowerPC::BAT_RESULT_MASK) == translated_address + logical_size)
+      {
+        logical_size += PowerPC::BAT_PAGE_SIZE;
+        ++i;
+      }
+
       for (const auto& physical_region : s_physical_regions)
       {
         if (!physical_region.active)
           continue;
 
-        u32 mapping_address = physical_region.physical_address;
-        u32 mapping_end = mapping_address + physical_region.size;
-        u32 intersection_start = std::max(mapping_address, translated_address);
-        u32 intersection_end = std::min(mapping_end, translated_address + logical_size);
+        u64 mapping_address = physical_region.physical_address;
+        u64 mapping_end = mapping_address + physical_region.size;
+        u64 intersection_start = std::max<u64>(mapping_address, translated_address);
+        u64 intersection_end = std::min<u64>(mapping_end, translated_address + logical_size);
         if (intersection_start < intersection_end)
         {
           // Found an overlapping region; map it.
-          u32 position = physical_region.shm_position + intersection_start - mapping_address;
+          u32 position =
+              static_cast<u32>(physical_region.shm_position + intersection_start - mapping_address);
           u8* base = logical_base + logical_address + intersection_start - translated_address;
-          u32 mapped_size = intersection_end - intersection_start;
+          u32 mapped_size = static_cast<u32>(intersection_end - intersection_start);
+
+          // Views that can't be aligned to huge pages are left unmapped. Accesses to them fault
+          // and get backpatched to the slow path.
+          if (position % view_alignment != 0 || mapped_size % view_alignment != 0 ||
+              reinterpret_cast<uintptr_t>(base) % view_alignment != 0)
+          {
+            continue;
+          }
 
           void* mapped_pointer = g_arena.MapInMemoryRegion(position, mapped_size, base);
           if (!mapped_pointer)
           {
             PanicAlertFmt("Memory::UpdateLogicalMemory(): Failed to map memory region at 0x{:08X} "
                           "(size 0x{:08X}) into logical fastmem region at 0x{:08X}.",
-                          intersection_start, mapped_size, logical_address);
+                          static_cast<u32>(intersection_start), mapped_size, logical_address);
             exit(0);
           }
           logical_mapped_entries.push_back({mapped_pointer, mapped_size});
@@ -394,6 +453,78 @@ void UpdateLogicalMemory(const PowerPC::BatTable& dbat_table)
   }
 }
 
+bool AddPageTableMapping(u32 logical_address, u32 translated_address)
+{
+  if (!is_fastmem_arena_initialized || !s_page_table_mappings_supported)
+    return false;
+  if (s_page_table_mapping_count >= MAX_PAGE_TABLE_MAPPINGS)
+    return false;
+
+  for (const auto& physical_region : s_physical_regions)
+  {
+    if (!physical_region.active)
+      continue;
+
+    const u32 mapping_address = physical_region.physical_address;
+    if (translated_address < mapping_address ||
+        translated_address - mapping_address >= physical_region.size)
+    {
+      continue;
+    }
+
+    const u32 position = physical_region.shm_position + translated_address - mapping_address;
+    u8* base = logical_base + logical_address;
+    void* mapped_pointer = g_arena.MapInMemoryRegion(position, PowerPC::HW_PAGE_SIZE, base);
+    if (mapped_pointer != base)
+    {
+      if (mapped_pointer)
+        g_arena.UnmapFromMemoryRegion(mapped_pointer, PowerPC::HW_PAGE_SIZE);
+      return false;
+    }
+
+    const u32 tlb_index = (logical_address >> PowerPC::HW_PAGE_INDEX_SHIFT) &
+                          PowerPC::HW_PAGE_INDEX_MASK;
+    s_page_table_mappings[tlb_index].push_back(logical_address);
+    ++s_page_table_mapping_count;
+    return true;
+  }
+
+  return false;
+}
+
+void RemovePageTableMappings(u32 tlb_index)
+{
+  std::vector<u32>& mappings = s_page_table_mappings[tlb_index & PowerPC::HW_PAGE_INDEX_MASK];
+  for (u32 logical_address : mappings)
+    g_arena.UnmapFromMemoryRegion(logical_base + logical_address, PowerPC::HW_PAGE_SIZE);
+  s_page_table_mapping_count -= static_cast<u32>(mappings.size());
+  mappings.clear();
+}
+
+void RemovePageTableMappingsInSegment(u32 segment)
+{
+  for (std::vector<u32>& mappings : s_page_table_mappings)
+  {
+    const auto it = std::remove_if(mappings.begin(), mappings.end(), [segment](u32 address) {
+      if (address >> 28 != segment)
+        return false;
+      g_arena.UnmapFromMemoryRegion(logical_base + address, PowerPC::HW_PAGE_SIZE);
+      return true;
+    });
+    s_page_table_mapping_count -= static_cast<u32>(mappings.end() - it);
+    mappings.erase(it, mappings.end());
+  }
+}
+
+void ClearPageTableMappings()
+{
+  if (s_page_table_mapping_count == 0)
+    return;
+
+  for (u32 i = 0; i < s_page_table_mappings.size(); ++i)
+    RemovePageTableMappings(i);
+}
+
 void DoState(PointerWrap& p)
 {
   const u32 current_ram_size = GetRamSize();
@@ -453,7 +584,7 @@ void Shutdown()
     if (!region.active)
       continue;
 
-    g_arena.ReleaseView(*region.out_pointer, region.size);
+    g_arena.ReleaseView(*region.out_pointer, GetViewSize(region));
     *region.out_pointer = nullptr;
   }
   g_arena.ReleaseSHMSegment();
@@ -472,9 +603,11 @@ void ShutdownFastmemArena()
       continue;
 
     u8* base = physical_base + region.physical_address;
-    g_arena.UnmapFromMemoryRegion(base, region.size);
+    g_arena.UnmapFromMemoryRegion(base, GetViewSize(region));
   }
 
+  ClearPageTableMappings();
+
   for (auto& entry : logical_mapped_entries)
   {
     g_arena.UnmapFromMemoryRegion(entry.mapped_pointer, entry.mapped_size);
@@ -68,6 +68,13 @@ void DoState(PointerWrap& p);
 
 void UpdateLogicalMemory(const PowerPC::BatTable& dbat_table);
 
+// Pages translated through the page table are mapped into the logical fastmem region one at a
+// time, as the JIT touches them. They are dropped again whenever the translation may change.
+bool AddPageTableMapping(u32 logical_address, u32 translated_address);
+void RemovePageTableMappings(u32 tlb_index);
+void RemovePageTableMappingsInSegment(u32 segment);
+void ClearPageTableMappings();
+
 void Clear();
 
 // Routines to access physically addressed memory, designed for use by
@@ -6,42 +6,111 @@
 #include "Core/HW/StreamADPCM.h"
 
 #include <algorithm>
+#include <array>
 
 #include "Common/ChunkFile.h"
 #include "Common/CommonTypes.h"
+#include "Common/Intrinsics.h"
+
+#ifdef _M_ARM_64
+#include <arm_neon.h>
+#endif
 
 namespace StreamADPCM
 {
-static s16 ADPDecodeSample(s32 bits, s32 q, s32& hist1, s32& hist2)
+// Expands the 4-bit samples of a block for both channels and applies their scale, which leaves
+// only the prediction from the previous samples to be done one sample at a time.
+static void ExpandBlock(const u8* adpcm, s16* left, s16* right)
 {
-  s32 hist = 0;
-  switch (q >> 4)
+  const u8* data = adpcm + (ONE_BLOCK_SIZE - SAMPLES_PER_BLOCK);
+  const int left_shift = adpcm[0] & 0xf;
+  const int right_shift = adpcm[1] & 0xf;
+
+#if defined(_M_X86) || defined(_M_ARM_64)
+  // Two overlapping halves of 16 samples cover all 28 of them.
+  for (const size_t offset : {size_t{0}, size_t{SAMPLES_PER_BLOCK - 16}})
+  {
+#if defined(_M_X86)
+    const __m128i mask = _mm_set1_epi8(0xf);
+    const __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + offset));
+    const __m128i low = _mm_and_si128(bytes, mask);
+    const __m128i high = _mm_and_si128(_mm_srli_epi16(bytes, 4), mask);
+
+    // Move each nibble to the top of a 16-bit lane, then shift it back down arithmetically.
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i left_count = _mm_cvtsi32_si128(left_shift);
+    const __m128i right_count = _mm_cvtsi32_si128(right_shift);
+    __m128i* left_out = reinterpret_cast<__m128i*>(left + offset);
+    __m128i* right_out = reinterpret_cast<__m128i*>(right + offset);
+    _mm_storeu_si128(left_out,
+                     _mm_sra_epi16(_mm_slli_epi16(_mm_unpacklo_epi8(zero, low), 4), left_count));
+    _mm_storeu_si128(left_out + 1,
+                     _mm_sra_epi16(_mm_slli_epi16(_mm_unpackhi_epi8(zero, low), 4), left_count));
+    _mm_storeu_si128(right_out,
+                     _mm_sra_epi16(_mm_slli_epi16(_mm_unpacklo_epi8(zero, high), 4), right_count));
+    _mm_storeu_si128(right_out + 1,
+                     _mm_sra_epi16(_mm_slli_epi16(_mm_unpackhi_epi8(zero, high), 4), right_count));
+#else
+    const uint8x16_t bytes = vld1q_u8(data + offset);
+    const uint8x16_t low = vandq_u8(bytes, vdupq_n_u8(0xf));
+    const uint8x16_t high = vshrq_n_u8(bytes, 4);
+
+    // Move each nibble to the top of a 16-bit lane, then shift it back down arithmetically.
+    const int16x8_t left_count = vdupq_n_s16(static_cast<s16>(-left_shift));
+    const int16x8_t right_count = vdupq_n_s16(static_cast<s16>(-right_shift));
+    const auto expand = [](uint8x8_t nibbles, int16x8_t count) {
+      const int16x8_t widened = vreinterpretq_s16_u16(vshll_n_u8(nibbles, 8));
+      return vshlq_s16(vshlq_n_s16(widened, 4), count);
+    };
+    vst1q_s16(left + offset, expand(vget_low_u8(low), left_count));
+    vst1q_s16(left + offset + 8, expand(vget_high_u8(low), left_count));
+    vst1q_s16(right + offset, expand(vget_low_u8(high), right_count));
+    vst1q_s16(right + offset + 8, expand(vget_high_u8(high), right_count));
+#endif
+  }
+#else
+  for (size_t i = 0; i < SAMPLES_PER_BLOCK; ++i)
   {
-  case 0:
-    hist = 0;
-    break;
-  case 1:
-    hist = (hist1 * 0x3c);
-    break;
-  case 2:
-    hist = (hist1 * 0x73) - (hist2 * 0x34);
-    break;
-  case 3:
-    hist = (hist1 * 0x62) - (hist2 * 0x37);
-    break;
+    left[i] = static_cast<s16>(data[i] << 12) >> left_shift;
+    right[i] = static_cast<s16>((data[i] >> 4) << 12) >> right_shift;
   }
-  hist = std::clamp((hist + 0x20) >> 6, -0x200000, 0x1fffff);
+#endif
+}
 
-  s32 cur = (((s16)(bits << 12) >> (q & 0xf)) << 6) + hist;
+struct Predictor
+{
+  explicit Predictor(u8 header)
+  {
+    switch (header >> 4)
+    {
+    case 1:
+      coef1 = 0x3c;
+      break;
+    case 2:
+      coef1 = 0x73;
+      coef2 = -0x34;
+      break;
+    case 3:
+      coef1 = 0x62;
+      coef2 = -0x37;
+      break;
+    }
+  }
 
-  hist2 = hist1;
-  hist1 = cur;
+  s16 DecodeSample(s16 delta, s32& hist1, s32& hist2) const
+  {
+    const s32 hist = std::clamp((hist1 * coef1 + hist2 * coef2 + 0x20) >> 6, -0x200000, 0x1fffff);
+    const s32 cur = delta * 64 + hist;
 
-  cur >>= 6;
-  cur = std::clamp(cur, -0x8000, 0x7fff);
+    hist2 = hist1;
+    hist1 = cur;
 
-  return (s16)cur;
-}
+    return static_cast<s16>(std::clamp(cur >> 6, -0x8000, 0x7fff));
+  }
+
+  s32 coef1 = 0;
+  s32 coef2 = 0;
+};
 
 void ADPCMDecoder::ResetFilter()
 {
@@ -61,12 +130,29 @@ void ADPCMDecoder::DoState(PointerWrap& p)
 
 void ADPCMDecoder::DecodeBlock(s16* pcm, const u8* adpcm)
 {
-  for (int i = 0; i < SAMPLES_PER_BLOCK; i++)
+  DecodeBlocks(pcm, adpcm, 1);
+}
+
+void ADPCMDecoder::DecodeBlocks(s16* pcm, const u8* adpcm, size_t num_blocks)
+{
+  for (size_t block = 0; block < num_blocks; ++block)
   {
-    pcm[i * 2] = ADPDecodeSample(adpcm[i + (ONE_BLOCK_SIZE - SAMPLES_PER_BLOCK)] & 0xf, adpcm[0],
-                                 m_histl1, m_histl2);
-    pcm[i * 2 + 1] = ADPDecodeSample(adpcm[i + (ONE_BLOCK_SIZE - SAMPLES_PER_BLOCK)] >> 4, adpcm[1],
-                                     m_histr1, m_histr2);
+    std::array<s16, SAMPLES_PER_BLOCK> left;
+    std::array<s16, SAMPLES_PER_BLOCK> right;
+    ExpandBlock(adpcm, left.data(), right.data());
+
+    // The two channels don't depend on each other, so decoding them in the same loop lets the
+    // CPU overlap their work.
+    const Predictor left_predictor(adpcm[0]);
+    const Predictor right_predictor(adpcm[1]);
+    for (size_t i = 0; i < SAMPLES_PER_BLOCK; ++i)
+    {
+      pcm[i * 2] = left_predictor.DecodeSample(left[i], m_histl1, m_histl2);
+      pcm[i * 2 + 1] = right_predictor.DecodeSample(right[i], m_histr1, m_histr2);
+    }
+
+    pcm += SAMPLES_PER_BLOCK * 2;
+    adpcm += ONE_BLOCK_SIZE;
   }
 }
 }  // namespace StreamADPCM
@@ -3,6 +3,11 @@
 
 #include "Core/PowerPC/CachedInterpreter/CachedInterpreter.h"
 
+#include <algorithm>
+#include <array>
+#include <type_traits>
+
+#include "Common/BitUtils.h"
 #include "Common/CommonTypes.h"
 #include "Common/Logging/Log.h"
 #include "Core/ConfigManager.h"
@@ -11,6 +16,7 @@
 #include "Core/HW/CPU.h"
 #include "Core/PowerPC/Gekko.h"
 #include "Core/PowerPC/Jit64Common/Jit64Constants.h"
+#include "Core/PowerPC/MMU.h"
 #include "Core/PowerPC/PPCAnalyst.h"
 #include "Core/PowerPC/PowerPC.h"
 
@@ -18,6 +24,9 @@ struct CachedInterpreter::Instruction
 {
   using CommonCallback = void (*)(UGeckoInstruction);
   using ConditionalCallback = bool (*)(u32);
+  // Fused callbacks handle several guest instructions at once. Their operands are stored in the
+  // `count` Operand entries that follow them.
+  using FusedCallback = void (*)(const Instruction* operands, u32 count);
 
   Instruction() {}
   Instruction(const CommonCallback c, UGeckoInstruction i)
@@ -30,17 +39,29 @@ struct CachedInterpreter::Instruction
   {
   }
 
+  Instruction(const FusedCallback c, u32 count)
+      : fused_callback(c), data(count), type(Type::Fused)
+  {
+  }
+
+  explicit Instruction(u32 operand) : common_callback(nullptr), data(operand), type(Type::Operand)
+  {
+  }
+
   enum class Type
   {
     Abort,
     Common,
     Conditional,
+    Fused,
+    Operand,
   };
 
   union
   {
     const CommonCallback common_callback;
     const ConditionalCallback conditional_callback;
+    const FusedCallback fused_callback;
   };
 
   u32 data = 0;
@@ -99,6 +120,11 @@ void CachedInterpreter::ExecuteOneBlock()
         return;
       break;
 
+    case Instruction::Type::Fused:
+      code->fused_callback(code + 1, code->data);
+      code += code->data;
+      break;
+
     default:
       ERROR_LOG_FMT(POWERPC, "Unknown CachedInterpreter Instruction: {}",
                     static_cast<int>(code->type));
@@ -137,14 +163,13 @@ static void EndBlock(UGeckoInstruction data)
   PowerPC::UpdatePerformanceMonitor(data.hex, 0, 0);
 }
 
-static void UpdateNumLoadStoreInstructions(UGeckoInstruction data)
-{
-  PowerPC::UpdatePerformanceMonitor(0, data.hex, 0);
-}
-
-static void UpdateNumFloatingPointInstructions(UGeckoInstruction data)
+static void EndBlockAndUpdatePerformanceMonitor(const CachedInterpreter::Instruction* operands,
+                                                u32 count)
 {
-  PowerPC::UpdatePerformanceMonitor(0, 0, data.hex);
+  const u32 downcount = operands[0].data;
+  PC = NPC;
+  PowerPC::ppcState.downcount -= downcount;
+  PowerPC::UpdatePerformanceMonitor(downcount, operands[1].data >> 16, operands[1].data & 0xffff);
 }
 
 static void WritePC(UGeckoInstruction data)
@@ -153,6 +178,161 @@ static void WritePC(UGeckoInstruction data)
   NPC = data.hex + 4;
 }
 
+// The fields of a D-form instruction (addi, lwz, stw, cmpi, ...), decoded when the block is
+// compiled. rd is rS for stores and crfD for compares.
+struct DFormOperands
+{
+  u8 rd;
+  u8 ra;
+  u16 imm;
+};
+static_assert(sizeof(DFormOperands) == sizeof(u32));
+
+static u32 DecodeDForm(UGeckoInstruction inst, bool compare)
+{
+  const DFormOperands operands{static_cast<u8>(compare ? inst.CRFD : inst.RD),
+                               static_cast<u8>(inst.RA), static_cast<u16>(inst.UIMM)};
+  return Common::BitCast<u32>(operands);
+}
+
+static u32 GetEffectiveAddress(const DFormOperands& operands)
+{
+  const u32 offset = static_cast<u32>(static_cast<s16>(operands.imm));
+  return operands.ra ? rGPR[operands.ra] + offset : offset;
+}
+
+// Runs of the same instruction, e.g. a chain of lwz or psq_l loading a structure. The callback
+// is a template argument, so the calls are direct and the per-instruction dispatch is skipped.
+template <void (*op)(UGeckoInstruction)>
+static void RunInstructions(const CachedInterpreter::Instruction* operands, u32 count)
+{
+  for (u32 i = 0; i < count; ++i)
+    op(UGeckoInstruction(operands[i].data));
+}
+
+// The integer D-form instructions are common enough in runs to be implemented here on
+// pre-decoded operands. They match their Interpreter counterparts.
+template <auto read>
+static void RunLoads(const CachedInterpreter::Instruction* operands, u32 count)
+{
+  for (u32 i = 0; i < count; ++i)
+  {
+    const auto d_form = Common::BitCast<DFormOperands>(operands[i].data);
+    const u32 temp = read(GetEffectiveAddress(d_form));
+    if (!(PowerPC::ppcState.Exceptions & EXCEPTION_DSI))
+      rGPR[d_form.rd] = temp;
+  }
+}
+
+template <auto write>
+static void RunStores(const CachedInterpreter::Instruction* operands, u32 count)
+{
+  for (u32 i = 0; i < count; ++i)
+  {
+    const auto d_form = Common::BitCast<DFormOperands>(operands[i].data);
+    write(rGPR[d_form.rd], GetEffectiveAddress(d_form));
+  }
+}
+
+static void RunAddImmediates(const CachedInterpreter::Instruction* operands, u32 count)
+{
+  for (u32 i = 0; i < count; ++i)
+  {
+    const auto d_form = Common::BitCast<DFormOperands>(operands[i].data);
+    rGPR[d_form.rd] = GetEffectiveAddress(d_form);
+  }
+}
+
+// A compare immediately followed by the conditional branch that consumes its result.
+// Operands: the compare, the branch and the address of the branch.
+template <void (*compare)(UGeckoInstruction)>
+static void CompareAndBranch(const CachedInterpreter::Instruction* operands, u32 count)
+{
+  compare(UGeckoInstruction(operands[0].data));
+  WritePC(UGeckoInstruction(operands[2].data));
+  Interpreter::bcx(UGeckoInstruction(operands[1].data));
+}
+
+// Same as above for cmpi (T = s32) and cmpli (T = u32), with the compare pre-decoded.
+template <typename T>
+static void CompareImmediateAndBranch(const CachedInterpreter::Instruction* operands, u32 count)
+{
+  const auto d_form = Common::BitCast<DFormOperands>(operands[0].data);
+  const T a = static_cast<T>(rGPR[d_form.ra]);
+  const T b = std::is_signed_v<T> ? static_cast<T>(static_cast<s16>(d_form.imm)) : d_form.imm;
+
+  u32 cr_field;
+  if (a < b)
+    cr_field = PowerPC::CR_LT;
+  else if (a > b)
+    cr_field = PowerPC::CR_GT;
+  else
+    cr_field = PowerPC::CR_EQ;
+  if (PowerPC::GetXER_SO())
+    cr_field |= PowerPC::CR_SO;
+  PowerPC::ppcState.cr.SetField(d_form.rd, cr_field);
+
+  WritePC(UGeckoInstruction(operands[2].data));
+  Interpreter::bcx(UGeckoInstruction(operands[1].data));
+}
+
+using InterpreterOp = void (*)(UGeckoInstruction);
+using FusedCallback = void (*)(const CachedInterpreter::Instruction*, u32);
+
+struct FusedEntry
+{
+  InterpreterOp op;
+  FusedCallback callback;
+  // The operands are DecodeDForm() results instead of raw instructions.
+  bool d_form;
+};
+
+template <InterpreterOp op>
+static constexpr FusedEntry RunEntry()
+{
+  return {op, RunInstructions<op>, false};
+}
+
+template <InterpreterOp op>
+static constexpr FusedEntry CompareAndBranchEntry()
+{
+  return {op, CompareAndBranch<op>, false};
+}
+
+static constexpr std::array s_run_callbacks{
+    FusedEntry{Interpreter::lwz, RunLoads<PowerPC::Read_U32>, true},
+    FusedEntry{Interpreter::stw, RunStores<PowerPC::Write_U32>, true},
+    FusedEntry{Interpreter::lbz, RunLoads<PowerPC::Read_U8>, true},
+    FusedEntry{Interpreter::stb, RunStores<PowerPC::Write_U8>, true},
+    FusedEntry{Interpreter::lhz, RunLoads<PowerPC::Read_U16>, true},
+    FusedEntry{Interpreter::sth, RunStores<PowerPC::Write_U16>, true},
+    FusedEntry{Interpreter::addi, RunAddImmediates, true},
+    RunEntry<Interpreter::lfs>(),
+    RunEntry<Interpreter::stfs>(),
+    RunEntry<Interpreter::lfd>(),
+    RunEntry<Interpreter::stfd>(),
+    RunEntry<Interpreter::psq_l>(),
+    RunEntry<Interpreter::psq_st>(),
+    RunEntry<Interpreter::ps_mr>(),
+    RunEntry<Interpreter::ps_mul>(),
+    RunEntry<Interpreter::ps_madd>(),
+};
+
+static constexpr std::array s_compare_and_branch_callbacks{
+    CompareAndBranchEntry<Interpreter::cmp>(),
+    FusedEntry{Interpreter::cmpi, CompareImmediateAndBranch<s32>, true},
+    CompareAndBranchEntry<Interpreter::cmpl>(),
+    FusedEntry{Interpreter::cmpli, CompareImmediateAndBranch<u32>, true},
+};
+
+template <std::size_t N>
+static const FusedEntry* FindFusedEntry(const std::array<FusedEntry, N>& table, InterpreterOp op)
+{
+  const auto it = std::find_if(table.begin(), table.end(),
+                               [op](const FusedEntry& entry) { return entry.op == op; });
+  return it != table.end() ? &*it : nullptr;
+}
+
 static void WriteBrokenBlockNPC(UGeckoInstruction data)
 {
   NPC = data.hex;
@@ -227,6 +407,92 @@ bool CachedInterpreter::HandleFunctionHooking(u32 address)
   });
 }
 
+void CachedInterpreter::EmitEndBlock()
+{
+  static_assert(code_buffer_size <= 0x10000,
+                "The instruction counters of a block must fit in 16 bits each");
+
+  m_code.emplace_back(EndBlockAndUpdatePerformanceMonitor, 2);
+  m_code.emplace_back(static_cast<u32>(js.downcountAmount));
+  m_code.emplace_back(static_cast<u32>(js.numLoadStoreInst << 16 | js.numFloatingPointInst));
+}
+
+void CachedInterpreter::CountInstruction(const PPCAnalyst::CodeOp& op)
+{
+  js.downcountAmount += op.opinfo->numCycles;
+  if (op.opinfo->flags & FL_LOADSTORE)
+    ++js.numLoadStoreInst;
+  if (op.opinfo->flags & FL_USE_FPU)
+    ++js.numFloatingPointInst;
+}
+
+bool CachedInterpreter::CanFuseInstruction(const PPCAnalyst::CodeOp& op)
+{
+  // Fused instructions don't get any of the per-instruction checks, so only instructions that
+  // wouldn't have needed them qualify.
+  if (op.skip || op.branchIsIdleLoop || HLE::GetHookByFunctionAddress(op.address) != 0)
+    return false;
+  if (m_enable_debugging && PowerPC::breakpoints.IsAddressBreakPoint(op.address))
+    return false;
+  if ((op.opinfo->flags & FL_USE_FPU) && !js.firstFPInstructionFound)
+    return false;
+  if ((op.opinfo->flags & FL_LOADSTORE) && jo.memcheck)
+    return false;
+  return (op.opinfo->flags & FL_ENDBLOCK) == 0 && !ShouldHandleFPExceptionForInstruction(&op);
+}
+
+u32 CachedInterpreter::EmitFusedInstructions(u32 index)
+{
+  const PPCAnalyst::CodeOp& op = m_code_buffer[index];
+  const InterpreterOp interpreter_op = PPCTables::GetInterpreterOp(op.inst);
+  const u32 end = code_block.m_num_instructions;
+
+  const FusedEntry* compare = FindFusedEntry(s_compare_and_branch_callbacks, interpreter_op);
+  if (compare && index + 1 < end)
+  {
+    const PPCAnalyst::CodeOp& branch = m_code_buffer[index + 1];
+    if (!branch.skip && !branch.branchIsIdleLoop &&
+        PPCTables::GetInterpreterOp(branch.inst) == Interpreter::bcx &&
+        HLE::GetHookByFunctionAddress(branch.address) == 0 &&
+        !(m_enable_debugging && PowerPC::breakpoints.IsAddressBreakPoint(branch.address)))
+    {
+      CountInstruction(branch);
+      m_code.emplace_back(compare->callback, 3);
+      m_code.emplace_back(compare->d_form ? DecodeDForm(op.inst, true) : op.inst.hex);
+      m_code.emplace_back(branch.inst.hex);
+      m_code.emplace_back(branch.address);
+      EmitEndBlock();
+      return 2;
+    }
+    return 0;
+  }
+
+  const FusedEntry* run = FindFusedEntry(s_run_callbacks, interpreter_op);
+  if (!run)
+    return 0;
+
+  u32 count = 1;
+  while (index + count < end)
+  {
+    const PPCAnalyst::CodeOp& next = m_code_buffer[index + count];
+    if (PPCTables::GetInterpreterOp(next.inst) != interpreter_op || !CanFuseInstruction(next))
+      break;
+    ++count;
+  }
+  if (count < 2)
+    return 0;
+
+  m_code.emplace_back(run->callback, count);
+  for (u32 i = 0; i < count; ++i)
+  {
+    const PPCAnalyst::CodeOp& fused_op = m_code_buffer[index + i];
+    if (i != 0)
+      CountInstruction(fused_op);
+    m_code.emplace_back(run->d_form ? DecodeDForm(fused_op.inst, false) : fused_op.inst.hex);
+  }
+  return count;
+}
+
 void CachedInterpreter::Jit(u32 address)
 {
   if (m_code.size() >= CODE_SIZE / sizeof(Instruction) - 0x1000 ||
@@ -263,15 +529,20 @@ void CachedInterpreter::Jit(u32 address)
   {
     PPCAnalyst::CodeOp& op = m_code_buffer[i];
 
-    js.downcountAmount += op.opinfo->numCycles;
-    if (op.opinfo->flags & FL_LOADSTORE)
-      ++js.numLoadStoreInst;
-    if (op.opinfo->flags & FL_USE_FPU)
-      ++js.numFloatingPointInst;
+    CountInstruction(op);
 
     if (HandleFunctionHooking(op.address))
       break;
 
+    if (CanFuseInstruction(op))
+    {
+      if (const u32 fused = EmitFusedInstructions(i))
+      {
+        i += fused - 1;
+        continue;
+      }
+    }
+
     if (!op.skip)
     {
       const bool breakpoint =
@@ -302,19 +573,13 @@ void CachedInterpreter::Jit(u32 address)
       if (idle_loop)
         m_code.emplace_back(CheckIdle, js.blockStart);
       if (endblock)
-      {
-        m_code.emplace_back(EndBlock, js.downcountAmount);
-        m_code.emplace_back(UpdateNumLoadStoreInstructions, js.numLoadStoreInst);
-        m_code.emplace_back(UpdateNumFloatingPointInstructions, js.numFloatingPointInst);
-      }
+        EmitEndBlock();
     }
   }
   if (code_block.m_broken)
   {
     m_code.emplace_back(WriteBrokenBlockNPC, nextPC);
-    m_code.emplace_back(EndBlock, js.downcountAmount);
-    m_code.emplace_back(UpdateNumLoadStoreInstructions, js.numLoadStoreInst);
-    m_code.emplace_back(UpdateNumFloatingPointInstructions, js.numFloatingPointInst);
+    EmitEndBlock();
   }
   m_code.emplace_back();
 
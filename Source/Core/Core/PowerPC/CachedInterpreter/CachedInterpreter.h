@@ -13,6 +13,8 @@
 class CachedInterpreter : public JitBase
 {
 public:
+  struct Instruction;
+
   CachedInterpreter();
   ~CachedInterpreter();
 
@@ -32,13 +34,17 @@ public:
   const CommonAsmRoutinesBase* GetAsmRoutines() override { return nullptr; }
 
 private:
-  struct Instruction;
-
   u8* GetCodePtr();
   void ExecuteOneBlock();
 
   bool HandleFunctionHooking(u32 address);
 
+  void CountInstruction(const PPCAnalyst::CodeOp& op);
+  bool CanFuseInstruction(const PPCAnalyst::CodeOp& op);
+  // Returns the number of guest instructions that were emitted, or 0 if nothing could be fused.
+  u32 EmitFusedInstructions(u32 index);
+  void EmitEndBlock();
+
   BlockCache m_block_cache{*this};
   std::vector<Instruction> m_code;
 };
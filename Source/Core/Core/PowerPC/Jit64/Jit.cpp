@@ -233,7 +233,17 @@ bool Jit64::HandleFault(uintptr_t access_address, SContext* ctx)
 
   const auto logical_base_ptr = reinterpret_cast<uintptr_t>(Memory::logical_base);
   if (access_address >= logical_base_ptr && access_address < logical_base_ptr + 0x100010000)
-    return BackPatch(static_cast<u32>(access_address - logical_base_ptr), ctx);
+  {
+    // Pages translated through the page table are mapped on their first access. Only fall back
+    // to backpatching if this one can't be.
+    const u32 em_address = static_cast<u32>(access_address - logical_base_ptr);
+    if (IsInSpace(reinterpret_cast<u8*>(ctx->CTX_PC)) &&
+        PowerPC::AddPageTableFastmemMapping(em_address))
+    {
+      return true;
+    }
+    return BackPatch(em_address, ctx);
+  }
 
   return false;
 }
@@ -111,37 +111,35 @@ void Jit64AsmRoutineManager::Generate()
   const bool assembly_dispatcher = true;
   if (assembly_dispatcher)
   {
-    // Fast block number lookup.
-    // ((PC >> 2) & mask) * sizeof(JitBlock*) = (PC & (mask << 2)) * 2
+    // Fast block lookup through the two-level table:
+    // directory[((msr & JIT_CACHE_MSR_MASK) << MSR_SHIFT) | (PC >> PAGE_SHIFT)][PC & PAGE_MASK]
     MOV(32, R(RSCRATCH), PPCSTATE(pc));
-    // Keep a copy for later.
+    MOV(32, R(RSCRATCH2), PPCSTATE(msr));
+    AND(32, R(RSCRATCH2), Imm32(JitBaseBlockCache::JIT_CACHE_MSR_MASK));
+    SHL(32, R(RSCRATCH2), Imm8(JitBaseBlockCache::FAST_BLOCK_MAP_MSR_SHIFT));
     MOV(32, R(RSCRATCH_EXTRA), R(RSCRATCH));
-    u64 icache = reinterpret_cast<u64>(m_jit.GetBlockCache()->GetFastBlockMap());
-    AND(32, R(RSCRATCH), Imm32(JitBaseBlockCache::FAST_BLOCK_MAP_MASK << 2));
-    if (icache <= INT_MAX)
+    SHR(32, R(RSCRATCH_EXTRA), Imm8(JitBaseBlockCache::FAST_BLOCK_MAP_PAGE_SHIFT));
+    OR(32, R(RSCRATCH2), R(RSCRATCH_EXTRA));
+    u64 directory = reinterpret_cast<u64>(m_jit.GetBlockCache()->GetFastBlockMap());
+    if (directory <= INT_MAX)
     {
-      MOV(64, R(RSCRATCH), MScaled(RSCRATCH, SCALE_2, static_cast<s32>(icache)));
+      MOV(64, R(RSCRATCH2), MScaled(RSCRATCH2, SCALE_8, static_cast<s32>(directory)));
     }
     else
     {
-      MOV(64, R(RSCRATCH2), Imm64(icache));
-      MOV(64, R(RSCRATCH), MComplex(RSCRATCH2, RSCRATCH, SCALE_2, 0));
+      MOV(64, R(RSCRATCH_EXTRA), Imm64(directory));
+      MOV(64, R(RSCRATCH2), MComplex(RSCRATCH_EXTRA, RSCRATCH2, SCALE_8, 0));
     }
 
-    // Check if we found a block.
+    // ((PC & page_mask) >> 2) * sizeof(JitBlock*) = (PC & (page_mask & ~3)) * 2
+    AND(32, R(RSCRATCH), Imm32(JitBaseBlockCache::FAST_BLOCK_MAP_PAGE_MASK & ~3u));
+    MOV(64, R(RSCRATCH), MComplex(RSCRATCH2, RSCRATCH, SCALE_2, 0));
+
+    // Check if we found a block. Every (PC, MSR) pair has its own slot, so there is
+    // no need to compare block.effectiveAddress and block.msrBits.
     TEST(64, R(RSCRATCH), R(RSCRATCH));
     FixupBranch not_found = J_CC(CC_Z);
 
-    // Check both block.effectiveAddress and block.msrBits.
-    MOV(32, R(RSCRATCH2), PPCSTATE(msr));
-    AND(32, R(RSCRATCH2), Imm32(JitBaseBlockCache::JIT_CACHE_MSR_MASK));
-    SHL(64, R(RSCRATCH2), Imm8(32));
-    // RSCRATCH_EXTRA still has the PC.
-    OR(64, R(RSCRATCH2), R(RSCRATCH_EXTRA));
-    CMP(64, R(RSCRATCH2),
-        MDisp(RSCRATCH, static_cast<s32>(offsetof(JitBlockData, effectiveAddress))));
-    FixupBranch state_mismatch = J_CC(CC_NE);
-
     // Success; branch to the block we found.
     // Switch to the correct memory base, in case MSR.DR has changed.
     TEST(32, PPCSTATE(msr), Imm32(1 << (31 - 27)));
@@ -153,7 +151,6 @@ void Jit64AsmRoutineManager::Generate()
     JMPptr(MDisp(RSCRATCH, static_cast<s32>(offsetof(JitBlockData, normalEntry))));
 
     SetJumpTarget(not_found);
-    SetJumpTarget(state_mismatch);
 
     // Failure, fallback to the C++ dispatcher for calling the JIT.
   }
@@ -311,6 +311,100 @@ void EmuCodeBlock::MMIOLoadToReg(MMIO::Mapping* mmio, Gen::X64Reg reg_value,
   }
 }
 
+// Visitor that generates code to write a MMIO value.
+template <typename T>
+class MMIOWriteCodeGenerator : public MMIO::WriteHandlingMethodVisitor<T>
+{
+public:
+  MMIOWriteCodeGenerator(Gen::X64CodeBlock* code, BitSet32 registers_in_use,
+                         const Gen::OpArg& value, u32 address)
+      : m_code(code), m_registers_in_use(registers_in_use), m_value(value), m_address(address)
+  {
+  }
+
+  void VisitNop() override
+  {
+    // Do nothing
+  }
+  void VisitDirect(T* addr, u32 mask) override { WriteValueToAddr(8 * sizeof(T), addr, mask); }
+  void VisitComplex(const std::function<void(u32, T)>* lambda) override
+  {
+    CallLambda(8 * sizeof(T), lambda);
+  }
+
+private:
+  // Zero extends the value to 32 bits in RSCRATCH, or returns it as an immediate, applying the
+  // given mask either way. The value may already be in RSCRATCH.
+  OpArg GetMaskedValue(int sbits, u32 mask)
+  {
+    const u32 all_ones = static_cast<u32>((1ULL << sbits) - 1);
+    if (m_value.IsImm())
+      return Imm32(m_value.AsImm32().Imm32() & all_ones & mask);
+
+    if (sbits == 32)
+    {
+      if (!m_value.IsSimpleReg(RSCRATCH))
+        m_code->MOV(32, R(RSCRATCH), m_value);
+    }
+    else
+    {
+      m_code->MOVZX(32, sbits, RSCRATCH, m_value);
+    }
+    if ((all_ones & mask) != all_ones)
+      m_code->AND(32, R(RSCRATCH), Imm32(mask));
+    return R(RSCRATCH);
+  }
+
+  void WriteValueToAddr(int sbits, void* ptr, u32 mask)
+  {
+    const OpArg value = GetMaskedValue(sbits, mask);
+    m_code->MOV(64, R(RSCRATCH2), ImmPtr(ptr));
+    if (value.IsImm())
+      m_code->MOV(sbits, MatR(RSCRATCH2), FixImmediate(sbits, value));
+    else
+      m_code->MOV(sbits, MatR(RSCRATCH2), value);
+  }
+
+  void CallLambda(int sbits, const std::function<void(u32, T)>* lambda)
+  {
+    const OpArg value = GetMaskedValue(sbits, 0xFFFFFFFF);
+    m_code->ABI_PushRegistersAndAdjustStack(m_registers_in_use, 0);
+    m_code->ABI_CallLambdaCA(32, lambda, m_address, value);
+    m_code->ABI_PopRegistersAndAdjustStack(m_registers_in_use, 0);
+  }
+
+  Gen::X64CodeBlock* m_code;
+  BitSet32 m_registers_in_use;
+  Gen::OpArg m_value;
+  u32 m_address;
+};
+
+void EmuCodeBlock::MMIOWriteRegToAddr(MMIO::Mapping* mmio, const Gen::OpArg& value,
+                                      BitSet32 registers_in_use, u32 address, int access_size)
+{
+  switch (access_size)
+  {
+  case 8:
+  {
+    MMIOWriteCodeGenerator<u8> gen(this, registers_in_use, value, address);
+    mmio->GetHandlerForWrite<u8>(address).Visit(gen);
+    break;
+  }
+  case 16:
+  {
+    MMIOWriteCodeGenerator<u16> gen(this, registers_in_use, value, address);
+    mmio->GetHandlerForWrite<u16>(address).Visit(gen);
+    break;
+  }
+  case 32:
+  {
+    MMIOWriteCodeGenerator<u32> gen(this, registers_in_use, value, address);
+    mmio->GetHandlerForWrite<u32>(address).Visit(gen);
+    break;
+  }
+  }
+}
+
 void EmuCodeBlock::SafeLoadToReg(X64Reg reg_value, const Gen::OpArg& opAddress, int accessSize,
                                  s32 offset, BitSet32 registersInUse, bool signExtend, int flags)
 {
@@ -438,7 +532,7 @@ void EmuCodeBlock::SafeLoadToRegImmediate(X64Reg reg_value, u32 address, int acc
   }
 
   // If the address maps to an MMIO register, inline MMIO read code.
-  u32 mmioAddress = PowerPC::IsOptimizableMMIOAccess(address, accessSize);
+  u32 mmioAddress = PowerPC::IsOptimizableMMIOAccess(address, accessSize, false);
   if (accessSize != 64 && mmioAddress)
   {
     MMIOLoadToReg(Memory::mmio_mapping.get(), reg_value, registersInUse, mmioAddress, accessSize,
@@ -642,6 +736,15 @@ bool EmuCodeBlock::WriteToConstAddress(int accessSize, OpArg arg, u32 address,
     WriteToConstRamAddress(accessSize, arg, address);
     return false;
   }
+  else if (const u32 mmio_address = PowerPC::IsOptimizableMMIOAccess(address, accessSize, true);
+           accessSize != 64 && mmio_address)
+  {
+    // If the address maps to an MMIO register, inline MMIO write code. MMIO writes can't raise
+    // a DSI, so no exception check is needed afterwards.
+    MOV(32, PPCSTATE(pc), Imm32(m_jit.js.compilerPC));
+    MMIOWriteRegToAddr(Memory::mmio_mapping.get(), arg, registersInUse, mmio_address, accessSize);
+    return false;
+  }
   else
   {
     // Helps external systems know which instruction triggered the write
@@ -288,6 +288,16 @@ bool JitArm64::HandleFastmemFault(uintptr_t access_address, SContext* ctx)
     return false;
   }
 
+  // Pages translated through the page table are mapped on their first access. Only fall back to
+  // backpatching if this one can't be.
+  if (access_address >= (uintptr_t)Memory::logical_base &&
+      access_address < (uintptr_t)Memory::logical_base + 0x100010000 &&
+      PowerPC::AddPageTableFastmemMapping(
+          static_cast<u32>(access_address - (uintptr_t)Memory::logical_base)))
+  {
+    return true;
+  }
+
   const u8* pc = reinterpret_cast<const u8*>(ctx->CTX_PC);
   auto slow_handler_iter = m_fault_to_handler.upper_bound(pc);
 
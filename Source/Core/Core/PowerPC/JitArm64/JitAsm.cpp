@@ -99,35 +99,28 @@ void JitArm64::GenerateAsm()
     MOVP2R(MEM_REG, Memory::logical_base);
     SetJumpTarget(membaseend);
 
-    // iCache[(address >> 2) & iCache_Mask];
-    ARM64Reg pc_masked = ARM64Reg::W25;
+    // directory[((msr & JIT_CACHE_MSR_MASK) << MSR_SHIFT) | (pc >> PAGE_SHIFT)][pc & PAGE_MASK]
+    ARM64Reg index = ARM64Reg::W25;
+    ARM64Reg msr_bits = ARM64Reg::W24;
     ARM64Reg cache_base = ARM64Reg::X27;
     ARM64Reg block = ARM64Reg::X30;
-    ORR(pc_masked, ARM64Reg::WZR, LogicalImm(JitBaseBlockCache::FAST_BLOCK_MAP_MASK << 3, 32));
-    AND(pc_masked, pc_masked, DISPATCHER_PC, ArithOption(DISPATCHER_PC, ShiftType::LSL, 1));
+    LDR(IndexType::Unsigned, msr_bits, PPC_REG, PPCSTATE_OFF(msr));
+    AND(msr_bits, msr_bits, LogicalImm(JitBaseBlockCache::JIT_CACHE_MSR_MASK, 32));
+    LSR(index, DISPATCHER_PC, JitBaseBlockCache::FAST_BLOCK_MAP_PAGE_SHIFT);
+    ORR(index, index, msr_bits,
+        ArithOption(msr_bits, ShiftType::LSL, JitBaseBlockCache::FAST_BLOCK_MAP_MSR_SHIFT));
     MOVP2R(cache_base, GetBlockCache()->GetFastBlockMap());
-    LDR(block, cache_base, EncodeRegTo64(pc_masked));
-    FixupBranch not_found = CBZ(block);
-
-    // b.effectiveAddress != addr || b.msrBits != msr
-    ARM64Reg pc_and_msr = ARM64Reg::W25;
-    ARM64Reg pc_and_msr2 = ARM64Reg::W24;
-    LDR(IndexType::Unsigned, pc_and_msr, block, offsetof(JitBlockData, effectiveAddress));
-    CMP(pc_and_msr, DISPATCHER_PC);
-    FixupBranch pc_missmatch = B(CC_NEQ);
+    LDR(cache_base, cache_base, ArithOption(EncodeRegTo64(index), true));
+    UBFX(index, DISPATCHER_PC, 2, JitBaseBlockCache::FAST_BLOCK_MAP_PAGE_SHIFT - 2);
+    LDR(block, cache_base, ArithOption(EncodeRegTo64(index), true));
 
-    LDR(IndexType::Unsigned, pc_and_msr2, PPC_REG, PPCSTATE_OFF(msr));
-    AND(pc_and_msr2, pc_and_msr2, LogicalImm(JitBaseBlockCache::JIT_CACHE_MSR_MASK, 32));
-    LDR(IndexType::Unsigned, pc_and_msr, block, offsetof(JitBlockData, msrBits));
-    CMP(pc_and_msr, pc_and_msr2);
-    FixupBranch msr_missmatch = B(CC_NEQ);
+    // Every (pc, msr) pair has its own slot, so a non-null entry is always the right block.
+    FixupBranch not_found = CBZ(block);
 
     // return blocks[block_num].normalEntry;
     LDR(IndexType::Unsigned, block, block, offsetof(JitBlockData, normalEntry));
     BR(block);
     SetJumpTarget(not_found);
-    SetJumpTarget(pc_missmatch);
-    SetJumpTarget(msr_missmatch);
   }
 
   // Call C version of Dispatch().
@@ -13,12 +13,15 @@
 
 #include "Common/CommonTypes.h"
 #include "Common/JitRegister.h"
+#include "Common/Logging/Log.h"
+#include "Common/MemoryUtil.h"
 #include "Core/Config/MainSettings.h"
 #include "Core/Core.h"
 #include "Core/PowerPC/JitCommon/JitBase.h"
 #include "Core/PowerPC/MMU.h"
 #include "Core/PowerPC/PPCSymbolDB.h"
 #include "Core/PowerPC/PowerPC.h"
+#include "Core/PowerPC/SamplingProfiler.h"
 
 #ifdef _WIN32
 #include <windows.h>
@@ -32,21 +35,55 @@ bool JitBlock::OverlapsPhysicalRange(u32 address, u32 length) const
          physical_addresses.lower_bound(address + length);
 }
 
-JitBaseBlockCache::JitBaseBlockCache(JitBase& jit) : m_jit{jit}
+ValidBlockBitSet::ValidBlockBitSet()
 {
+  // Freshly allocated pages are zeroed and only committed on first write.
+  m_valid_block = static_cast<u32*>(
+      Common::AllocateMemoryPages(sizeof(u32) * VALID_BLOCK_ALLOC_ELEMENTS));
+}
+
+ValidBlockBitSet::~ValidBlockBitSet()
+{
+  Common::FreeMemoryPages(m_valid_block, sizeof(u32) * VALID_BLOCK_ALLOC_ELEMENTS);
+}
+
+void ValidBlockBitSet::ClearAll()
+{
+  for (size_t i = 0; i < m_dirty.size(); ++i)
+  {
+    if (!m_dirty[i])
+      continue;
+
+    std::memset(&m_valid_block[i * VALID_BLOCK_DIRTY_GRANULE], 0,
+                sizeof(u32) * VALID_BLOCK_DIRTY_GRANULE);
+  }
+  m_dirty.reset();
+}
+
+JitBaseBlockCache::JitBaseBlockCache(JitBase& jit)
+    : m_jit{jit}, fast_block_map{std::make_unique<JitBlock**[]>(FAST_BLOCK_MAP_DIRECTORY_ELEMENTS)},
+      fast_block_map_empty_page{std::make_unique<FastBlockMapPage>()}
+{
+  std::fill_n(fast_block_map.get(), FAST_BLOCK_MAP_DIRECTORY_ELEMENTS,
+              fast_block_map_empty_page->data());
 }
 
 JitBaseBlockCache::~JitBaseBlockCache() = default;
 
 void JitBaseBlockCache::Init()
 {
-  JitRegister::Init(Config::Get(Config::MAIN_PERF_MAP_DIR));
+  JitRegister::Init(Config::Get(Config::MAIN_PERF_MAP_DIR),
+                    Config::Get(Config::MAIN_PERF_JIT_DUMP));
 
   Clear();
+
+  m_invalidation_stats = {};
+  page_rewrite_counts.clear();
 }
 
 void JitBaseBlockCache::Shutdown()
 {
+  LogInvalidationStats();
   JitRegister::Shutdown();
 }
 
@@ -59,6 +96,8 @@ void JitBaseBlockCache::Clear()
 #endif
   m_jit.js.fifoWriteAddresses.clear();
   m_jit.js.pairedQuantizeAddresses.clear();
+  if (!block_map.empty())
+    m_invalidation_stats.cache_clears++;
   for (auto& e : block_map)
   {
     DestroyBlock(e.second);
@@ -69,7 +108,9 @@ void JitBaseBlockCache::Clear()
 
   valid_block.ClearAll();
 
-  fast_block_map.fill(nullptr);
+  for (const auto& [directory_index, page] : fast_block_map_pages)
+    fast_block_map[directory_index] = fast_block_map_empty_page->data();
+  fast_block_map_pages.clear();
 }
 
 void JitBaseBlockCache::Reset()
@@ -78,9 +119,9 @@ void JitBaseBlockCache::Reset()
   Init();
 }
 
-JitBlock** JitBaseBlockCache::GetFastBlockMap()
+JitBlock* const* const* JitBaseBlockCache::GetFastBlockMap() const
 {
-  return fast_block_map.data();
+  return fast_block_map.get();
 }
 
 void JitBaseBlockCache::RunOnBlocks(std::function<void(const JitBlock&)> f)
@@ -97,16 +138,13 @@ JitBlock* JitBaseBlockCache::AllocateBlock(u32 em_address)
   b.physicalAddress = physical_address;
   b.msrBits = MSR.Hex & JIT_CACHE_MSR_MASK;
   b.linkData.clear();
-  b.fast_block_map_index = 0;
   return &b;
 }
 
 void JitBaseBlockCache::FinalizeBlock(JitBlock& block, bool block_link,
                                       const std::set<u32>& physical_addresses)
 {
-  size_t index = FastLookupIndexForAddress(block.effectiveAddress);
-  fast_block_map[index] = &block;
-  block.fast_block_map_index = index;
+  FastLookupEntry(block.effectiveAddress, block.msrBits) = &block;
 
   block.physical_addresses = physical_addresses;
 
@@ -167,10 +205,12 @@ JitBlock* JitBaseBlockCache::GetBlockFromStartAddress(u32 addr, u32 msr)
 
 const u8* JitBaseBlockCache::Dispatch()
 {
-  JitBlock* block = fast_block_map[FastLookupIndexForAddress(PC)];
+  const u32 msr_bits = MSR.Hex & JIT_CACHE_MSR_MASK;
+  JitBlock* block =
+      fast_block_map[FastLookupDirectoryIndex(PC, msr_bits)][FastLookupPageIndex(PC)];
 
-  if (!block || block->effectiveAddress != PC || block->msrBits != (MSR.Hex & JIT_CACHE_MSR_MASK))
-    block = MoveBlockIntoFastCache(PC, MSR.Hex & JIT_CACHE_MSR_MASK);
+  if (!block)
+    block = MoveBlockIntoFastCache(PC, msr_bits);
 
   if (!block)
     return nullptr;
@@ -180,6 +220,7 @@ const u8* JitBaseBlockCache::Dispatch()
 
 void JitBaseBlockCache::InvalidateICacheLine(u32 address)
 {
+  m_invalidation_stats.cache_line_requests++;
   const u32 cache_line_address = address & ~0x1f;
   const auto translated = PowerPC::JitCache_TranslateAddress(cache_line_address);
   if (translated.valid)
@@ -188,6 +229,11 @@ void JitBaseBlockCache::InvalidateICacheLine(u32 address)
 
 void JitBaseBlockCache::InvalidateICache(u32 initial_address, u32 initial_length, bool forced)
 {
+  if (forced)
+    m_invalidation_stats.forced_requests++;
+  else
+    m_invalidation_stats.range_requests++;
+
   u32 address = initial_address;
   u32 length = initial_length;
   while (length > 0)
@@ -225,7 +271,10 @@ void JitBaseBlockCache::InvalidateICacheInternal(u32 physical_address, u32 addre
   if (length == 32 && (physical_address & 0x1fu) == 0)
   {
     if (!valid_block.Test(physical_address / 32))
+    {
       destroy_block = false;
+      m_invalidation_stats.skipped_requests++;
+    }
     else
       valid_block.Clear(physical_address / 32);
   }
@@ -243,7 +292,9 @@ void JitBaseBlockCache::InvalidateICacheInternal(u32 physical_address, u32 addre
   if (destroy_block)
   {
     // destroy JIT blocks
-    ErasePhysicalRange(physical_address, length);
+    const u32 destroyed_blocks = ErasePhysicalRange(physical_address, length);
+    if (destroyed_blocks != 0 && !forced)
+      CountPageRewrites(physical_address, length);
 
     // If the code was actually modified, we need to clear the relevant entries from the
     // FIFO write address cache, so we don't end up with FIFO checks in places they shouldn't
@@ -260,8 +311,10 @@ void JitBaseBlockCache::InvalidateICacheInternal(u32 physical_address, u32 addre
   }
 }
 
-void JitBaseBlockCache::ErasePhysicalRange(u32 address, u32 length)
+u32 JitBaseBlockCache::ErasePhysicalRange(u32 address, u32 length)
 {
+  u32 destroyed_blocks = 0;
+
   // Iterate over all macro blocks which overlap the given range.
   u32 range_mask = ~(BLOCK_RANGE_MAP_ELEMENTS - 1);
   auto start = block_range_map.lower_bound(address & range_mask);
@@ -294,6 +347,7 @@ void JitBaseBlockCache::ErasePhysicalRange(u32 address, u32 length)
           block_map_iter.first++;
         }
         iter = start->second.erase(iter);
+        destroyed_blocks++;
       }
       else
       {
@@ -307,11 +361,42 @@ void JitBaseBlockCache::ErasePhysicalRange(u32 address, u32 length)
     else
       start++;
   }
+
+  m_invalidation_stats.destroyed_blocks += destroyed_blocks;
+  return destroyed_blocks;
+}
+
+void JitBaseBlockCache::CountPageRewrites(u32 physical_address, u32 length)
+{
+  const u32 first_page = physical_address >> PowerPC::HW_PAGE_INDEX_SHIFT;
+  const u32 last_page =
+      static_cast<u32>((u64{physical_address} + length - 1) >> PowerPC::HW_PAGE_INDEX_SHIFT);
+  for (u32 page = first_page; page <= last_page; ++page)
+  {
+    const u32 rewrites = ++page_rewrite_counts[page];
+    if (rewrites == SMC_PAGE_THRESHOLD)
+    {
+      m_invalidation_stats.self_modifying_pages++;
+      INFO_LOG_FMT(DYNA_REC, "Code on physical page {:08x} has been rewritten {} times",
+                   page << PowerPC::HW_PAGE_INDEX_SHIFT, rewrites);
+    }
+  }
+}
+
+void JitBaseBlockCache::LogInvalidationStats() const
+{
+  const JitInvalidationStats& stats = m_invalidation_stats;
+  INFO_LOG_FMT(DYNA_REC,
+               "JIT invalidations: {} cache line, {} range, {} forced, {} skipped; "
+               "{} blocks destroyed, {} cache clears, {} self-modifying pages",
+               stats.cache_line_requests, stats.range_requests, stats.forced_requests,
+               stats.skipped_requests, stats.destroyed_blocks, stats.cache_clears,
+               stats.self_modifying_pages);
 }
 
 u32* JitBaseBlockCache::GetBlockBitSet() const
 {
-  return valid_block.m_valid_block.get();
+  return valid_block.m_valid_block;
 }
 
 void JitBaseBlockCache::WriteDestroyBlock(const JitBlock& block)
@@ -384,8 +469,14 @@ void JitBaseBlockCache::UnlinkBlock(const JitBlock& block)
 
 void JitBaseBlockCache::DestroyBlock(JitBlock& block)
 {
-  if (fast_block_map[block.fast_block_map_index] == &block)
-    fast_block_map[block.fast_block_map_index] = nullptr;
+  // The profiler needs to know where this block's code was before it is gone.
+  SamplingProfiler::ResolvePendingSamples();
+
+  // Never write into the shared empty page; it can't contain this block anyway.
+  JitBlock** page = fast_block_map[FastLookupDirectoryIndex(block.effectiveAddress, block.msrBits)];
+  JitBlock*& entry = page[FastLookupPageIndex(block.effectiveAddress)];
+  if (entry == &block)
+    entry = nullptr;
 
   UnlinkBlock(block);
 
@@ -411,19 +502,20 @@ JitBlock* JitBaseBlockCache::MoveBlockIntoFastCache(u32 addr, u32 msr)
   if (!block)
     return nullptr;
 
-  // Drop old fast block map entry
-  if (fast_block_map[block->fast_block_map_index] == block)
-    fast_block_map[block->fast_block_map_index] = nullptr;
-
-  // And create a new one
-  size_t index = FastLookupIndexForAddress(addr);
-  fast_block_map[index] = block;
-  block->fast_block_map_index = index;
-
+  FastLookupEntry(addr, msr) = block;
   return block;
 }
 
-size_t JitBaseBlockCache::FastLookupIndexForAddress(u32 address)
+JitBlock*& JitBaseBlockCache::FastLookupEntry(u32 address, u32 msr_bits)
 {
-  return (address >> 2) & FAST_BLOCK_MAP_MASK;
+  const u32 directory_index = FastLookupDirectoryIndex(address, msr_bits);
+  JitBlock**& page = fast_block_map[directory_index];
+  if (page == fast_block_map_empty_page->data())
+  {
+    auto new_page = std::make_unique<FastBlockMapPage>();
+    page = new_page->data();
+    fast_block_map_pages.emplace_back(directory_index, std::move(new_page));
+  }
+
+  return page[FastLookupPageIndex(address)];
 }
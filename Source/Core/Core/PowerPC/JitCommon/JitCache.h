@@ -13,6 +13,7 @@
 #include <type_traits>
 #include <unordered_map>
 #include <unordered_set>
+#include <utility>
 #include <vector>
 
 #include "Common/CommonTypes.h"
@@ -50,9 +51,6 @@ struct JitBlockData
   // The number of PPC instructions represented by this block. Mostly
   // useful for logging.
   u32 originalSize;
-  // This tracks the position if this block within the fast block cache.
-  // We allow each block to have only one map entry.
-  size_t fast_block_map_index;
 };
 static_assert(std::is_standard_layout_v<JitBlockData>, "JitBlockData must have a standard layout");
 
@@ -94,8 +92,32 @@ struct JitBlock : public JitBlockData
 
 typedef void (*CompiledCode)();
 
+// Counters describing why and how often compiled code was thrown away.
+struct JitInvalidationStats
+{
+  // Single cache line invalidations (icbi, dcbf, dcbi, dcbst).
+  u64 cache_line_requests = 0;
+  // Invalidations of larger ranges that were actually modified (e.g. dcb* loops).
+  u64 range_requests = 0;
+  // Invalidations of unmodified code (breakpoints, patches, exception checks).
+  u64 forced_requests = 0;
+  // Cache line invalidations skipped because no block covered the line.
+  u64 skipped_requests = 0;
+  // Blocks destroyed by any of the above.
+  u64 destroyed_blocks = 0;
+  // Number of times the whole block cache was cleared.
+  u64 cache_clears = 0;
+  // Physical pages whose code has been rewritten at least SMC_PAGE_THRESHOLD times.
+  u64 self_modifying_pages = 0;
+};
+
 // This is essentially just an std::bitset, but Visual Studia 2013's
 // implementation of std::bitset is slow.
+//
+// The bitset spans the whole 32-bit physical address space, but the backing
+// pages are only committed by the host once a bit in them has been set. A
+// coarse dirty map keeps ClearAll() from touching (and thereby committing)
+// pages which never held any bits.
 class ValidBlockBitSet final
 {
 public:
@@ -103,25 +125,33 @@ public:
   {
     // ValidBlockBitSet covers the whole 32-bit address-space in 32-byte
     // chunks.
-    // FIXME: Maybe we can get away with less? There isn't any actual
-    // RAM in most of this space.
     VALID_BLOCK_MASK_SIZE = (1ULL << 32) / 32,
     // The number of elements in the allocated array. Each u32 contains 32 bits.
-    VALID_BLOCK_ALLOC_ELEMENTS = VALID_BLOCK_MASK_SIZE / 32
+    VALID_BLOCK_ALLOC_ELEMENTS = VALID_BLOCK_MASK_SIZE / 32,
+    // The number of elements covered by a single bit of the dirty map (one 4 KiB host page).
+    VALID_BLOCK_DIRTY_GRANULE = 0x1000 / sizeof(u32),
+    VALID_BLOCK_DIRTY_ELEMENTS = VALID_BLOCK_ALLOC_ELEMENTS / VALID_BLOCK_DIRTY_GRANULE,
   };
   // Directly accessed by Jit64.
-  std::unique_ptr<u32[]> m_valid_block;
+  u32* m_valid_block;
 
-  ValidBlockBitSet()
+  ValidBlockBitSet();
+  ~ValidBlockBitSet();
+
+  ValidBlockBitSet(const ValidBlockBitSet&) = delete;
+  ValidBlockBitSet& operator=(const ValidBlockBitSet&) = delete;
+
+  void Set(u32 bit)
   {
-    m_valid_block.reset(new u32[VALID_BLOCK_ALLOC_ELEMENTS]);
-    ClearAll();
+    m_valid_block[bit / 32] |= 1u << (bit % 32);
+    m_dirty[bit / 32 / VALID_BLOCK_DIRTY_GRANULE] = true;
   }
-
-  void Set(u32 bit) { m_valid_block[bit / 32] |= 1u << (bit % 32); }
   void Clear(u32 bit) { m_valid_block[bit / 32] &= ~(1u << (bit % 32)); }
-  void ClearAll() { memset(m_valid_block.get(), 0, sizeof(u32) * VALID_BLOCK_ALLOC_ELEMENTS); }
+  void ClearAll();
   bool Test(u32 bit) const { return (m_valid_block[bit / 32] & (1u << (bit % 32))) != 0; }
+
+private:
+  std::bitset<VALID_BLOCK_DIRTY_ELEMENTS> m_dirty;
 };
 
 class JitBaseBlockCache
@@ -131,8 +161,32 @@ public:
   // is valid (MSR.IR and MSR.DR, the address translation bits).
   static constexpr u32 JIT_CACHE_MSR_MASK = 0x30;
 
-  static constexpr u32 FAST_BLOCK_MAP_ELEMENTS = 0x10000;
-  static constexpr u32 FAST_BLOCK_MAP_MASK = FAST_BLOCK_MAP_ELEMENTS - 1;
+  // The fast block map is a sparse two-level table. The directory is indexed by the
+  // MSR translation bits and the upper bits of the effective address, and each
+  // directory entry points to a page holding one block pointer per instruction:
+  //
+  //   fast_block_map[(msr_bits << FAST_BLOCK_MAP_MSR_SHIFT) | (address >> PAGE_SHIFT)]
+  //                 [(address & FAST_BLOCK_MAP_PAGE_MASK) >> 2]
+  //
+  // Unused directory entries point to a shared page which only holds nullptrs,
+  // so the assembly dispatchers can look up a block with two dependent loads.
+  // Since every (address, msr) pair has its own slot, there are no collisions.
+  static constexpr u32 FAST_BLOCK_MAP_PAGE_SHIFT = 16;
+  static constexpr u32 FAST_BLOCK_MAP_PAGE_MASK = (1u << FAST_BLOCK_MAP_PAGE_SHIFT) - 1;
+  static constexpr u32 FAST_BLOCK_MAP_PAGE_ELEMENTS = 1u << (FAST_BLOCK_MAP_PAGE_SHIFT - 2);
+  static constexpr u32 FAST_BLOCK_MAP_MSR_SHIFT = 32 - FAST_BLOCK_MAP_PAGE_SHIFT - 4;
+  static constexpr u32 FAST_BLOCK_MAP_DIRECTORY_ELEMENTS =
+      (JIT_CACHE_MSR_MASK << FAST_BLOCK_MAP_MSR_SHIFT) + (1u << (32 - FAST_BLOCK_MAP_PAGE_SHIFT));
+  static_assert(JIT_CACHE_MSR_MASK == 0x30, "FAST_BLOCK_MAP_MSR_SHIFT assumes MSR bits 4 and 5");
+
+  static constexpr u32 FastLookupDirectoryIndex(u32 address, u32 msr_bits)
+  {
+    return (msr_bits << FAST_BLOCK_MAP_MSR_SHIFT) | (address >> FAST_BLOCK_MAP_PAGE_SHIFT);
+  }
+  static constexpr u32 FastLookupPageIndex(u32 address)
+  {
+    return (address & FAST_BLOCK_MAP_PAGE_MASK) >> 2;
+  }
 
   explicit JitBaseBlockCache(JitBase& jit);
   virtual ~JitBaseBlockCache();
@@ -143,14 +197,14 @@ public:
   void Reset();
 
   // Code Cache
-  JitBlock** GetFastBlockMap();
+  JitBlock* const* const* GetFastBlockMap() const;
   void RunOnBlocks(std::function<void(const JitBlock&)> f);
 
   JitBlock* AllocateBlock(u32 em_address);
   void FinalizeBlock(JitBlock& block, bool block_link, const std::set<u32>& physical_addresses);
 
   // Look for the block in the slow but accurate way.
-  // This function shall be used if FastLookupIndexForAddress() failed.
+  // This function shall be used if the fast block map lookup failed.
   // This might return nullptr if there is no such block.
   JitBlock* GetBlockFromStartAddress(u32 em_address, u32 msr);
 
@@ -162,10 +216,13 @@ public:
 
   void InvalidateICache(u32 address, u32 length, bool forced);
   void InvalidateICacheLine(u32 address);
-  void ErasePhysicalRange(u32 address, u32 length);
+  // Returns the number of destroyed blocks.
+  u32 ErasePhysicalRange(u32 address, u32 length);
 
   u32* GetBlockBitSet() const;
 
+  const JitInvalidationStats& GetInvalidationStats() const { return m_invalidation_stats; }
+
 protected:
   virtual void DestroyBlock(JitBlock& block);
 
@@ -179,11 +236,13 @@ private:
   void LinkBlock(JitBlock& block);
   void UnlinkBlock(const JitBlock& block);
   void InvalidateICacheInternal(u32 physical_address, u32 address, u32 length, bool forced);
+  void CountPageRewrites(u32 physical_address, u32 length);
+  void LogInvalidationStats() const;
 
   JitBlock* MoveBlockIntoFastCache(u32 em_address, u32 msr);
 
-  // Fast but risky block lookup based on fast_block_map.
-  size_t FastLookupIndexForAddress(u32 address);
+  // Returns the fast block map slot for the given address, allocating its page if needed.
+  JitBlock*& FastLookupEntry(u32 address, u32 msr_bits);
 
   // links_to hold all exit points of all valid blocks in a reverse way.
   // It is used to query all blocks which links to an address.
@@ -199,11 +258,22 @@ private:
   static constexpr u32 BLOCK_RANGE_MAP_ELEMENTS = 0x100;
   std::map<u32, std::unordered_set<JitBlock*>> block_range_map;
 
+  // Number of times modified code was invalidated on each physical page, indexed by the
+  // physical page number. This only feeds the statistics: pages which keep getting rewritten
+  // are reported as self-modifying.
+  static constexpr u32 SMC_PAGE_THRESHOLD = 16;
+  std::unordered_map<u32, u32> page_rewrite_counts;
+
+  JitInvalidationStats m_invalidation_stats;
+
   // This bitsets shows which cachelines overlap with any blocks.
   // It is used to provide a fast way to query if no icache invalidation is needed.
   ValidBlockBitSet valid_block;
 
-  // This array is indexed with the masked PC and likely holds the correct block id.
+  // Two-level table indexed by the PC and MSR bits, see FAST_BLOCK_MAP_PAGE_SHIFT.
   // This is used as a fast cache of block_map used in the assembly dispatcher.
-  std::array<JitBlock*, FAST_BLOCK_MAP_ELEMENTS> fast_block_map{};  // start_addr & mask -> number
+  using FastBlockMapPage = std::array<JitBlock*, FAST_BLOCK_MAP_PAGE_ELEMENTS>;
+  std::unique_ptr<JitBlock**[]> fast_block_map;  // directory index -> page
+  std::unique_ptr<FastBlockMapPage> fast_block_map_empty_page;
+  std::vector<std::pair<u32, std::unique_ptr<FastBlockMapPage>>> fast_block_map_pages;
 };
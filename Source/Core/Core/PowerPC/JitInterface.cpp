@@ -146,6 +146,15 @@ void GetProfileResults(Profiler::ProfileStats* prof_stats)
   });
 }
 
+void GetInvalidationStats(JitInvalidationStats* stats)
+{
+  *stats = {};
+  if (!g_jit)
+    return;
+
+  Core::RunAsCPUThread([stats] { *stats = g_jit->GetBlockCache()->GetInvalidationStats(); });
+}
+
 int GetHostCode(u32* address, const u8** code, u32* code_size)
 {
   if (!g_jit)
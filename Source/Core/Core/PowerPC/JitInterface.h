@@ -11,6 +11,7 @@
 class CPUCoreBase;
 class PointerWrap;
 class JitBase;
+struct JitInvalidationStats;
 
 namespace PowerPC
 {
@@ -46,6 +47,7 @@ enum class ProfilingState
 void SetProfilingState(ProfilingState state);
 void WriteProfileResults(const std::string& filename);
 void GetProfileResults(Profiler::ProfileStats* prof_stats);
+void GetInvalidationStats(JitInvalidationStats* stats);
 int GetHostCode(u32* address, const u8** code, u32* code_size);
 
 // Memory Utilities
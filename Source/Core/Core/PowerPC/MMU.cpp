@@ -5,6 +5,7 @@
 
 #include <cstddef>
 #include <cstring>
+#include <optional>
 #include <string>
 
 #include "Common/Assert.h"
@@ -1047,7 +1048,7 @@ void ClearCacheLine(u32 address)
     WriteToHardware<XCheckTLBFlag::Write, true>(address + i, 0, 4);
 }
 
-u32 IsOptimizableMMIOAccess(u32 address, u32 access_size)
+u32 IsOptimizableMMIOAccess(u32 address, u32 access_size, bool is_write)
 {
   if (PowerPC::memchecks.HasAny())
     return 0;
@@ -1064,7 +1065,7 @@ u32 IsOptimizableMMIOAccess(u32 address, u32 access_size)
 
   // Check whether the address is an aligned address of an MMIO register.
   const bool aligned = (address & ((access_size >> 3) - 1)) == 0;
-  if (!aligned || !MMIO::IsMMIOAddress(address))
+  if (!aligned || !MMIO::IsMMIOAddress(address, is_write))
     return 0;
 
   return address;
@@ -1183,6 +1184,8 @@ void SDRUpdated()
 
   ppcState.pagetable_base = htaborg << 16;
   ppcState.pagetable_hashmask = ((htabmask << 10) | 0x3ff);
+
+  Memory::ClearPageTableMappings();
 }
 
 enum class TLBLookupResult
@@ -1267,6 +1270,7 @@ void InvalidateTLBEntry(u32 address)
 
   ppcState.tlb[0][entry_index].Invalidate();
   ppcState.tlb[1][entry_index].Invalidate();
+  Memory::RemovePageTableMappings(entry_index);
 }
 
 union EffectiveAddress
@@ -1282,6 +1286,41 @@ union EffectiveAddress
   explicit EffectiveAddress(u32 address) : Hex{address} {}
 };
 
+// Returns the address of the second word of the page table entry that maps the given address.
+static std::optional<u32> LookupPageTableEntry(const EffectiveAddress address, const u32 VSID)
+{
+  const u32 page_index = address.page_index;  // 16 bit
+  const u32 api = address.API;                //  6 bit (part of page_index)
+
+  // hash function no 1 "xor" .360
+  u32 hash = (VSID ^ page_index);
+
+  UPTE_Lo pte1;
+  pte1.VSID = VSID;
+  pte1.API = api;
+  pte1.V = 1;
+
+  for (int hash_func = 0; hash_func < 2; hash_func++)
+  {
+    // hash function no 2 "not" .360
+    if (hash_func == 1)
+    {
+      hash = ~hash;
+      pte1.H = 1;
+    }
+
+    u32 pteg_addr =
+        ((hash & PowerPC::ppcState.pagetable_hashmask) << 6) | PowerPC::ppcState.pagetable_base;
+
+    for (int i = 0; i < 8; i++, pteg_addr += 8)
+    {
+      if (pte1.Hex == Memory::Read_U32(pteg_addr))
+        return pteg_addr + 4;
+    }
+  }
+  return std::nullopt;
+}
+
 // Page Address Translation
 static TranslateAddressResult TranslatePageAddress(const EffectiveAddress address,
                                                    const XCheckTLBFlag flag, bool* wi)
@@ -1310,74 +1349,94 @@ static TranslateAddressResult TranslatePageAddress(const EffectiveAddress addres
     return TranslateAddressResult{TranslateAddressResultEnum::PAGE_FAULT, 0};
   }
 
-  const u32 offset = address.offset;          // 12 bit
-  const u32 page_index = address.page_index;  // 16 bit
-  const u32 VSID = sr.VSID;                   // 24 bit
-  const u32 api = address.API;                //  6 bit (part of page_index)
-
-  // hash function no 1 "xor" .360
-  u32 hash = (VSID ^ page_index);
+  const std::optional<u32> pte2_addr = LookupPageTableEntry(address, sr.VSID);
+  if (!pte2_addr)
+    return TranslateAddressResult{TranslateAddressResultEnum::PAGE_FAULT, 0};
 
-  UPTE_Lo pte1;
-  pte1.VSID = VSID;
-  pte1.API = api;
-  pte1.V = 1;
+  UPTE_Hi pte2(Memory::Read_U32(*pte2_addr));
 
-  for (int hash_func = 0; hash_func < 2; hash_func++)
+  // set the access bits
+  switch (flag)
   {
-    // hash function no 2 "not" .360
-    if (hash_func == 1)
-    {
-      hash = ~hash;
-      pte1.H = 1;
-    }
+  case XCheckTLBFlag::NoException:
+  case XCheckTLBFlag::OpcodeNoException:
+    break;
+  case XCheckTLBFlag::Read:
+    pte2.R = 1;
+    break;
+  case XCheckTLBFlag::Write:
+    pte2.R = 1;
+    pte2.C = 1;
+    break;
+  case XCheckTLBFlag::Opcode:
+    pte2.R = 1;
+    break;
+  }
 
-    u32 pteg_addr =
-        ((hash & PowerPC::ppcState.pagetable_hashmask) << 6) | PowerPC::ppcState.pagetable_base;
+  if (!IsNoExceptionFlag(flag))
+  {
+    Memory::Write_U32(pte2.Hex, *pte2_addr);
+  }
 
-    for (int i = 0; i < 8; i++, pteg_addr += 8)
-    {
-      const u32 pteg = Memory::Read_U32(pteg_addr);
+  // We already updated the TLB entry if this was caused by a C bit.
+  if (res != TLBLookupResult::UpdateC)
+    UpdateTLBEntry(flag, pte2, address.Hex);
 
-      if (pte1.Hex == pteg)
-      {
-        UPTE_Hi pte2(Memory::Read_U32(pteg_addr + 4));
+  *wi = (pte2.WIMG & 0b1100) != 0;
 
-        // set the access bits
-        switch (flag)
-        {
-        case XCheckTLBFlag::NoException:
-        case XCheckTLBFlag::OpcodeNoException:
-          break;
-        case XCheckTLBFlag::Read:
-          pte2.R = 1;
-          break;
-        case XCheckTLBFlag::Write:
-          pte2.R = 1;
-          pte2.C = 1;
-          break;
-        case XCheckTLBFlag::Opcode:
-          pte2.R = 1;
-          break;
-        }
+  return TranslateAddressResult{TranslateAddressResultEnum::PAGE_TABLE_TRANSLATED,
+                                (pte2.RPN << 12) | address.offset};
+}
 
-        if (!IsNoExceptionFlag(flag))
-        {
-          Memory::Write_U32(pte2.Hex, pteg_addr + 4);
-        }
+bool AddPageTableFastmemMapping(u32 address)
+{
+  // BATs take priority over the page table. If a BAT covers this address and it still faulted,
+  // it isn't plain RAM.
+  if (dbat_table[address >> BAT_INDEX_SHIFT] & BAT_MAPPED_BIT)
+    return false;
 
-        // We already updated the TLB entry if this was caused by a C bit.
-        if (res != TLBLookupResult::UpdateC)
-          UpdateTLBEntry(flag, pte2, address.Hex);
+  const EffectiveAddress page{address & ~static_cast<u32>(HW_PAGE_MASK)};
+  if (PowerPC::memchecks.OverlapsMemcheck(page.Hex, HW_PAGE_SIZE))
+    return false;
 
-        *wi = (pte2.WIMG & 0b1100) != 0;
+  const auto sr = UReg_SR{ppcState.sr[page.SR]};
+  if (sr.T != 0)
+    return false;
 
-        return TranslateAddressResult{TranslateAddressResultEnum::PAGE_TABLE_TRANSLATED,
-                                      (pte2.RPN << 12) | offset};
-      }
-    }
+  // Prefer what the data TLB has cached, so that fastmem agrees with the slow path until the
+  // entry is invalidated.
+  UPTE_Hi pte2;
+  const u32 tag = page.Hex >> HW_PAGE_INDEX_SHIFT;
+  const TLBEntry& tlbe = ppcState.tlb[0][tag & HW_PAGE_INDEX_MASK];
+  if (tlbe.tag[0] == tag)
+  {
+    pte2.Hex = tlbe.pte[0];
+  }
+  else if (tlbe.tag[1] == tag)
+  {
+    pte2.Hex = tlbe.pte[1];
+  }
+  else
+  {
+    const std::optional<u32> pte2_addr = LookupPageTableEntry(page, sr.VSID);
+    if (!pte2_addr)
+      return false;
+    pte2.Hex = Memory::Read_U32(*pte2_addr);
   }
-  return TranslateAddressResult{TranslateAddressResultEnum::PAGE_FAULT, 0};
+
+  // Accesses through fastmem can't set the R and C bits, so only map pages that already have
+  // both set. Uncached memory is left to the slow path, like for BATs.
+  if (pte2.R == 0 || pte2.C == 0 || (pte2.WIMG & 0b1100) != 0)
+    return false;
+
+  const u32 physical_address = pte2.RPN << HW_PAGE_INDEX_SHIFT;
+  const bool is_ram = physical_address < Memory::GetRamSizeReal();
+  const bool is_exram = Memory::m_pEXRAM && physical_address >> 28 == 0x1 &&
+                        (physical_address & 0x0FFFFFFF) < Memory::GetExRamSizeReal();
+  if (!is_ram && !is_exram)
+    return false;
+
+  return Memory::AddPageTableMapping(page.Hex, physical_address);
 }
 
 static void UpdateBATs(BatTable& bat_table, u32 base_spr)
@@ -176,7 +176,7 @@ void IBATUpdated();
 // it's safe to optimize a read or write to this address to an unguarded
 // memory access.  Does not consider page tables.
 bool IsOptimizableRAMAddress(u32 address);
-u32 IsOptimizableMMIOAccess(u32 address, u32 access_size);
+u32 IsOptimizableMMIOAccess(u32 address, u32 access_size, bool is_write);
 bool IsOptimizableGatherPipeWrite(u32 address);
 
 struct TranslateResult
@@ -220,4 +220,9 @@ constexpr u32 HW_PAGE_INDEX_SHIFT = 12;
 constexpr u32 HW_PAGE_INDEX_MASK = 0x3f;
 
 std::optional<u32> GetTranslatedAddress(u32 address);
+
+// Called when a fastmem access to the given effective address faulted. Maps the page into the
+// logical fastmem region if it is translated through the page table to RAM, and returns whether
+// the access can be retried.
+bool AddPageTableFastmemMapping(u32 address);
 }  // namespace PowerPC
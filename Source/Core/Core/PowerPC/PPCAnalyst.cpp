@@ -678,54 +678,120 @@ void PPCAnalyzer::SetInstructionStats(CodeBlock* block, CodeOp* code, const Gekk
   }
 }
 
+// State that an instruction in a busy wait loop reads or writes.
+struct BusyWaitLoopState
+{
+  BitSet32 gprs;
+  BitSet8 cr_fields;
+  bool ca = false;
+};
+
+// Returns false if the instruction can't be part of a busy wait loop.
+static bool GetBusyWaitLoopState(const CodeOp& op, BusyWaitLoopState* in, BusyWaitLoopState* out)
+{
+  const UGeckoInstruction inst = op.inst;
+  const u64 flags = op.opinfo->flags;
+
+  switch (op.opinfo->type)
+  {
+  case OpType::Branch:
+    if (op.branchUsesCtr)
+      return false;
+    // b has no condition; bc, bclr and bcctr share the BO and BI fields.
+    if (inst.OPCD != 18 && (inst.BO & BO_DONT_CHECK_CONDITION) == 0)
+      in->cr_fields[inst.BI >> 2] = true;
+    return true;
+
+  case OpType::CR:
+    // The condition register logical instructions only update one bit of the destination field,
+    // so they also depend on its previous value.
+    in->cr_fields[inst.CRBA >> 2] = true;
+    in->cr_fields[inst.CRBB >> 2] = true;
+    in->cr_fields[inst.CRBD >> 2] = true;
+    out->cr_fields[inst.CRBD >> 2] = true;
+    return true;
+
+  case OpType::System:
+  case OpType::SPR:
+    if (inst.OPCD == 19 && inst.SUBOP10 == 0)  // mcrf
+    {
+      in->cr_fields[inst.CRFS] = true;
+      out->cr_fields[inst.CRFD] = true;
+      return true;
+    }
+    if (inst.OPCD == 31 && inst.SUBOP10 == 19)  // mfcr
+    {
+      in->cr_fields = BitSet8(0xFF);
+      out->gprs = op.regsOut;
+      return true;
+    }
+    // Nothing else, in particular no time base reads. Idling skips ahead to the next scheduled
+    // event, which can be far past the deadline a time base polling loop is waiting for.
+    return false;
+
+  case OpType::Integer:
+  case OpType::Load:
+    // Loads from both RAM and MMIO are fine: their results can only change when something outside
+    // of the loop (another scheduled event, the GPU or the DSP) changes the underlying state.
+    in->gprs = op.regsIn;
+    out->gprs = op.regsOut;
+    in->ca = (flags & FL_READ_CA) != 0;
+    out->ca = (flags & FL_SET_CA) != 0;
+    if (op.outputCR0)
+      out->cr_fields[0] = true;
+    if ((flags & FL_SET_CRn) != 0)
+      out->cr_fields[inst.CRFD] = true;
+    return true;
+
+  default:
+    // In the future, some subsets of other instruction types might get
+    // supported. Right now, only try loops that have this very
+    // restricted instruction set.
+    return false;
+  }
+}
+
 bool PPCAnalyzer::IsBusyWaitLoop(CodeBlock* block, CodeOp* code, size_t instructions) const
 {
   // Very basic algorithm to detect busy wait loops:
-  //   * It loops to itself and does not contain any other branches.
+  //   * It loops to itself. Other branches are allowed as long as they don't
+  //     use CTR, since they can only exit the loop.
   //   * It does not write to memory.
-  //   * It only reads from registers it wrote to earlier in the loop, or it
-  //     does not write to these registers.
+  //   * It only reads registers, CR fields and the carry flag it wrote to
+  //     earlier in the loop, or it does not write to them. This ensures that
+  //     every iteration does the same thing until memory or MMIO changes,
+  //     which can only happen once the next event runs.
   //
-  // Would benefit a lot from basic inlining support - a lot of the most
-  // used busy loops are DSP register interactions, which are bl/cmp/bne
-  // (with the bl target a pure function that follows the above rules). We
-  // don't detect these at the moment.
-  std::bitset<32> write_disallowed_regs;
-  std::bitset<32> written_regs;
+  // This covers games polling VI, DSP, SI or EXI registers as well as flags in
+  // RAM. Calls to pure leaf functions (e.g. bl/cmp/bne loops around a DSP
+  // register accessor) are only detected when branch following inlines them.
+  BusyWaitLoopState write_disallowed;
+  BusyWaitLoopState written;
   for (size_t i = 0; i <= instructions; ++i)
   {
-    if (code[i].opinfo->type == OpType::Branch)
-    {
-      if (code[i].branchUsesCtr)
-        return false;
-      if (code[i].branchTo == block->m_address && i == instructions)
-        return true;
-    }
-    else if (code[i].opinfo->type != OpType::Integer && code[i].opinfo->type != OpType::Load)
+    BusyWaitLoopState in;
+    BusyWaitLoopState out;
+    if (!GetBusyWaitLoopState(code[i], &in, &out))
+      return false;
+
+    write_disallowed.gprs |= in.gprs & ~written.gprs;
+    write_disallowed.cr_fields |= in.cr_fields & ~written.cr_fields;
+    write_disallowed.ca |= in.ca && !written.ca;
+
+    if ((out.gprs & write_disallowed.gprs) || (out.cr_fields & write_disallowed.cr_fields) ||
+        (out.ca && write_disallowed.ca))
     {
-      // In the future, some subsets of other instruction types might get
-      // supported. Right now, only try loops that have this very
-      // restricted instruction set.
       return false;
     }
-    else
+
+    written.gprs |= out.gprs;
+    written.cr_fields |= out.cr_fields;
+    written.ca |= out.ca;
+
+    if (code[i].opinfo->type == OpType::Branch && code[i].branchTo == block->m_address &&
+        i == instructions)
     {
-      for (int reg : code[i].regsIn)
-      {
-        if (reg == -1)
-          continue;
-        if (written_regs[reg])
-          continue;
-        write_disallowed_regs[reg] = true;
-      }
-      for (int reg : code[i].regsOut)
-      {
-        if (reg == -1)
-          continue;
-        if (write_disallowed_regs[reg])
-          return false;
-        written_regs[reg] = true;
-      }
+      return true;
     }
   }
   return false;
@@ -6,6 +6,7 @@
 #include <array>
 
 #include "Common/ChunkFile.h"
+#include "Common/Logging/LogManager.h"
 #include "Common/Swap.h"
 #include "Core/Config/MainSettings.h"
 #include "Core/DolphinAnalytics.h"
@@ -100,6 +101,8 @@ void InstructionCache::Reset()
   lookup_table.fill(0xFF);
   lookup_table_ex.fill(0xFF);
   lookup_table_vmem.fill(0xFF);
+  m_last_line = INVALID_LINE;
+  m_reported_stale_read = false;
   JitInterface::ClearSafe();
 }
 
@@ -134,70 +137,93 @@ void InstructionCache::Invalidate(u32 addr)
     }
   }
   valid[set] = 0;
+  if (m_last_set == set)
+    m_last_line = INVALID_LINE;
   JitInterface::InvalidateICacheLine(addr);
 }
 
+u8 InstructionCache::LookupWay(u32 addr) const
+{
+  if (addr & ICACHE_VMEM_BIT)
+    return lookup_table_vmem[(addr >> 5) & 0xfffff];
+  if (addr & ICACHE_EXRAM_BIT)
+    return lookup_table_ex[(addr >> 5) & 0x1fffff];
+  return lookup_table[(addr >> 5) & 0xfffff];
+}
+
 u32 InstructionCache::ReadInstruction(u32 addr)
 {
   if (!HID0.ICE || m_disable_icache)  // instruction cache is disabled
     return Memory::Read_U32(addr);
-  u32 set = (addr >> 5) & 0x7f;
-  u32 tag = addr >> 12;
 
+  u32 set;
   u32 t;
-  if (addr & ICACHE_VMEM_BIT)
+  if ((addr >> 5) == m_last_line)
   {
-    t = lookup_table_vmem[(addr >> 5) & 0xfffff];
-  }
-  else if (addr & ICACHE_EXRAM_BIT)
-  {
-    t = lookup_table_ex[(addr >> 5) & 0x1fffff];
+    // Same line as the previous fetch. The line can't have been evicted in between, and the PLRU
+    // bits already point away from this way, so there is nothing to update.
+    set = m_last_set;
+    t = m_last_way;
   }
   else
   {
-    t = lookup_table[(addr >> 5) & 0xfffff];
-  }
+    set = (addr >> 5) & 0x7f;
+    t = LookupWay(addr);
 
-  if (t == 0xff)  // load to the cache
-  {
-    if (HID0.ILOCK)  // instruction cache is locked
-      return Memory::Read_U32(addr);
-    // select a way
-    if (valid[set] != 0xff)
-      t = s_way_from_valid[valid[set]];
-    else
-      t = s_way_from_plru[plru[set]];
-    // load
-    Memory::CopyFromEmu(reinterpret_cast<u8*>(data[set][t].data()), (addr & ~0x1f), 32);
-    if (valid[set] & (1 << t))
+    if (t == 0xff)  // load to the cache
     {
-      if (tags[set][t] & (ICACHE_VMEM_BIT >> 12))
-        lookup_table_vmem[((tags[set][t] << 7) | set) & 0xfffff] = 0xff;
-      else if (tags[set][t] & (ICACHE_EXRAM_BIT >> 12))
-        lookup_table_ex[((tags[set][t] << 7) | set) & 0x1fffff] = 0xff;
+      if (HID0.ILOCK)  // instruction cache is locked
+        return Memory::Read_U32(addr);
+      // select a way
+      if (valid[set] != 0xff)
+        t = s_way_from_valid[valid[set]];
       else
-        lookup_table[((tags[set][t] << 7) | set) & 0xfffff] = 0xff;
+        t = s_way_from_plru[plru[set]];
+      // load
+      Memory::CopyFromEmu(reinterpret_cast<u8*>(data[set][t].data()), (addr & ~0x1f), 32);
+      if (valid[set] & (1 << t))
+      {
+        if (tags[set][t] & (ICACHE_VMEM_BIT >> 12))
+          lookup_table_vmem[((tags[set][t] << 7) | set) & 0xfffff] = 0xff;
+        else if (tags[set][t] & (ICACHE_EXRAM_BIT >> 12))
+          lookup_table_ex[((tags[set][t] << 7) | set) & 0x1fffff] = 0xff;
+        else
+          lookup_table[((tags[set][t] << 7) | set) & 0xfffff] = 0xff;
+      }
+
+      if (addr & ICACHE_VMEM_BIT)
+        lookup_table_vmem[(addr >> 5) & 0xfffff] = t;
+      else if (addr & ICACHE_EXRAM_BIT)
+        lookup_table_ex[(addr >> 5) & 0x1fffff] = t;
+      else
+        lookup_table[(addr >> 5) & 0xfffff] = t;
+      tags[set][t] = addr >> 12;
+      valid[set] |= (1 << t);
     }
+    // update plru
+    plru[set] = (plru[set] & ~s_plru_mask[t]) | s_plru_value[t];
 
-    if (addr & ICACHE_VMEM_BIT)
-      lookup_table_vmem[(addr >> 5) & 0xfffff] = t;
-    else if (addr & ICACHE_EXRAM_BIT)
-      lookup_table_ex[(addr >> 5) & 0x1fffff] = t;
-    else
-      lookup_table[(addr >> 5) & 0xfffff] = t;
-    tags[set][t] = tag;
-    valid[set] |= (1 << t);
+    m_last_line = addr >> 5;
+    m_last_set = set;
+    m_last_way = t;
   }
-  // update plru
-  plru[set] = (plru[set] & ~s_plru_mask[t]) | s_plru_value[t];
+
   const u32 res = Common::swap32(data[set][t][(addr >> 2) & 7]);
-  const u32 inmem = Memory::Read_U32(addr);
-  if (res != inmem)
+
+  // Comparing against RAM costs a second, translated memory read for every fetch, so skip it once
+  // there is nobody left to tell about a mismatch.
+  if (!m_reported_stale_read || Common::Log::LogManager::GetInstance()->IsEnabled(
+                                    Common::Log::LogType::POWERPC, Common::Log::LogLevel::LINFO))
   {
-    INFO_LOG_FMT(POWERPC,
-                 "ICache read at {:08x} returned stale data: CACHED: {:08x} vs. RAM: {:08x}", addr,
-                 res, inmem);
-    DolphinAnalytics::Instance().ReportGameQuirk(GameQuirk::ICACHE_MATTERS);
+    const u32 inmem = Memory::Read_U32(addr);
+    if (res != inmem)
+    {
+      INFO_LOG_FMT(POWERPC,
+                   "ICache read at {:08x} returned stale data: CACHED: {:08x} vs. RAM: {:08x}",
+                   addr, res, inmem);
+      DolphinAnalytics::Instance().ReportGameQuirk(GameQuirk::ICACHE_MATTERS);
+      m_reported_stale_read = true;
+    }
   }
   return res;
 }
@@ -211,6 +237,9 @@ void InstructionCache::DoState(PointerWrap& p)
   p.DoArray(lookup_table);
   p.DoArray(lookup_table_ex);
   p.DoArray(lookup_table_vmem);
+
+  if (p.IsReadMode())
+    m_last_line = INVALID_LINE;
 }
 
 void InstructionCache::RefreshConfig()
@@ -22,6 +22,8 @@ constexpr u32 ICACHE_VMEM_BIT = 0x20000000;
 
 struct InstructionCache
 {
+  static constexpr u32 INVALID_LINE = 0xFFFFFFFF;
+
   std::array<std::array<std::array<u32, ICACHE_BLOCK_SIZE>, ICACHE_WAYS>, ICACHE_SETS> data{};
   std::array<std::array<u32, ICACHE_WAYS>, ICACHE_SETS> tags{};
   std::array<u32, ICACHE_SETS> plru{};
@@ -31,6 +33,14 @@ struct InstructionCache
   std::array<u8, 1 << 21> lookup_table_ex{};
   std::array<u8, 1 << 20> lookup_table_vmem{};
 
+  // The line the last fetch hit, so that fetching the rest of a line skips the lookup tables.
+  // Identified by (addr >> 5), which keeps the EXRAM and VMEM bits. Not part of the savestate.
+  u32 m_last_line = INVALID_LINE;
+  u32 m_last_set = 0;
+  u32 m_last_way = 0;
+  // Once a stale read has been reported, RAM is only compared against while logging it.
+  bool m_reported_stale_read = false;
+
   bool m_disable_icache = false;
   std::optional<size_t> m_config_callback_id = std::nullopt;
 
@@ -42,5 +52,8 @@ struct InstructionCache
   void Reset();
   void DoState(PointerWrap& p);
   void RefreshConfig();
+
+private:
+  u8 LookupWay(u32 addr) const;
 };
 }  // namespace PowerPC
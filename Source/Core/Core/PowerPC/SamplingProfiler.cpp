@@ -0,0 +1,354 @@
+// Copyright 2022 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "Core/PowerPC/SamplingProfiler.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include "Common/CommonTypes.h"
+#include "Common/Event.h"
+#include "Common/IOFile.h"
+#include "Common/Logging/Log.h"
+#include "Common/SymbolDB.h"
+#include "Common/Thread.h"
+#include "Core/Core.h"
+#include "Core/HW/CPU.h"
+#include "Core/MachineContext.h"
+#include "Core/PowerPC/JitCommon/JitBase.h"
+#include "Core/PowerPC/JitInterface.h"
+#include "Core/PowerPC/PPCSymbolDB.h"
+#include "Core/PowerPC/PowerPC.h"
+
+#if defined(__linux__) && !defined(_M_GENERIC)
+#define SAMPLE_HOST_CONTEXT 1
+#include <pthread.h>
+#include <signal.h>
+#endif
+
+namespace SamplingProfiler
+{
+namespace
+{
+struct Sample
+{
+  u32 pc = 0;
+  u32 lr = 0;
+  // Zero if the host PC couldn't be sampled.
+  u64 host_pc = 0;
+  // Value of s_block_epoch when the sample was taken.
+  u32 epoch = 0;
+
+  bool operator<(const Sample& other) const
+  {
+    return std::tie(pc, lr, host_pc, epoch) <
+           std::tie(other.pc, other.lr, other.host_pc, other.epoch);
+  }
+};
+
+// A sample after its host PC has been resolved to a guest address.
+struct ResolvedSample
+{
+  u32 address = 0;
+  u32 lr = 0;
+  // The host PC was outside of any JIT block, e.g. in the dispatcher or in a slow path.
+  bool in_host_code = false;
+
+  bool operator<(const ResolvedSample& other) const
+  {
+    return std::tie(address, lr, in_host_code) <
+           std::tie(other.address, other.lr, other.in_host_code);
+  }
+};
+
+std::thread s_sampler_thread;
+Common::Event s_stop_event;
+bool s_running = false;
+
+// Samples are collected by the sampler thread, but only the CPU thread can look at the JIT blocks.
+std::mutex s_pending_samples_lock;
+std::map<Sample, u64> s_pending_samples;
+u64 s_dropped_samples = 0;
+
+// Incremented by the CPU thread whenever JIT blocks are about to be destroyed. Samples from an
+// older epoch may point into code that doesn't exist anymore.
+std::atomic<u32> s_block_epoch{0};
+
+// Only touched by the CPU thread.
+std::map<ResolvedSample, u64> s_samples;
+
+#ifdef SAMPLE_HOST_CONTEXT
+constexpr int SAMPLE_SIGNAL = SIGPROF;
+
+pthread_t s_cpu_thread;
+struct sigaction s_old_sigaction;
+
+// Handshake between the sampler thread and the signal handler running on the CPU thread.
+std::atomic<u32> s_requested_sample{0};
+std::atomic<u32> s_completed_sample{0};
+Sample s_signal_sample;
+
+void SampleSignalHandler(int, siginfo_t*, void* raw_context)
+{
+  const SContext* ctx = &static_cast<ucontext_t*>(raw_context)->uc_mcontext;
+#if _M_X86_64
+  s_signal_sample.host_pc = ctx->CTX_RIP;
+#elif _M_ARM_64
+  s_signal_sample.host_pc = ctx->CTX_PC;
+#endif
+  s_signal_sample.pc = PowerPC::ppcState.pc;
+  s_signal_sample.lr = LR;
+  s_signal_sample.epoch = s_block_epoch.load(std::memory_order_relaxed);
+  s_completed_sample.store(s_requested_sample.load(std::memory_order_relaxed),
+                           std::memory_order_release);
+}
+
+bool TakeSample(Sample* sample)
+{
+  // Only one signal is ever in flight, so that the handler can't overwrite s_signal_sample while
+  // it is being read. If the previous one timed out and still hasn't been handled, skip this
+  // sample instead of sending another.
+  const u32 previous_request = s_requested_sample.load(std::memory_order_relaxed);
+  if (s_completed_sample.load(std::memory_order_acquire) != previous_request)
+    return false;
+
+  const u32 request = previous_request + 1;
+  s_requested_sample.store(request, std::memory_order_relaxed);
+  if (pthread_kill(s_cpu_thread, SAMPLE_SIGNAL) != 0)
+  {
+    s_requested_sample.store(previous_request, std::memory_order_relaxed);
+    return false;
+  }
+
+  // The handler only does a handful of loads and stores, so it should complete almost instantly
+  // unless the CPU thread is blocked in the kernel.
+  const auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(10);
+  while (s_completed_sample.load(std::memory_order_acquire) != request)
+  {
+    if (std::chrono::steady_clock::now() > deadline)
+      return false;
+    Common::YieldCPU();
+  }
+
+  *sample = s_signal_sample;
+  return true;
+}
+#else
+bool TakeSample(Sample* sample)
+{
+  // Without a way to interrupt the CPU thread, the best we can do is to read the guest state
+  // while it keeps running. The JITs store the PC at every block exit, so this is still accurate
+  // at the block level.
+  sample->pc = PowerPC::ppcState.pc;
+  sample->lr = LR;
+  sample->host_pc = 0;
+  sample->epoch = s_block_epoch.load(std::memory_order_relaxed);
+  return true;
+}
+#endif
+
+void SamplerThread(u32 interval_us)
+{
+  Common::SetCurrentThreadName("Sampling profiler");
+
+  while (!s_stop_event.WaitFor(std::chrono::microseconds(interval_us)))
+  {
+    if (CPU::GetState() != CPU::State::Running)
+      continue;
+
+    Sample sample;
+    const bool taken = TakeSample(&sample);
+
+    std::lock_guard lk(s_pending_samples_lock);
+    if (taken)
+      ++s_pending_samples[sample];
+    else
+      ++s_dropped_samples;
+  }
+}
+
+struct HostCodeRange
+{
+  const u8* begin;
+  const u8* end;
+  u32 effective_address;
+
+  bool operator<(const HostCodeRange& other) const { return begin < other.begin; }
+};
+
+std::vector<HostCodeRange> GetHostCodeRanges()
+{
+  std::vector<HostCodeRange> ranges;
+  JitBase* jit = static_cast<JitBase*>(JitInterface::GetCore());
+  if (!jit || PowerPC::GetMode() != PowerPC::CoreMode::JIT)
+    return ranges;
+
+  jit->GetBlockCache()->RunOnBlocks([&ranges](const JitBlock& block) {
+    if (block.near_begin != block.near_end)
+      ranges.push_back({block.near_begin, block.near_end, block.effectiveAddress});
+    if (block.far_begin != block.far_end)
+      ranges.push_back({block.far_begin, block.far_end, block.effectiveAddress});
+  });
+  std::sort(ranges.begin(), ranges.end());
+  return ranges;
+}
+
+const HostCodeRange* FindHostCodeRange(const std::vector<HostCodeRange>& ranges, u64 host_pc)
+{
+  const u8* address = reinterpret_cast<const u8*>(host_pc);
+  auto it = std::upper_bound(ranges.begin(), ranges.end(), HostCodeRange{address, address, 0});
+  if (it == ranges.begin())
+    return nullptr;
+  --it;
+  return address < it->end ? &*it : nullptr;
+}
+
+ResolvedSample ResolveSample(const std::vector<HostCodeRange>& ranges, const Sample& sample)
+{
+  ResolvedSample resolved{sample.pc, sample.lr, false};
+  if (sample.host_pc != 0 && !ranges.empty())
+  {
+    const HostCodeRange* range = FindHostCodeRange(ranges, sample.host_pc);
+    if (range)
+      resolved.address = range->effective_address;
+    else
+      resolved.in_host_code = true;
+  }
+  return resolved;
+}
+
+std::string GetFrameName(u32 address)
+{
+  const Common::Symbol* symbol = g_symbolDB.GetSymbolFromAddr(address);
+  if (!symbol)
+    return fmt::format("{:08x}", address);
+
+  // ';' separates frames in the folded format.
+  std::string name = symbol->function_name;
+  std::replace(name.begin(), name.end(), ';', ':');
+  return name;
+}
+}  // Anonymous namespace
+
+void Start(u32 interval_us)
+{
+  if (s_running || interval_us == 0)
+    return;
+
+  s_samples.clear();
+  s_pending_samples.clear();
+  s_dropped_samples = 0;
+
+#ifdef SAMPLE_HOST_CONTEXT
+  s_cpu_thread = pthread_self();
+
+  struct sigaction sa;
+  sa.sa_sigaction = &SampleSignalHandler;
+  sa.sa_flags = SA_SIGINFO | SA_RESTART;
+  sigemptyset(&sa.sa_mask);
+  if (sigaction(SAMPLE_SIGNAL, &sa, &s_old_sigaction) != 0)
+  {
+    ERROR_LOG_FMT(POWERPC, "Sampling profiler: failed to install the signal handler");
+    return;
+  }
+#endif
+
+  INFO_LOG_FMT(POWERPC, "Sampling profiler started with a {} us interval", interval_us);
+  s_stop_event.Reset();
+  s_sampler_thread = std::thread(SamplerThread, interval_us);
+  s_running = true;
+}
+
+void Stop()
+{
+  if (!s_running)
+    return;
+
+  s_stop_event.Set();
+  s_sampler_thread.join();
+  ResolvePendingSamples();
+  s_running = false;
+
+#ifdef SAMPLE_HOST_CONTEXT
+  sigaction(SAMPLE_SIGNAL, &s_old_sigaction, nullptr);
+#endif
+
+  INFO_LOG_FMT(POWERPC, "Sampling profiler stopped ({} distinct samples, {} dropped)",
+               s_samples.size(), s_dropped_samples);
+}
+
+bool IsRunning()
+{
+  return s_running;
+}
+
+void ResolvePendingSamples()
+{
+  if (!s_running)
+    return;
+
+  std::lock_guard lk(s_pending_samples_lock);
+
+  // Samples that are still on their way from the signal handler to the queue can't be resolved
+  // anymore once blocks have been destroyed. Starting a new epoch lets them be told apart.
+  const u32 epoch = s_block_epoch.load(std::memory_order_relaxed);
+  s_block_epoch.store(epoch + 1, std::memory_order_relaxed);
+
+  if (s_pending_samples.empty())
+    return;
+
+  const std::vector<HostCodeRange> ranges = GetHostCodeRanges();
+  for (const auto& [sample, count] : s_pending_samples)
+  {
+    if (sample.epoch == epoch)
+      s_samples[ResolveSample(ranges, sample)] += count;
+    else
+      s_dropped_samples += count;
+  }
+  s_pending_samples.clear();
+}
+
+bool WriteFoldedStacks(const std::string& filename)
+{
+  if (s_running)
+    return false;
+
+  std::map<std::string, u64> stacks;
+  for (const auto& [sample, count] : s_samples)
+  {
+    // Guest stacks can't be unwound safely while the CPU thread is running, so the only caller
+    // we know about is the one LR points into. This is exact for leaf functions.
+    std::string stack = GetFrameName(sample.address);
+    const std::string caller = GetFrameName(sample.lr);
+    if (sample.lr != 0 && caller != stack)
+      stack = caller + ';' + stack;
+    if (sample.in_host_code)
+      stack += ";[host]";
+
+    stacks[stack] += count;
+  }
+
+  File::IOFile file(filename, "w");
+  if (!file)
+    return false;
+
+  for (const auto& [stack, count] : stacks)
+  {
+    const std::string line = fmt::format("{} {}\n", stack, count);
+    if (!file.WriteString(line))
+      return false;
+  }
+
+  INFO_LOG_FMT(POWERPC, "Wrote {} folded stacks to {}", stacks.size(), filename);
+  return true;
+}
+}  // namespace SamplingProfiler
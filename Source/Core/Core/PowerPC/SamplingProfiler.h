@@ -0,0 +1,33 @@
+// Copyright 2022 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <string>
+
+#include "Common/CommonTypes.h"
+
+// Statistical profiler for guest code.
+//
+// A background thread periodically interrupts the CPU thread and records the guest PC and LR.
+// On hosts where the CPU thread can be interrupted with a signal, the host PC is recorded as
+// well and resolved to the JIT block it belongs to, which also tells apart time spent in
+// compiled guest code from time spent in the emulator on behalf of the guest (e.g. MMIO).
+//
+// Samples are aggregated per PPCSymbolDB function and can be written in the folded stack
+// format understood by flamegraph.pl, inferno and speedscope.
+namespace SamplingProfiler
+{
+// Must be called on the CPU thread.
+void Start(u32 interval_us);
+void Stop();
+bool IsRunning();
+
+// Resolves the host PCs that have been sampled so far to the JIT blocks they belong to. The block
+// cache calls this before destroying any blocks, so that samples are attributed to the code they
+// were actually taken in. Must be called on the CPU thread.
+void ResolvePendingSamples();
+
+// Stop() must have been called first. Returns false if the file couldn't be written.
+bool WriteFoldedStacks(const std::string& filename);
+}  // namespace SamplingProfiler
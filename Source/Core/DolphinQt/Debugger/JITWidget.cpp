@@ -3,6 +3,7 @@
 
 #include "DolphinQt/Debugger/JITWidget.h"
 
+#include <QLabel>
 #include <QPushButton>
 #include <QSplitter>
 #include <QTableWidget>
@@ -11,6 +12,8 @@
 
 #include "Common/GekkoDisassembler.h"
 #include "Common/StringUtil.h"
+#include "Core/PowerPC/JitCommon/JitCache.h"
+#include "Core/PowerPC/JitInterface.h"
 #include "Core/PowerPC/PPCAnalyst.h"
 #include "UICommon/Disassembler.h"
 
@@ -94,6 +97,9 @@ void JITWidget::CreateWidgets()
   m_table_splitter = new QSplitter(Qt::Vertical);
   m_asm_splitter = new QSplitter(Qt::Horizontal);
 
+  m_invalidation_label = new QLabel;
+  m_invalidation_label->setWordWrap(true);
+
   m_refresh_button = new QPushButton(tr("Refresh"));
 
   m_table_splitter->addWidget(m_table_widget);
@@ -108,6 +114,7 @@ void JITWidget::CreateWidgets()
   widget->setLayout(layout);
 
   layout->addWidget(m_table_splitter);
+  layout->addWidget(m_invalidation_label);
   layout->addWidget(m_refresh_button);
 
   setWidget(widget);
@@ -124,11 +131,30 @@ void JITWidget::Compare(u32 address)
   Update();
 }
 
+void JITWidget::UpdateInvalidationStats()
+{
+  JitInvalidationStats stats;
+  JitInterface::GetInvalidationStats(&stats);
+
+  m_invalidation_label->setText(
+      tr("Invalidations: %1 cache line, %2 range, %3 forced, %4 skipped. "
+         "Blocks destroyed: %5. Cache clears: %6. Self-modifying pages: %7.")
+          .arg(stats.cache_line_requests)
+          .arg(stats.range_requests)
+          .arg(stats.forced_requests)
+          .arg(stats.skipped_requests)
+          .arg(stats.destroyed_blocks)
+          .arg(stats.cache_clears)
+          .arg(stats.self_modifying_pages));
+}
+
 void JITWidget::Update()
 {
   if (!isVisible())
     return;
 
+  UpdateInvalidationStats();
+
   if (!m_address)
   {
     m_ppc_asm_widget->setHtml(QStringLiteral("<i>%1</i>").arg(tr("(ppc)")));
@@ -9,6 +9,7 @@
 #include "Common/CommonTypes.h"
 
 class QCloseEvent;
+class QLabel;
 class QShowEvent;
 class QSplitter;
 class QTextBrowser;
@@ -27,6 +28,7 @@ public:
 
 private:
   void Update();
+  void UpdateInvalidationStats();
   void CreateWidgets();
   void ConnectWidgets();
 
@@ -38,6 +40,7 @@ private:
   QTextBrowser* m_host_asm_widget;
   QSplitter* m_table_splitter;
   QSplitter* m_asm_splitter;
+  QLabel* m_invalidation_label;
   QPushButton* m_refresh_button;
 
   std::unique_ptr<HostDisassembler> m_disassembler;
@@ -34,6 +34,63 @@ namespace OpcodeDecoder
 {
 bool g_record_fifo_data = false;
 
+// Looks for primitive commands whose vertices can be converted before the commands are reached, up
+// to the first command that could change how they are converted.
+class PreloadCallback final : public Callback
+{
+public:
+  OPCODE_CALLBACK(void OnXF(u16 address, u8 count, const u8* data)) {}
+  OPCODE_CALLBACK(void OnCP(u8 command, u32 value))
+  {
+    // Everything but the matrix indices affects vertex loading.
+    const u8 sub_command = command & CP_COMMAND_MASK;
+    if (sub_command != MATINDEX_A && sub_command != MATINDEX_B)
+      m_stop = true;
+  }
+  OPCODE_CALLBACK(void OnBP(u8 command, u32 value))
+  {
+    // EFB copies can overwrite the vertex arrays in memory.
+    if (command == BPMEM_TRIGGER_EFB_COPY)
+      m_stop = true;
+  }
+  OPCODE_CALLBACK(void OnIndexedLoad(CPArray array, u32 index, u16 address, u8 size)) {}
+  OPCODE_CALLBACK(void OnPrimitiveCommand(OpcodeDecoder::Primitive primitive, u8 vat,
+                                          u32 vertex_size, u16 num_vertices, const u8* vertex_data))
+  {
+    if (!VertexLoaderManager::QueuePreload(vat, num_vertices, vertex_data))
+      m_stop = true;
+  }
+  // Display lists get their own look ahead when they are run.
+  OPCODE_CALLBACK(void OnDisplayList(u32 address, u32 size)) { m_stop = true; }
+  OPCODE_CALLBACK(void OnNop(u32 count)) {}
+  OPCODE_CALLBACK(void OnUnknown(u8 opcode, const u8* data)) { m_stop = true; }
+  OPCODE_CALLBACK(void OnCommand(const u8* data, u32 size)) {}
+  OPCODE_CALLBACK(CPState& GetCPState()) { return g_main_cp_state; }
+
+  bool m_stop = false;
+};
+
+// Returns where the look ahead stopped. Primitive commands from there on haven't been considered.
+static const u8* PreloadVertices(const u8* start, const u8* end)
+{
+  VertexLoaderManager::ClearPreloads();
+  if (!VertexLoaderManager::ShouldPreloadVertices(static_cast<size_t>(end - start)))
+    return end;
+
+  PreloadCallback callback;
+  const u8* data = start;
+  while (data < end)
+  {
+    const u32 size = RunCommand(data, static_cast<u32>(end - data), callback);
+    if (size == 0 || callback.m_stop)
+      break;
+    data += size;
+  }
+
+  VertexLoaderManager::RunQueuedPreloads();
+  return data;
+}
+
 template <bool is_preprocess>
 class RunCallback final : public Callback
 {
@@ -116,6 +173,14 @@ public:
   OPCODE_CALLBACK(void OnPrimitiveCommand(OpcodeDecoder::Primitive primitive, u8 vat,
                                           u32 vertex_size, u16 num_vertices, const u8* vertex_data))
   {
+    if constexpr (!is_preprocess)
+    {
+      // The opcode and the vertex count come before the vertices.
+      const u8* const command = vertex_data - 3;
+      if (command >= m_preload_end)
+        m_preload_end = PreloadVertices(command, m_end);
+    }
+
     // load vertices
     const u32 size = vertex_size * num_vertices;
 
@@ -170,9 +235,16 @@ public:
           // temporarily swap dl and non-dl (small "hack" for the stats)
           g_stats.SwapDL();
 
+          const u8* const end = m_end;
+          const u8* const preload_end = m_preload_end;
+          SetRange(start_address, start_address + size);
+
           Run(start_address, size, *this);
           INCSTAT(g_stats.this_frame.num_dlists_called);
 
+          m_end = end;
+          m_preload_end = preload_end;
+
           // un-swap
           g_stats.SwapDL();
         }
@@ -228,8 +300,18 @@ public:
       return g_main_cp_state;
   }
 
+  void SetRange(const u8* start, const u8* end)
+  {
+    m_end = end;
+    m_preload_end = start;
+  }
+
   u32 m_cycles = 0;
   bool m_in_display_list = false;
+  // End of the commands that are being run. Primitive commands before m_preload_end have already
+  // been looked at for converting their vertices ahead of time.
+  const u8* m_end = nullptr;
+  const u8* m_preload_end = nullptr;
 };
 
 template <bool is_preprocess>
@@ -237,8 +319,13 @@ u8* RunFifo(DataReader src, u32* cycles)
 {
   using CallbackT = RunCallback<is_preprocess>;
   auto callback = CallbackT{};
+  callback.SetRange(src.GetPointer(), src.GetPointer() + src.size());
   u32 size = Run(src.GetPointer(), static_cast<u32>(src.size()), callback);
 
+  // The FIFO buffer may be moved around before the next call.
+  if constexpr (!is_preprocess)
+    VertexLoaderManager::ClearPreloads();
+
   if (cycles != nullptr)
     *cycles = callback.m_cycles;
 
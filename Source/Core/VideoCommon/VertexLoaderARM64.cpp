@@ -50,8 +50,9 @@ alignas(16) static const float scale_factors[] = {
     1.0 / (1ULL << 28), 1.0 / (1ULL << 29), 1.0 / (1ULL << 30), 1.0 / (1ULL << 31),
 };
 
-VertexLoaderARM64::VertexLoaderARM64(const TVtxDesc& vtx_desc, const VAT& vtx_att)
-    : VertexLoaderBase(vtx_desc, vtx_att), m_float_emit(this)
+VertexLoaderARM64::VertexLoaderARM64(const TVtxDesc& vtx_desc, const VAT& vtx_att,
+                                     bool keep_vertices)
+    : VertexLoaderBase(vtx_desc, vtx_att), m_keep_vertices(keep_vertices), m_float_emit(this)
 {
   AllocCodeSpace(4096);
   const Common::ScopedJITPageWriteAndNoExecute enable_jit_page_writes;
@@ -60,6 +61,16 @@ VertexLoaderARM64::VertexLoaderARM64(const TVtxDesc& vtx_desc, const VAT& vtx_at
   WriteProtect();
 }
 
+VertexLoaderBase* VertexLoaderARM64::GetConcurrentLoader()
+{
+  if (!m_keep_vertices)
+    return this;
+
+  if (!m_concurrent_loader)
+    m_concurrent_loader = std::make_unique<VertexLoaderARM64>(m_VtxDesc, m_VtxAttr, false);
+  return m_concurrent_loader.get();
+}
+
 void VertexLoaderARM64::GetVertexAddr(CPArray array, VertexComponentFormat attribute, ARM64Reg reg)
 {
   if (IsIndexed(attribute))
@@ -207,7 +218,7 @@ int VertexLoaderARM64::ReadVertex(VertexComponentFormat attribute, ComponentForm
   }
 
   // Z-Freeze
-  if (native_format == &m_native_vtx_decl.position)
+  if (m_keep_vertices && native_format == &m_native_vtx_decl.position)
   {
     CMP(remaining_reg, 3);
     FixupBranch dont_store = B(CC_GE);
@@ -215,14 +226,14 @@ int VertexLoaderARM64::ReadVertex(VertexComponentFormat attribute, ComponentForm
     m_float_emit.STR(128, coords, EncodeRegTo64(scratch2_reg), ArithOption(remaining_reg, true));
     SetJumpTarget(dont_store);
   }
-  else if (native_format == &m_native_vtx_decl.normals[1])
+  else if (m_keep_vertices && native_format == &m_native_vtx_decl.normals[1])
   {
     FixupBranch dont_store = CBNZ(remaining_reg);
     MOVP2R(EncodeRegTo64(scratch2_reg), VertexLoaderManager::tangent_cache.data());
     m_float_emit.STR(128, IndexType::Unsigned, coords, EncodeRegTo64(scratch2_reg), 0);
     SetJumpTarget(dont_store);
   }
-  else if (native_format == &m_native_vtx_decl.normals[2])
+  else if (m_keep_vertices && native_format == &m_native_vtx_decl.normals[2])
   {
     FixupBranch dont_store = CBNZ(remaining_reg);
     MOVP2R(EncodeRegTo64(scratch2_reg), VertexLoaderManager::binormal_cache.data());
@@ -432,11 +443,14 @@ void VertexLoaderARM64::GenerateVertexLoader()
     STR(IndexType::Unsigned, scratch1_reg, dst_reg, m_dst_ofs);
 
     // Z-Freeze
-    CMP(remaining_reg, 3);
-    FixupBranch dont_store = B(CC_GE);
-    MOVP2R(EncodeRegTo64(scratch2_reg), VertexLoaderManager::position_matrix_index_cache.data());
-    STR(scratch1_reg, EncodeRegTo64(scratch2_reg), ArithOption(remaining_reg, true));
-    SetJumpTarget(dont_store);
+    if (m_keep_vertices)
+    {
+      CMP(remaining_reg, 3);
+      FixupBranch dont_store = B(CC_GE);
+      MOVP2R(EncodeRegTo64(scratch2_reg), VertexLoaderManager::position_matrix_index_cache.data());
+      STR(scratch1_reg, EncodeRegTo64(scratch2_reg), ArithOption(remaining_reg, true));
+      SetJumpTarget(dont_store);
+    }
 
     m_native_vtx_decl.posmtx.components = 4;
     m_native_vtx_decl.posmtx.enable = true;
@@ -621,7 +635,6 @@ void VertexLoaderARM64::GenerateVertexLoader()
 
 int VertexLoaderARM64::RunVertices(DataReader src, DataReader dst, int count)
 {
-  m_numLoadedVertices += count;
   return ((int (*)(u8 * src, u8 * dst, int count)) region)(src.GetPointer(), dst.GetPointer(),
                                                            count - 1);
 }
@@ -3,6 +3,8 @@
 
 #pragma once
 
+#include <memory>
+
 #include "Common/Arm64Emitter.h"
 #include "Common/CommonTypes.h"
 #include "VideoCommon/VertexLoaderBase.h"
@@ -16,12 +18,18 @@ enum class CPArray : u8;
 class VertexLoaderARM64 : public VertexLoaderBase, public Arm64Gen::ARM64CodeBlock
 {
 public:
-  VertexLoaderARM64(const TVtxDesc& vtx_desc, const VAT& vtx_att);
+  VertexLoaderARM64(const TVtxDesc& vtx_desc, const VAT& vtx_att, bool keep_vertices = true);
+
+  VertexLoaderBase* GetConcurrentLoader() override;
 
 protected:
   int RunVertices(DataReader src, DataReader dst, int count) override;
 
 private:
+  // Whether the last vertices are kept for zfreeze and emboss texgens.
+  const bool m_keep_vertices;
+  std::unique_ptr<VertexLoaderARM64> m_concurrent_loader;
+
   u32 m_src_ofs = 0;
   u32 m_dst_ofs = 0;
   Arm64Gen::FixupBranch m_skip_vertex;
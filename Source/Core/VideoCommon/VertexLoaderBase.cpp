@@ -84,7 +84,6 @@ public:
     }
 
     memcpy(dst.GetPointer(), buffer_a.data(), count_a * m_native_vtx_decl.stride);
-    m_numLoadedVertices += count;
     return count_a;
   }
 
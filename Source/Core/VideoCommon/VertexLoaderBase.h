@@ -67,6 +67,11 @@ public:
                                                               const VAT& vtx_attr);
   virtual ~VertexLoaderBase() {}
   virtual int RunVertices(DataReader src, DataReader dst, int count) = 0;
+  // Returns a loader that converts the same vertices, but doesn't keep any of them for zfreeze and
+  // emboss texgens. Its RunVertices can be called from several threads at once, as long as the CP
+  // state doesn't change meanwhile. Returns nullptr if that isn't supported. Must be called from
+  // the thread that owns this loader.
+  virtual VertexLoaderBase* GetConcurrentLoader() { return nullptr; }
 
   // per loader public state
   PortableVertexDeclaration m_native_vtx_decl{};
@@ -75,7 +80,6 @@ public:
 
   // used by VertexLoaderManager
   NativeVertexFormat* m_native_vertex_format = nullptr;
-  int m_numLoadedVertices = 0;
 
 protected:
   VertexLoaderBase(const TVtxDesc& vtx_desc, const VAT& vtx_attr)
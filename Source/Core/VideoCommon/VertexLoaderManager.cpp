@@ -4,6 +4,7 @@
 #include "VideoCommon/VertexLoaderManager.h"
 
 #include <algorithm>
+#include <cstring>
 #include <iterator>
 #include <memory>
 #include <mutex>
@@ -12,10 +13,15 @@
 #include <utility>
 #include <vector>
 
+#include "Common/Align.h"
+#include "Common/CPUDetect.h"
 #include "Common/CommonTypes.h"
+#include "Common/Config/Config.h"
 #include "Common/EnumMap.h"
 #include "Common/Logging/Log.h"
+#include "Common/WorkerPool.h"
 
+#include "Core/Config/GraphicsSettings.h"
 #include "Core/DolphinAnalytics.h"
 #include "Core/HW/Memmap.h"
 
@@ -58,6 +64,46 @@ u8 g_current_vat;    // Main only
 std::array<VertexLoaderBase*, CP_NUM_VAT_REG> g_main_vertex_loaders;
 std::array<VertexLoaderBase*, CP_NUM_VAT_REG> g_preprocess_vertex_loaders;
 
+namespace
+{
+struct Preload
+{
+  const u8* src;
+  VertexLoaderBase* loader;
+  VertexLoaderBase* concurrent_loader;
+  int count;
+  size_t offset;
+  int loaded_count;
+};
+
+struct Chunk
+{
+  int first;
+  int count;
+  int loaded_count;
+};
+}  // namespace
+
+// Converting vertices on several threads only pays off if there are enough of them.
+constexpr size_t MIN_PRELOAD_VERTICES = 2048;
+constexpr size_t MAX_PRELOAD_BUFFER_SIZE = 4 * 1024 * 1024;
+// The loaders can write a few bytes past the last vertex. Keep that away from the next primitive,
+// which may be converted at the same time.
+constexpr size_t PRELOAD_PADDING = 16;
+// zfreeze needs the last three positions of a primitive.
+constexpr int PRELOAD_TAIL_VERTICES = 3;
+// A single primitive command is only split up if every thread gets at least this many vertices.
+constexpr int MIN_CHUNK_VERTICES = 8192;
+
+static Common::WorkerPool s_loader_workers;
+static std::vector<Preload> s_preloads;
+static size_t s_next_preload;
+static size_t s_preload_vertices;
+static std::vector<u8> s_preload_buffer;
+static std::vector<Chunk> s_chunks;
+// Room for a few vertices that are converted again only for their side effects.
+static std::vector<u8> s_scratch_buffer;
+
 void Init()
 {
   MarkAllDirty();
@@ -66,10 +112,19 @@ void Init()
   for (auto& map_entry : g_preprocess_vertex_loaders)
     map_entry = nullptr;
   SETSTAT(g_stats.num_vertex_loaders, 0);
+
+  // The CPU and GPU threads already keep two cores busy.
+  const int num_threads =
+      std::min(Config::Get(Config::GFX_VERTEX_LOADER_THREADS), cpu_info.num_cores - 2);
+  if (num_threads > 0)
+    s_loader_workers.Start(static_cast<u32>(num_threads), "Vertex loader worker");
 }
 
 void Clear()
 {
+  s_loader_workers.Stop();
+  ClearPreloads();
+
   std::lock_guard<std::mutex> lk(s_vertex_loader_map_lock);
   s_vertex_loader_map.clear();
   s_native_vertex_map.clear();
@@ -335,6 +390,164 @@ static void CheckCPConfiguration(int vtx_attr_group)
   }
 }
 
+static size_t GetPreloadEnd(const Preload& preload)
+{
+  return preload.offset + preload.count * preload.loader->m_native_vtx_decl.stride +
+         PRELOAD_PADDING;
+}
+
+static DataReader GetScratchBuffer(const VertexLoaderBase* loader)
+{
+  const size_t size = PRELOAD_TAIL_VERTICES * loader->m_native_vtx_decl.stride + PRELOAD_PADDING;
+  if (s_scratch_buffer.size() < size)
+    s_scratch_buffer.resize(size);
+  return DataReader(s_scratch_buffer.data(), s_scratch_buffer.data() + s_scratch_buffer.size());
+}
+
+// The loader threads don't keep any vertices for zfreeze and emboss texgens, so convert the last
+// vertices of the primitive once more when it is reached. Those are the only ones that are kept.
+static void RestoreLoaderState(VertexLoaderBase* loader, DataReader src, int count)
+{
+  src.Skip((count - PRELOAD_TAIL_VERTICES) * loader->m_vertex_size);
+  loader->RunVertices(src, GetScratchBuffer(loader), PRELOAD_TAIL_VERTICES);
+}
+
+static int LoadVertices(VertexLoaderBase* loader, DataReader src, DataReader dst, int count)
+{
+  if (s_next_preload < s_preloads.size())
+  {
+    const Preload& preload = s_preloads[s_next_preload];
+    if (preload.src == src.GetPointer() && preload.loader == loader && preload.count == count)
+    {
+      ++s_next_preload;
+      std::memcpy(dst.GetPointer(), &s_preload_buffer[preload.offset],
+                  preload.loaded_count * loader->m_native_vtx_decl.stride);
+      RestoreLoaderState(loader, src, count);
+      return preload.loaded_count;
+    }
+  }
+
+  return RunVerticesInParallel(s_loader_workers, loader, src, dst, count);
+}
+
+int RunVerticesInParallel(Common::WorkerPool& workers, VertexLoaderBase* loader, DataReader src,
+                          DataReader dst, int count)
+{
+  const int num_chunks =
+      std::min(static_cast<int>(workers.GetWorkerCount()) + 1, count / MIN_CHUNK_VERTICES);
+  VertexLoaderBase* const concurrent_loader =
+      num_chunks < 2 ? nullptr : loader->GetConcurrentLoader();
+  if (!concurrent_loader)
+    return loader->RunVertices(src, dst, count);
+
+  const int vertex_size = loader->m_vertex_size;
+  const int stride = loader->m_native_vtx_decl.stride;
+  u8* const src_ptr = src.GetPointer();
+  u8* const src_end = src_ptr + src.size();
+  u8* const dst_ptr = dst.GetPointer();
+  u8* const dst_end = dst_ptr + dst.size();
+
+  s_chunks.resize(num_chunks);
+  for (int i = 0; i < num_chunks; ++i)
+  {
+    const int first = count / num_chunks * i;
+    const int last = i == num_chunks - 1 ? count : count / num_chunks * (i + 1);
+    s_chunks[i] = {first, last - first, 0};
+  }
+
+  workers.ParallelFor(static_cast<u32>(num_chunks), [&](u32 i) {
+    Chunk& chunk = s_chunks[i];
+    const DataReader chunk_src(src_ptr + chunk.first * vertex_size, src_end);
+    const DataReader chunk_dst(dst_ptr + chunk.first * stride, dst_end);
+    chunk.loaded_count = concurrent_loader->RunVertices(chunk_src, chunk_dst, chunk.count);
+  });
+
+  int loaded_count = s_chunks[0].loaded_count;
+  for (int i = 1; i < num_chunks; ++i)
+  {
+    const Chunk& chunk = s_chunks[i];
+    if (chunk.loaded_count == 0)
+      continue;
+
+    // The loaders can write a few bytes past the last vertex, so the previous chunk may have
+    // clobbered the start of this one after it was written. Convert the first vertex that isn't
+    // skipped again.
+    u8* const chunk_dst = dst_ptr + chunk.first * stride;
+    DataReader scratch = GetScratchBuffer(loader);
+    for (int j = chunk.first; j < chunk.first + chunk.count; ++j)
+    {
+      if (concurrent_loader->RunVertices(DataReader(src_ptr + j * vertex_size, src_end), scratch,
+                                         1) == 1)
+      {
+        std::memcpy(chunk_dst, scratch.GetPointer(), stride);
+        break;
+      }
+    }
+
+    // Close the gaps left by skipped vertices.
+    if (loaded_count != chunk.first)
+      std::memmove(dst_ptr + loaded_count * stride, chunk_dst, chunk.loaded_count * stride);
+    loaded_count += chunk.loaded_count;
+  }
+
+  RestoreLoaderState(loader, src, count);
+  return loaded_count;
+}
+
+bool ShouldPreloadVertices(size_t available_bytes)
+{
+  // Every vertex takes up at least one byte.
+  return s_loader_workers.GetWorkerCount() != 0 && available_bytes >= MIN_PRELOAD_VERTICES;
+}
+
+bool QueuePreload(int vtx_attr_group, int count, const u8* src)
+{
+  VertexLoaderBase* loader = RefreshLoader(vtx_attr_group);
+  VertexLoaderBase* concurrent_loader = loader->GetConcurrentLoader();
+  if (!concurrent_loader || count <= PRELOAD_TAIL_VERTICES)
+    return true;
+
+  const size_t offset =
+      s_preloads.empty() ? 0 : Common::AlignUp(GetPreloadEnd(s_preloads.back()), PRELOAD_PADDING);
+  Preload preload{src, loader, concurrent_loader, count, offset, 0};
+  if (!s_preloads.empty() && GetPreloadEnd(preload) > MAX_PRELOAD_BUFFER_SIZE)
+    return false;
+
+  s_preloads.push_back(preload);
+  s_preload_vertices += count;
+  return true;
+}
+
+void RunQueuedPreloads()
+{
+  if (s_preload_vertices < MIN_PRELOAD_VERTICES)
+  {
+    ClearPreloads();
+    return;
+  }
+
+  const size_t size = GetPreloadEnd(s_preloads.back());
+  if (s_preload_buffer.size() < size)
+    s_preload_buffer.resize(size);
+
+  s_loader_workers.ParallelFor(static_cast<u32>(s_preloads.size()), [](u32 i) {
+    Preload& preload = s_preloads[i];
+    u8* src = const_cast<u8*>(preload.src);
+    u8* dst = &s_preload_buffer[preload.offset];
+    preload.loaded_count = preload.concurrent_loader->RunVertices(
+        DataReader(src, src + preload.count * preload.loader->m_vertex_size),
+        DataReader(dst, dst + preload.count * preload.loader->m_native_vtx_decl.stride),
+        preload.count);
+  });
+}
+
+void ClearPreloads()
+{
+  s_preloads.clear();
+  s_next_preload = 0;
+  s_preload_vertices = 0;
+}
+
 int RunVertices(int vtx_attr_group, OpcodeDecoder::Primitive primitive, int count, DataReader src,
                 bool is_preprocess)
 {
@@ -372,7 +585,7 @@ int RunVertices(int vtx_attr_group, OpcodeDecoder::Primitive primitive, int coun
   DataReader dst = g_vertex_manager->PrepareForAdditionalData(
       primitive, count, loader->m_native_vtx_decl.stride, cullall);
 
-  count = loader->RunVertices(src, dst, count);
+  count = LoadVertices(loader, src, dst, count);
 
   g_vertex_manager->AddIndices(primitive, count);
   g_vertex_manager->FlushData(count, loader->m_native_vtx_decl.stride);
@@ -4,6 +4,7 @@
 #pragma once
 
 #include <array>
+#include <cstddef>
 #include <memory>
 #include <string>
 #include <unordered_map>
@@ -16,6 +17,11 @@ class DataReader;
 class NativeVertexFormat;
 struct PortableVertexDeclaration;
 
+namespace Common
+{
+class WorkerPool;
+}
+
 namespace OpcodeDecoder
 {
 enum class Primitive : u8;
@@ -45,6 +51,22 @@ NativeVertexFormat* GetUberVertexFormat(const PortableVertexDeclaration& decl);
 int RunVertices(int vtx_attr_group, OpcodeDecoder::Primitive primitive, int count, DataReader src,
                 bool is_preprocess);
 
+// The vertices of upcoming primitive commands can be converted ahead of time on the vertex loader
+// threads, after which RunVertices only has to copy them into place. Commands have to be queued in
+// the order they will be run in, and the CP state must not change until they have all been run.
+bool ShouldPreloadVertices(size_t available_bytes);
+// Returns false if there is no more room in the queue.
+bool QueuePreload(int vtx_attr_group, int count, const u8* src);
+void RunQueuedPreloads();
+// Drops the converted vertices that haven't been used. Their source data may not be valid anymore.
+void ClearPreloads();
+
+// Converts the vertices of a single primitive command. Large ones are split into chunks, which are
+// converted by the given worker threads straight into dst. Returns the number of vertices written,
+// like VertexLoaderBase::RunVertices.
+int RunVerticesInParallel(Common::WorkerPool& workers, VertexLoaderBase* loader, DataReader src,
+                          DataReader dst, int count);
+
 NativeVertexFormat* GetCurrentVertexFormat();
 
 // Resolved pointers to array bases. Used by vertex loaders.
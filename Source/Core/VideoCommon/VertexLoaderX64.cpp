@@ -44,8 +44,9 @@ static OpArg MPIC(const void* ptr)
   return MDisp(base_reg, PtrOffset(ptr, memory_base_ptr));
 }
 
-VertexLoaderX64::VertexLoaderX64(const TVtxDesc& vtx_desc, const VAT& vtx_att)
-    : VertexLoaderBase(vtx_desc, vtx_att)
+VertexLoaderX64::VertexLoaderX64(const TVtxDesc& vtx_desc, const VAT& vtx_att,
+                                 bool keep_vertices)
+    : VertexLoaderBase(vtx_desc, vtx_att), m_keep_vertices(keep_vertices)
 {
   AllocCodeSpace(4096);
   ClearCodeSpace();
@@ -56,6 +57,16 @@ VertexLoaderX64::VertexLoaderX64(const TVtxDesc& vtx_desc, const VAT& vtx_att)
                         vtx_att);
 }
 
+VertexLoaderBase* VertexLoaderX64::GetConcurrentLoader()
+{
+  if (!m_keep_vertices)
+    return this;
+
+  if (!m_concurrent_loader)
+    m_concurrent_loader = std::make_unique<VertexLoaderX64>(m_VtxDesc, m_VtxAttr, false);
+  return m_concurrent_loader.get();
+}
+
 OpArg VertexLoaderX64::GetVertexAddr(CPArray array, VertexComponentFormat attribute)
 {
   OpArg data = MDisp(src_reg, m_src_ofs);
@@ -117,6 +128,9 @@ int VertexLoaderX64::ReadVertex(OpArg data, VertexComponentFormat attribute, Com
   X64Reg coords = XMM0;
 
   const auto write_zfreeze = [&]() {  // zfreeze
+    if (!m_keep_vertices)
+      return;
+
     if (native_format == &m_native_vtx_decl.position)
     {
       CMP(32, R(remaining_reg), Imm8(3));
@@ -430,11 +444,15 @@ void VertexLoaderX64::GenerateVertexLoader()
     MOV(32, MDisp(dst_reg, m_dst_ofs), R(scratch1));
 
     // zfreeze
-    CMP(32, R(remaining_reg), Imm8(3));
-    FixupBranch dont_store = J_CC(CC_AE);
-    MOV(32, MPIC(VertexLoaderManager::position_matrix_index_cache.data(), remaining_reg, SCALE_4),
-        R(scratch1));
-    SetJumpTarget(dont_store);
+    if (m_keep_vertices)
+    {
+      CMP(32, R(remaining_reg), Imm8(3));
+      FixupBranch dont_store = J_CC(CC_AE);
+      MOV(32,
+          MPIC(VertexLoaderManager::position_matrix_index_cache.data(), remaining_reg, SCALE_4),
+          R(scratch1));
+      SetJumpTarget(dont_store);
+    }
 
     m_native_vtx_decl.posmtx.components = 4;
     m_native_vtx_decl.posmtx.enable = true;
@@ -560,7 +578,6 @@ void VertexLoaderX64::GenerateVertexLoader()
 
 int VertexLoaderX64::RunVertices(DataReader src, DataReader dst, int count)
 {
-  m_numLoadedVertices += count;
   return ((int (*)(u8*, u8*, int, const void*))region)(src.GetPointer(), dst.GetPointer(), count,
                                                        memory_base_ptr);
 }
@@ -3,6 +3,8 @@
 
 #pragma once
 
+#include <memory>
+
 #include "Common/CommonTypes.h"
 #include "Common/x64Emitter.h"
 #include "VideoCommon/VertexLoaderBase.h"
@@ -15,12 +17,18 @@ enum class CPArray : u8;
 class VertexLoaderX64 : public VertexLoaderBase, public Gen::X64CodeBlock
 {
 public:
-  VertexLoaderX64(const TVtxDesc& vtx_desc, const VAT& vtx_att);
+  VertexLoaderX64(const TVtxDesc& vtx_desc, const VAT& vtx_att, bool keep_vertices = true);
+
+  VertexLoaderBase* GetConcurrentLoader() override;
 
 protected:
   int RunVertices(DataReader src, DataReader dst, int count) override;
 
 private:
+  // Whether the last vertices are kept for zfreeze and emboss texgens.
+  const bool m_keep_vertices;
+  std::unique_ptr<VertexLoaderX64> m_concurrent_loader;
+
   u32 m_src_ofs = 0;
   u32 m_dst_ofs = 0;
   Gen::FixupBranch m_skip_vertex;
@@ -0,0 +1,79 @@
+// Copyright 2022 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <gtest/gtest.h>
+#include <thread>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+#include "Common/MPSCQueue.h"
+
+TEST(MPSCQueue, Simple)
+{
+  Common::MPSCQueue<u32> q;
+
+  EXPECT_TRUE(q.Empty());
+
+  q.Push(1);
+  EXPECT_FALSE(q.Empty());
+
+  u32 v;
+  EXPECT_TRUE(q.Pop(v));
+  EXPECT_EQ(1u, v);
+  EXPECT_TRUE(q.Empty());
+  EXPECT_FALSE(q.Pop(v));
+
+  // Test the FIFO order.
+  for (u32 i = 0; i < 1000; ++i)
+    q.Push(i);
+  for (u32 i = 0; i < 1000; ++i)
+  {
+    u32 v2;
+    EXPECT_TRUE(q.Pop(v2));
+    EXPECT_EQ(i, v2);
+  }
+  EXPECT_TRUE(q.Empty());
+
+  for (u32 i = 0; i < 1000; ++i)
+    q.Push(i);
+  EXPECT_FALSE(q.Empty());
+  q.Clear();
+  EXPECT_TRUE(q.Empty());
+}
+
+static constexpr u32 PRODUCER_COUNT = 4;
+static constexpr u32 VALUES_PER_PRODUCER = 50000;
+
+TEST(MPSCQueue, MultiThreaded)
+{
+  Common::MPSCQueue<u32> q;
+
+  auto inserter = [&q](u32 producer) {
+    for (u32 i = 0; i < VALUES_PER_PRODUCER; ++i)
+      q.Push(producer * VALUES_PER_PRODUCER + i);
+  };
+
+  auto popper = [&q]() {
+    // Values from one producer must come out in the order they were pushed.
+    std::vector<u32> next(PRODUCER_COUNT, 0);
+    for (u32 i = 0; i < PRODUCER_COUNT * VALUES_PER_PRODUCER; ++i)
+    {
+      u32 v;
+      while (!q.Pop(v))
+        ;
+      const u32 producer = v / VALUES_PER_PRODUCER;
+      ASSERT_LT(producer, PRODUCER_COUNT);
+      EXPECT_EQ(next[producer]++, v % VALUES_PER_PRODUCER);
+    }
+  };
+
+  std::thread popper_thread(popper);
+  std::vector<std::thread> inserter_threads;
+  for (u32 i = 0; i < PRODUCER_COUNT; ++i)
+    inserter_threads.emplace_back(inserter, i);
+
+  for (std::thread& thread : inserter_threads)
+    thread.join();
+  popper_thread.join();
+  EXPECT_TRUE(q.Empty());
+}
@@ -0,0 +1,38 @@
+// Copyright 2022 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <atomic>
+#include <gtest/gtest.h>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+#include "Common/WorkerPool.h"
+
+TEST(WorkerPool, NoWorkers)
+{
+  Common::WorkerPool pool;
+  EXPECT_EQ(0u, pool.GetWorkerCount());
+
+  std::vector<u32> calls;
+  pool.ParallelFor(5, [&calls](u32 i) { calls.push_back(i); });
+  EXPECT_EQ((std::vector<u32>{0, 1, 2, 3, 4}), calls);
+}
+
+TEST(WorkerPool, EveryIterationRunsOnce)
+{
+  Common::WorkerPool pool;
+  pool.Start(3, "WorkerPoolTest");
+  EXPECT_EQ(3u, pool.GetWorkerCount());
+
+  // Many short loops in a row, so that workers regularly wake up late for a loop.
+  for (u32 count = 0; count < 2000; ++count)
+  {
+    std::vector<std::atomic<u32>> calls(count % 64);
+    pool.ParallelFor(static_cast<u32>(calls.size()), [&calls](u32 i) { ++calls[i]; });
+    for (const std::atomic<u32>& c : calls)
+      ASSERT_EQ(1u, c.load());
+  }
+
+  pool.Stop();
+  EXPECT_EQ(0u, pool.GetWorkerCount());
+}
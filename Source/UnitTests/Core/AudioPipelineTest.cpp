@@ -0,0 +1,518 @@
+// Copyright 2022 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <random>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include "AudioCommon/Mixer.h"
+#include "AudioCommon/TimeStretcher.h"
+#include "Common/BitUtils.h"
+#include "Common/CommonTypes.h"
+#include "Common/Config/Config.h"
+#include "Common/FileUtil.h"
+#include "Common/Hash.h"
+#include "Common/MathUtil.h"
+#include "Common/Swap.h"
+#include "Core/Config/MainSettings.h"
+#include "Core/ConfigManager.h"
+#include "Core/CoreTiming.h"
+#include "Core/HW/DSP.h"
+#include "Core/HW/DSPHLE/DSPHLE.h"
+#include "Core/HW/DSPHLE/UCodes/AX.h"
+#include "Core/HW/DSPHLE/UCodes/AXStructs.h"
+#include "Core/HW/DSPHLE/UCodes/AXWii.h"
+#include "Core/HW/Memmap.h"
+#include "Core/HW/StreamADPCM.h"
+#include "UICommon/UICommon.h"
+
+// These tests run fixed, randomly generated workloads through the audio pipeline and compare the
+// output against known hashes, so that optimizations can be checked for bit exactness. They also
+// print how fast each stage ran, which is useful when working on audio performance.
+
+namespace
+{
+class ScopeInit final
+{
+public:
+  ScopeInit() : m_profile_path(File::CreateTempDir())
+  {
+    if (!UserDirectoryExists())
+      return;
+
+    UICommon::SetUserDirectory(m_profile_path);
+    Config::Init();
+    SConfig::Init();
+  }
+  ~ScopeInit()
+  {
+    if (!UserDirectoryExists())
+      return;
+
+    SConfig::Shutdown();
+    Config::Shutdown();
+    File::DeleteDirRecursively(m_profile_path);
+  }
+  bool UserDirectoryExists() const { return !m_profile_path.empty(); }
+
+private:
+  std::string m_profile_path;
+};
+
+// Sets up emulated memory and ARAM for the DSP HLE.
+class ScopeInitDSP final
+{
+public:
+  ScopeInitDSP()
+  {
+    CoreTiming::Init();
+    Memory::Init();
+    DSP::Init(true);
+  }
+  ~ScopeInitDSP()
+  {
+    DSP::Shutdown();
+    Memory::Shutdown();
+    CoreTiming::Shutdown();
+  }
+};
+
+template <typename UCode>
+class TestUCode final : public UCode
+{
+public:
+  using UCode::UCode;
+
+  void SetVoiceThreads(u32 num_threads)
+  {
+    if (num_threads == 0)
+      this->m_voice_workers.Stop();
+    else
+      this->m_voice_workers.Start(num_threads, "AX voice worker");
+  }
+
+  void RunCommandList(const std::vector<u16>& command_list)
+  {
+    std::copy(command_list.begin(), command_list.end(), this->m_cmdlist);
+    this->m_cmdlist_size = static_cast<u32>(command_list.size());
+    this->HandleCommandList();
+  }
+};
+
+template <typename Duration>
+double PerSecond(u64 count, Duration duration)
+{
+  return count / std::chrono::duration<double>(duration).count();
+}
+
+// Any AX ucode that isn't special cased by AXUCode.
+constexpr u32 AX_CRC = 0x07f88145;
+// Wii Sports, which still processes the PBs one millisecond at a time, and Elebits.
+constexpr u32 AXWII_OLD_CRC = 0xfa450138;
+constexpr u32 AXWII_CRC = 0xadbc06bd;
+
+constexpr u32 AX_INIT_ADDR = 0x00010000;
+constexpr u32 AX_PB_ADDR = 0x00020000;
+constexpr u32 AX_PB_STRIDE = 0x200;
+constexpr u32 AX_OUTPUT_LR_ADDR = 0x00040000;
+constexpr u32 AX_OUTPUT_SURROUND_ADDR = 0x00041000;
+constexpr u32 AX_NUM_VOICES = 64;
+constexpr u32 AX_NUM_FRAMES = 200;
+constexpr u32 AX_SAMPLES_PER_FRAME = 5 * 32;
+
+// Every voice loops over its own sound in ARAM.
+constexpr u32 AX_SOUND_BYTES = 0x4000;
+
+template <typename PB>
+void SetupAXVoices(bool old_axwii = false)
+{
+  constexpr bool is_wii = std::is_same_v<PB, DSP::HLE::AXPBWii>;
+
+  std::mt19937 rng(0x4158);
+  u8* aram = DSP::GetARAMPtr();
+  for (u32 i = 0; i < AX_NUM_VOICES * AX_SOUND_BYTES; ++i)
+    aram[i] = static_cast<u8>(rng());
+
+  for (u32 voice = 0; voice < AX_NUM_VOICES; ++voice)
+  {
+    PB pb{};
+    const u32 addr = AX_PB_ADDR + voice * AX_PB_STRIDE;
+    const u32 next_addr = voice + 1 == AX_NUM_VOICES ? 0 : addr + AX_PB_STRIDE;
+    pb.next_pb_hi = static_cast<u16>(next_addr >> 16);
+    pb.next_pb_lo = static_cast<u16>(next_addr);
+    pb.this_pb_hi = static_cast<u16>(addr >> 16);
+    pb.this_pb_lo = static_cast<u16>(addr);
+
+    pb.running = 1;
+    pb.src_type = DSP::HLE::SRCTYPE_LINEAR;
+
+    // Main left and right, with ramps on some voices and surround on others.
+    const u16 mixer_control =
+        0x0003 | (voice % 3 == 0 ? 0x0008 : 0) | (voice % 4 == 0 ? 0x0004 : 0);
+    if constexpr (is_wii)
+      pb.mixer_control_lo = mixer_control;
+    else
+      pb.mixer_control = mixer_control;
+    pb.mixer.main_left.volume = static_cast<u16>(rng() & 0x1fff);
+    pb.mixer.main_left.volume_delta = static_cast<u16>((rng() & 0xf) - 8);
+    pb.mixer.main_right.volume = static_cast<u16>(rng() & 0x1fff);
+    pb.mixer.main_right.volume_delta = static_cast<u16>((rng() & 0xf) - 8);
+    pb.mixer.main_surround.volume = static_cast<u16>(rng() & 0x1fff);
+    pb.vol_env.cur_volume = static_cast<u16>(0x4000 + (rng() & 0x3fff));
+
+    // Resampling ratios between 0.5 and 2.0.
+    const u32 ratio = 0x8000 + rng() % 0x18000;
+    pb.src.ratio_hi = static_cast<u16>(ratio >> 16);
+    pb.src.ratio_lo = static_cast<u16>(ratio);
+
+    // Alternate between PCM16 and ADPCM voices. Addresses are in samples (or nibbles for ADPCM),
+    // and the end address is inclusive.
+    const u32 sound_start = voice * AX_SOUND_BYTES;
+    u32 start, end;
+    pb.audio_addr.looping = 1;
+    if (voice % 2 == 0)
+    {
+      pb.audio_addr.sample_format = DSP::HLE::AUDIOFORMAT_PCM16;
+      start = sound_start / 2;
+      end = start + AX_SOUND_BYTES / 2 - 1;
+    }
+    else
+    {
+      pb.audio_addr.sample_format = DSP::HLE::AUDIOFORMAT_ADPCM;
+      // Skip the header of the first ADPCM frame.
+      start = sound_start * 2 + 2;
+      end = sound_start * 2 + AX_SOUND_BYTES * 2 - 1;
+      for (s16& coef : pb.adpcm.coefs)
+        coef = static_cast<s16>((rng() & 0xfff) - 0x400);
+      pb.adpcm.pred_scale = aram[sound_start];
+      pb.adpcm_loop_info.pred_scale = aram[sound_start];
+    }
+    pb.audio_addr.loop_addr_hi = static_cast<u16>(start >> 16);
+    pb.audio_addr.loop_addr_lo = static_cast<u16>(start);
+    pb.audio_addr.cur_addr_hi = static_cast<u16>(start >> 16);
+    pb.audio_addr.cur_addr_lo = static_cast<u16>(start);
+    pb.audio_addr.end_addr_hi = static_cast<u16>(end >> 16);
+    pb.audio_addr.end_addr_lo = static_cast<u16>(end);
+
+    if constexpr (is_wii)
+    {
+      // Send every voice to a different mix of the Wii Remote speakers.
+      pb.remote = 1;
+      pb.remote_mixer_control = static_cast<u16>(rng());
+      for (DSP::HLE::VolumeData* volume :
+           {&pb.remote_mixer.main0, &pb.remote_mixer.aux0, &pb.remote_mixer.main1,
+            &pb.remote_mixer.aux1, &pb.remote_mixer.main2, &pb.remote_mixer.aux2,
+            &pb.remote_mixer.main3, &pb.remote_mixer.aux3})
+      {
+        volume->volume = static_cast<u16>(rng() & 0x1fff);
+        volume->volume_delta = static_cast<u16>((rng() & 0xf) - 8);
+      }
+    }
+
+    auto pb_mem = Common::BitCastToArray<u16>(pb);
+    // Old AXWii PBs have 5 more words for the updates, which are left empty here.
+    if (old_axwii)
+    {
+      std::copy_backward(&pb_mem[41], &pb_mem[pb_mem.size() - 5], &pb_mem[pb_mem.size()]);
+      std::fill_n(&pb_mem[41], 5, u16(0));
+    }
+    Memory::CopyToEmuSwapped<u16>(addr, pb_mem.data(), sizeof(pb));
+  }
+}
+
+u32 RunAX(u32 voice_threads)
+{
+  ScopeInitDSP dsp_guard;
+  SetupAXVoices<DSP::HLE::AXPB>();
+
+  auto* dsphle = static_cast<DSP::HLE::DSPHLE*>(DSP::GetDSPEmulator());
+  TestUCode<DSP::HLE::AXUCode> ucode(dsphle, AX_CRC);
+  ucode.SetVoiceThreads(voice_threads);
+
+  // The mixing buffers are initialized from zeroed memory at AX_INIT_ADDR.
+  const std::vector<u16> command_list = {
+      // Setup
+      0x00, AX_INIT_ADDR >> 16, AX_INIT_ADDR & 0xffff,
+      // Set the PB list address
+      0x02, AX_PB_ADDR >> 16, AX_PB_ADDR & 0xffff,
+      // Process the PB list
+      0x03,
+      // Output
+      0x0e, AX_OUTPUT_SURROUND_ADDR >> 16, AX_OUTPUT_SURROUND_ADDR & 0xffff,
+      AX_OUTPUT_LR_ADDR >> 16, AX_OUTPUT_LR_ADDR & 0xffff,
+      // End
+      0x0f,
+  };
+
+  u32 crc = Common::StartCRC32();
+  std::chrono::steady_clock::duration elapsed{};
+  for (u32 frame = 0; frame < AX_NUM_FRAMES; ++frame)
+  {
+    const auto start = std::chrono::steady_clock::now();
+    ucode.RunCommandList(command_list);
+    elapsed += std::chrono::steady_clock::now() - start;
+
+    const u8* output = Memory::GetPointer(AX_OUTPUT_LR_ADDR);
+    const u8* surround_output = Memory::GetPointer(AX_OUTPUT_SURROUND_ADDR);
+    crc = Common::UpdateCRC32(crc, output, AX_SAMPLES_PER_FRAME * 2 * sizeof(s16));
+    crc = Common::UpdateCRC32(crc, surround_output, AX_SAMPLES_PER_FRAME * sizeof(s32));
+
+    // A hash of silence wouldn't be worth much.
+    if (frame == 0)
+    {
+      EXPECT_FALSE(std::all_of(output, output + AX_SAMPLES_PER_FRAME * 2 * sizeof(s16),
+                               [](u8 byte) { return byte == 0; }));
+    }
+  }
+
+  fmt::print("AX with {} voice threads: {:.0f} voice samples/s\n", voice_threads,
+             PerSecond(u64{AX_NUM_FRAMES} * AX_SAMPLES_PER_FRAME * AX_NUM_VOICES, elapsed));
+  return crc;
+}
+
+constexpr u32 AXWII_OUTPUT_WM_ADDR = 0x00042000;
+constexpr u32 AXWII_SAMPLES_PER_FRAME = 3 * 32;
+constexpr u32 AXWII_WM_SAMPLES_PER_FRAME = 3 * 6;
+
+u32 RunAXWii(u32 crc, u32 voice_threads)
+{
+  ScopeInitDSP dsp_guard;
+  const bool old_axwii = crc == AXWII_OLD_CRC;
+  SetupAXVoices<DSP::HLE::AXPBWii>(old_axwii);
+
+  auto* dsphle = static_cast<DSP::HLE::DSPHLE*>(DSP::GetDSPEmulator());
+  TestUCode<DSP::HLE::AXWiiUCode> ucode(dsphle, crc);
+  ucode.SetVoiceThreads(voice_threads);
+
+  std::vector<u16> wm_addresses;
+  for (u32 i = 0; i < 4; ++i)
+  {
+    const u32 addr = AXWII_OUTPUT_WM_ADDR + i * 0x100;
+    wm_addresses.push_back(static_cast<u16>(addr >> 16));
+    wm_addresses.push_back(static_cast<u16>(addr));
+  }
+
+  // The mixing buffers are initialized from zeroed memory at AX_INIT_ADDR. The old command list
+  // sets the PB list address separately and has no output volume.
+  std::vector<u16> command_list = {0x00, AX_INIT_ADDR >> 16, AX_INIT_ADDR & 0xffff};
+  if (old_axwii)
+  {
+    command_list.insert(command_list.end(), {0x04, AX_PB_ADDR >> 16, AX_PB_ADDR & 0xffff, 0x05,
+                                             0x0c, AX_OUTPUT_SURROUND_ADDR >> 16,
+                                             AX_OUTPUT_SURROUND_ADDR & 0xffff,
+                                             AX_OUTPUT_LR_ADDR >> 16, AX_OUTPUT_LR_ADDR & 0xffff,
+                                             0x0e});
+    command_list.insert(command_list.end(), wm_addresses.begin(), wm_addresses.end());
+    command_list.push_back(0x0f);
+  }
+  else
+  {
+    command_list.insert(command_list.end(), {0x04, AX_PB_ADDR >> 16, AX_PB_ADDR & 0xffff, 0x0b,
+                                             0x8000, AX_OUTPUT_SURROUND_ADDR >> 16,
+                                             AX_OUTPUT_SURROUND_ADDR & 0xffff,
+                                             AX_OUTPUT_LR_ADDR >> 16, AX_OUTPUT_LR_ADDR & 0xffff,
+                                             0x0d});
+    command_list.insert(command_list.end(), wm_addresses.begin(), wm_addresses.end());
+    command_list.push_back(0x0e);
+  }
+
+  u32 crc32 = Common::StartCRC32();
+  for (u32 frame = 0; frame < AX_NUM_FRAMES; ++frame)
+  {
+    ucode.RunCommandList(command_list);
+
+    const u8* output = Memory::GetPointer(AX_OUTPUT_LR_ADDR);
+    const u8* surround_output = Memory::GetPointer(AX_OUTPUT_SURROUND_ADDR);
+    crc32 = Common::UpdateCRC32(crc32, output, AXWII_SAMPLES_PER_FRAME * 2 * sizeof(s16));
+    crc32 = Common::UpdateCRC32(crc32, surround_output, AXWII_SAMPLES_PER_FRAME * sizeof(s32));
+    for (u32 i = 0; i < 4; ++i)
+    {
+      const u8* wm_output = Memory::GetPointer(AXWII_OUTPUT_WM_ADDR + i * 0x100);
+      crc32 = Common::UpdateCRC32(crc32, wm_output, AXWII_WM_SAMPLES_PER_FRAME * sizeof(s16));
+
+      // Every Wii Remote speaker should get some sound.
+      if (frame == AX_NUM_FRAMES - 1)
+      {
+        EXPECT_FALSE(std::all_of(wm_output,
+                                 wm_output + AXWII_WM_SAMPLES_PER_FRAME * sizeof(s16),
+                                 [](u8 byte) { return byte == 0; }));
+      }
+    }
+  }
+
+  return crc32;
+}
+
+constexpr u32 MIXER_OUTPUT_RATE = 48000;
+constexpr u32 MIXER_NUM_BLOCKS = 2000;
+
+u32 RunMixer(bool sinc_resampling)
+{
+  Config::SetCurrent(Config::MAIN_AUDIO_SINC_RESAMPLING, sinc_resampling);
+  // Disable the rate control, which depends on the timing of the audio callbacks.
+  Config::SetCurrent(Config::MAIN_EMULATION_SPEED, 0.0f);
+
+  Mixer mixer(MIXER_OUTPUT_RATE);
+  mixer.SetDMAInputSampleRate(32000);
+  mixer.SetStreamInputSampleRate(48000);
+  mixer.SetStreamingVolume(200, 255);
+
+  // 5 ms of input and output per block.
+  std::mt19937 rng(0x4d4958);
+  std::array<s16, 160 * 2> dma_samples;
+  std::array<s16, 240 * 2> stream_samples;
+  std::array<s16, 240 * 2> output;
+
+  u32 crc = Common::StartCRC32();
+  std::chrono::steady_clock::duration elapsed{};
+  for (u32 block = 0; block < MIXER_NUM_BLOCKS; ++block)
+  {
+    // A sawtooth with a bit of noise, so that the resampler has something to smooth out.
+    for (size_t i = 0; i < dma_samples.size(); ++i)
+    {
+      const s16 value = static_cast<s16>(((block * 160 + i / 2) * 300) + (rng() & 0xff));
+      dma_samples[i] = static_cast<s16>(Common::swap16(static_cast<u16>(value)));
+    }
+    for (s16& sample : stream_samples)
+      sample = static_cast<s16>(Common::swap16(static_cast<u16>(rng())));
+
+    const auto start = std::chrono::steady_clock::now();
+    mixer.PushSamples(dma_samples.data(), 160);
+    mixer.PushStreamingSamples(stream_samples.data(), 240);
+    mixer.Mix(output.data(), 240);
+    elapsed += std::chrono::steady_clock::now() - start;
+
+    crc = Common::UpdateCRC32(crc, reinterpret_cast<const u8*>(output.data()),
+                              output.size() * sizeof(s16));
+  }
+
+  fmt::print("Mixer with {} resampling: {:.0f} output samples/s\n",
+             sinc_resampling ? "sinc" : "linear",
+             PerSecond(u64{MIXER_NUM_BLOCKS} * 240, elapsed));
+  return crc;
+}
+}  // namespace
+
+TEST(AudioPipeline, AXMixing)
+{
+  ScopeInit guard;
+  ASSERT_TRUE(guard.UserDirectoryExists());
+
+  constexpr u32 expected_crc = 829713912;
+  EXPECT_EQ(expected_crc, RunAX(0));
+  // Mixing voices on worker threads must not change the result.
+  EXPECT_EQ(expected_crc, RunAX(3));
+}
+
+TEST(AudioPipeline, AXWiiMixing)
+{
+  ScopeInit guard;
+  ASSERT_TRUE(guard.UserDirectoryExists());
+
+  // Mixing voices on worker threads must not change the result, including the Wii Remote buffers,
+  // which hold fewer samples per millisecond than the others.
+  for (const u32 crc : {AXWII_OLD_CRC, AXWII_CRC})
+  {
+    const u32 expected_crc = RunAXWii(crc, 0);
+    EXPECT_EQ(expected_crc, RunAXWii(crc, 3)) << fmt::format("ucode {:08x}", crc);
+  }
+}
+
+TEST(AudioPipeline, MixerResampling)
+{
+  ScopeInit guard;
+  ASSERT_TRUE(guard.UserDirectoryExists());
+
+  EXPECT_EQ(954210148u, RunMixer(false));
+
+  // The sinc filters are designed with floating point math from the standard library, which may
+  // round differently from platform to platform, so only check that the output is deterministic.
+  const u32 sinc_crc = RunMixer(true);
+  EXPECT_EQ(sinc_crc, RunMixer(true));
+}
+
+TEST(AudioPipeline, StreamADPCM)
+{
+  constexpr u32 num_blocks = 50000;
+
+  std::mt19937 rng(0x44544b);
+  std::vector<u8> adpcm(num_blocks * StreamADPCM::ONE_BLOCK_SIZE);
+  for (u8& byte : adpcm)
+    byte = static_cast<u8>(rng());
+
+  std::vector<s16> pcm(num_blocks * StreamADPCM::SAMPLES_PER_BLOCK * 2);
+  StreamADPCM::ADPCMDecoder decoder;
+  decoder.ResetFilter();
+
+  // Decode in batches of 6 blocks, like the 3.5 ms DTK reads.
+  constexpr u32 batch_blocks = 6;
+  const auto start = std::chrono::steady_clock::now();
+  for (u32 block = 0; block < num_blocks; block += batch_blocks)
+  {
+    decoder.DecodeBlocks(&pcm[block * StreamADPCM::SAMPLES_PER_BLOCK * 2],
+                         &adpcm[block * StreamADPCM::ONE_BLOCK_SIZE],
+                         std::min(batch_blocks, num_blocks - block));
+  }
+  const auto elapsed = std::chrono::steady_clock::now() - start;
+
+  fmt::print("Stream ADPCM: {:.0f} samples/s\n",
+             PerSecond(u64{num_blocks} * StreamADPCM::SAMPLES_PER_BLOCK, elapsed));
+  EXPECT_EQ(2909909856u, Common::ComputeCRC32(reinterpret_cast<const u8*>(pcm.data()),
+                                              static_cast<u32>(pcm.size() * sizeof(s16))));
+
+  // Decoding one block at a time must give the same result.
+  std::vector<s16> single_pcm(pcm.size());
+  decoder.ResetFilter();
+  for (u32 block = 0; block < num_blocks; ++block)
+  {
+    decoder.DecodeBlock(&single_pcm[block * StreamADPCM::SAMPLES_PER_BLOCK * 2],
+                        &adpcm[block * StreamADPCM::ONE_BLOCK_SIZE]);
+  }
+  EXPECT_EQ(pcm, single_pcm);
+}
+
+TEST(AudioPipeline, TimeStretching)
+{
+  constexpr u32 sample_rate = 48000;
+  constexpr u32 num_samples = sample_rate * 20;
+  constexpr u32 chunk_samples = 512;
+
+  std::vector<s16> input(num_samples * 2);
+  for (u32 i = 0; i < num_samples; ++i)
+  {
+    const double t = static_cast<double>(i) / sample_rate;
+    input[i * 2] = static_cast<s16>(8000 * std::sin(2 * MathUtil::PI * 440 * t));
+    input[i * 2 + 1] = static_cast<s16>(8000 * std::sin(2 * MathUtil::PI * 660 * t));
+  }
+
+  std::vector<s16> output(num_samples * 2);
+  for (const double tempo : {1.0, 1.25, 1.75, 3.0})
+  {
+    AudioCommon::TimeStretcher stretcher(sample_rate);
+    stretcher.SetTempo(tempo);
+
+    u32 received = 0;
+    const auto start = std::chrono::steady_clock::now();
+    for (u32 i = 0; i < num_samples; i += chunk_samples)
+    {
+      stretcher.PutSamples(&input[i * 2], chunk_samples);
+      received += stretcher.ReceiveSamples(&output[received * 2], num_samples - received);
+    }
+    const auto elapsed = std::chrono::steady_clock::now() - start;
+
+    fmt::print("Time stretching at {}x: {:.0f} samples/s\n", tempo,
+               PerSecond(num_samples, elapsed));
+
+    // Up to about a tenth of a second stays buffered inside the stretcher.
+    EXPECT_NEAR(num_samples / tempo, received, sample_rate / 10.0);
+  }
+}
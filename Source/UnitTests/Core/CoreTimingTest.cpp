@@ -3,9 +3,15 @@
 
 #include <gtest/gtest.h>
 
+#include <algorithm>
 #include <array>
 #include <bitset>
+#include <chrono>
 #include <string>
+#include <thread>
+#include <vector>
+
+#include <fmt/format.h>
 
 #include "Common/Config/Config.h"
 #include "Common/FileUtil.h"
@@ -273,17 +279,14 @@ TEST(CoreTiming, ScheduleIntoPast)
   AdvanceAndCheck(0, MAX_SLICE_LENGTH, 1000);  // Run cb_chain into late cb_a
 
   // Schedule late from wrong thread
-  // The problem with scheduling CPU events from outside the CPU Thread is that g_global_timer
-  // is not reliable outside the CPU Thread. It's possible for the other thread to sample the
-  // global timer right before the timer is updated by Advance() then submit a new event using
-  // the stale value, i.e. effectively half-way through the previous slice.
+  // Other threads can't read the global timer safely, so their events are relative to the global
+  // timer when the CPU thread picks them up at the start of the next Advance(), i.e. the start of
+  // the slice that was running when they were scheduled.
   // NOTE: We're only testing that the scheduler doesn't break, not whether this makes sense.
   Core::UndeclareAsCPUThread();
-  CoreTiming::g.global_timer -= 1000;
   CoreTiming::ScheduleEvent(0, cb_b, CB_IDS[1], CoreTiming::FromThread::NON_CPU);
-  CoreTiming::g.global_timer += 1000;
   Core::DeclareAsCPUThread();
-  AdvanceAndCheck(1, MAX_SLICE_LENGTH, MAX_SLICE_LENGTH + 1000);
+  AdvanceAndCheck(1, MAX_SLICE_LENGTH, MAX_SLICE_LENGTH);
 
   // Schedule directly into the past from the CPU.
   // This shouldn't happen in practice, but it's best if we don't mess up the slice length and
@@ -362,3 +365,159 @@ TEST(CoreTiming, Overclocking)
   Config::SetCurrent(Config::MAIN_OVERCLOCK, 1.0f);
   AdvanceAndCheck(4, MAX_SLICE_LENGTH);
 }
+
+namespace CrossThreadTest
+{
+static int s_callback_count = 0;
+
+static void CountingCallback(u64 userdata, s64 lateness)
+{
+  ++s_callback_count;
+}
+}  // namespace CrossThreadTest
+
+TEST(CoreTiming, CrossThreadScheduling)
+{
+  using namespace CrossThreadTest;
+
+  ScopeInit guard;
+  ASSERT_TRUE(guard.UserDirectoryExists());
+
+  constexpr int THREAD_COUNT = 4;
+  constexpr int EVENTS_PER_THREAD = 1000;
+
+  CoreTiming::EventType* cb = CoreTiming::RegisterEvent("callbackCount", CountingCallback);
+
+  // Enter slice 0
+  CoreTiming::Advance();
+
+  s_callback_count = 0;
+  std::vector<std::thread> threads;
+  for (int i = 0; i < THREAD_COUNT; ++i)
+  {
+    threads.emplace_back([cb] {
+      for (int j = 0; j < EVENTS_PER_THREAD; ++j)
+        CoreTiming::ScheduleEvent(0, cb, j, CoreTiming::FromThread::NON_CPU);
+    });
+  }
+  for (std::thread& thread : threads)
+    thread.join();
+
+  PowerPC::ppcState.downcount = 0;
+  CoreTiming::Advance();
+  EXPECT_EQ(THREAD_COUNT * EVENTS_PER_THREAD, s_callback_count);
+  EXPECT_EQ(MAX_SLICE_LENGTH, PowerPC::ppcState.downcount);
+}
+
+namespace BenchmarkTest
+{
+static u32 s_random_state = 1;
+static int s_callback_count = 0;
+
+static s64 NextDelay()
+{
+  // Hardware events are mostly scheduled a few hundred to a few thousand cycles ahead.
+  s_random_state = s_random_state * 1103515245 + 12345;
+  return 100 + (s_random_state >> 16) % 4000;
+}
+
+static void RescheduleCallback(u64 userdata, s64 lateness)
+{
+  ++s_callback_count;
+  CoreTiming::ScheduleEvent(NextDelay(), reinterpret_cast<CoreTiming::EventType*>(userdata),
+                            userdata);
+}
+}  // namespace BenchmarkTest
+
+// Not a correctness test: reports how long ScheduleEvent and Advance take with a realistic number
+// of pending events, to catch performance regressions in the scheduler. It is disabled by default;
+// run it with --gtest_also_run_disabled_tests.
+TEST(CoreTiming, DISABLED_SchedulingBenchmark)
+{
+  using namespace BenchmarkTest;
+  using Clock = std::chrono::steady_clock;
+
+  ScopeInit guard;
+  ASSERT_TRUE(guard.UserDirectoryExists());
+
+  CoreTiming::EventType* cb = CoreTiming::RegisterEvent("callbackBenchmark", RescheduleCallback);
+
+  // Enter slice 0
+  CoreTiming::Advance();
+
+  for (const int pending_events : {16, 256, 1024})
+  {
+    constexpr int ADVANCE_COUNT = 100000;
+
+    CoreTiming::RemoveAllEvents(cb);
+    s_callback_count = 0;
+
+    const auto schedule_start = Clock::now();
+    for (int i = 0; i < pending_events; ++i)
+      CoreTiming::ScheduleEvent(NextDelay(), cb, reinterpret_cast<u64>(cb));
+    const auto schedule_end = Clock::now();
+
+    // Every Advance runs at least one event, which schedules its replacement.
+    for (int i = 0; i < ADVANCE_COUNT; ++i)
+    {
+      PowerPC::ppcState.downcount = 0;
+      CoreTiming::Advance();
+    }
+    const auto advance_end = Clock::now();
+
+    EXPECT_GE(s_callback_count, ADVANCE_COUNT);
+
+    const double schedule_ns =
+        std::chrono::duration<double, std::nano>(schedule_end - schedule_start).count() /
+        pending_events;
+    const double advance_ns =
+        std::chrono::duration<double, std::nano>(advance_end - schedule_end).count() /
+        ADVANCE_COUNT;
+    fmt::print("{:5} pending events: ScheduleEvent {:7.1f} ns, Advance {:7.1f} ns\n",
+               pending_events, schedule_ns, advance_ns);
+  }
+
+  CoreTiming::RemoveAllEvents(cb);
+}
+
+TEST(CoreTiming, EventTrace)
+{
+  ScopeInit guard;
+  ASSERT_TRUE(guard.UserDirectoryExists());
+
+  CoreTiming::EventType* cb_a = CoreTiming::RegisterEvent("callbackA", CallbackTemplate<0>);
+  CoreTiming::EventType* cb_b = CoreTiming::RegisterEvent("callbackB", CallbackTemplate<1>);
+
+  // Enter slice 0
+  CoreTiming::Advance();
+
+  // Only keep two records so that the ring buffer wraps around.
+  CoreTiming::StartEventTrace(2);
+  EXPECT_TRUE(CoreTiming::IsEventTraceRunning());
+
+  CoreTiming::ScheduleEvent(100, cb_a, CB_IDS[0]);
+  CoreTiming::ScheduleEvent(200, cb_b, CB_IDS[1]);
+  CoreTiming::ScheduleEvent(300, cb_a, CB_IDS[0]);
+  AdvanceAndCheck(0, 100);
+  AdvanceAndCheck(1, 100);
+  AdvanceAndCheck(0, MAX_SLICE_LENGTH, 10, -10);
+
+  CoreTiming::StopEventTrace();
+  EXPECT_FALSE(CoreTiming::IsEventTraceRunning());
+
+  const std::string summary = CoreTiming::GetEventTraceSummary();
+  EXPECT_NE(std::string::npos, summary.find("callbackA: 2 calls"));
+  EXPECT_NE(std::string::npos, summary.find("callbackB: 1 calls"));
+  EXPECT_NE(std::string::npos, summary.find("10 cycles max late"));
+
+  const std::string trace_dir = File::CreateTempDir();
+  ASSERT_TRUE(CoreTiming::WriteEventTrace(trace_dir + "/trace.json"));
+  std::string trace;
+  ASSERT_TRUE(File::ReadFileToString(trace_dir + "/trace.json", trace));
+  File::DeleteDirRecursively(trace_dir);
+
+  // One record per line, and the oldest callback was overwritten.
+  EXPECT_EQ(2 + 2, std::count(trace.begin(), trace.end(), '\n'));
+  EXPECT_NE(std::string::npos, trace.find("\"name\":\"callbackB\""));
+  EXPECT_NE(std::string::npos, trace.find("\"cycles_late\":10"));
+}
@@ -0,0 +1,68 @@
+// Copyright 2022 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <array>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "Common/CommonTypes.h"
+#include "Core/DSP/DSPAnalyzer.h"
+#include "Core/DSP/DSPCodeUtil.h"
+#include "Core/DSP/DSPCore.h"
+#include "Core/DSP/DSPTables.h"
+
+// Assembles the given code into IRAM, starting at address 0, and analyzes it.
+static DSP::Analyzer AnalyzeCode(const char* asm_code)
+{
+  std::vector<u16> code;
+  EXPECT_TRUE(DSP::Assemble(asm_code, code));
+
+  std::array<u16, DSP::DSP_IRAM_SIZE> iram{};
+  std::array<u16, DSP::DSP_IROM_SIZE> irom{};
+  std::copy(code.begin(), code.end(), iram.begin());
+
+  DSP::InitInstructionTable();
+  DSP::DSPCore core;
+  DSP::SDSP dsp(core);
+  dsp.iram = iram.data();
+  dsp.irom = irom.data();
+
+  DSP::Analyzer analyzer;
+  analyzer.Analyze(dsp);
+  return analyzer;
+}
+
+TEST(DSPAnalyzer, WaitLoopIsIdleSkip)
+{
+  // Waits for a DMA to finish. This isn't one of the known idle skip signatures.
+  const DSP::Analyzer analyzer = AnalyzeCode(R"(
+      nop
+wait:
+      lrs    $AC1.M, @DSCR
+      andcf  $AC1.M, #0x0004
+      jlz    wait
+      ret
+)");
+
+  EXPECT_FALSE(analyzer.IsIdleSkip(0x0000));
+  EXPECT_TRUE(analyzer.IsIdleSkip(0x0001));
+  EXPECT_FALSE(analyzer.IsIdleSkip(0x0002));
+}
+
+TEST(DSPAnalyzer, WaitLoopWithSideEffectsIsNotIdleSkip)
+{
+  // Reading CMBL acknowledges the mail, so every iteration changes the mailbox state.
+  const DSP::Analyzer analyzer = AnalyzeCode(R"(
+      nop
+wait:
+      lrs    $AC0.M, @CMBL
+      andcf  $AC0.M, #0x8000
+      jlnz   wait
+      ret
+)");
+
+  EXPECT_TRUE(analyzer.IsStartOfInstruction(0x0001));
+  EXPECT_FALSE(analyzer.IsIdleSkip(0x0001));
+}
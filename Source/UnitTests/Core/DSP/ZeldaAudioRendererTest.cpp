@@ -0,0 +1,185 @@
+// Copyright 2022 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <array>
+#include <random>
+
+#include <gtest/gtest.h>
+
+#include "Common/CommonTypes.h"
+#include "Common/Swap.h"
+#include "Core/HW/DSPHLE/UCodes/Zelda.h"
+
+using DSP::HLE::ZeldaAudioRenderer;
+
+// The renderer's sample processing is vectorized on some hosts. These tests compare it against
+// straightforward scalar implementations of the same operations.
+
+namespace
+{
+constexpr std::array<size_t, 4> COUNTS = {0x50, 0x28, 13, 0};
+
+std::mt19937 s_rng(0x5A454C44);
+
+s16 RandomSample()
+{
+  // Make the extremes much more likely than they would be otherwise.
+  switch (s_rng() % 8)
+  {
+  case 0:
+    return -0x8000;
+  case 1:
+    return 0x7FFF;
+  default:
+    return static_cast<s16>(s_rng());
+  }
+}
+
+template <size_t N>
+std::array<s16, N> RandomSamples()
+{
+  std::array<s16, N> samples;
+  std::generate(samples.begin(), samples.end(), RandomSample);
+  return samples;
+}
+
+void ReferenceApplyVolumeInPlace(s16* buf, size_t count, u16 vol, u32 shift)
+{
+  for (size_t i = 0; i < count; ++i)
+  {
+    s32 tmp = (u32)buf[i] * (u32)vol;
+    tmp >>= shift;
+    buf[i] = (s16)std::clamp(tmp, -0x8000, 0x7FFF);
+  }
+}
+
+s32 ReferenceAddBuffersWithVolumeRamp(s16* dst, const s16* src, size_t count, s32 vol, s32 step)
+{
+  u32 current_vol = static_cast<u32>(vol);
+  for (size_t i = 0; i < count; ++i)
+  {
+    dst[i] += ((static_cast<s32>(current_vol) >> 16) * src[i]) >> 16;
+    current_vol += static_cast<u32>(step);
+  }
+  return static_cast<s32>(current_vol);
+}
+
+void ReferenceAddBuffersWithVolume(s16* dst, const s16* src, size_t count, u16 vol)
+{
+  while (count--)
+  {
+    s32 vol_src = ((s32)*src++ * (s32)vol) >> 15;
+    *dst++ += std::clamp(vol_src, -0x8000, 0x7FFF);
+  }
+}
+}  // namespace
+
+TEST(ZeldaAudioRenderer, ApplyVolumeInPlace)
+{
+  for (int iteration = 0; iteration < 1000; ++iteration)
+  {
+    const u16 vol = static_cast<u16>(s_rng());
+    const u32 shift = iteration % 2 ? 15 : 12;
+    for (const size_t count : COUNTS)
+    {
+      auto expected = RandomSamples<0x50>();
+      auto actual = expected;
+      ReferenceApplyVolumeInPlace(expected.data(), count, vol, shift);
+      ZeldaAudioRenderer::ApplyVolumeInPlace(actual.data(), count, vol, shift);
+      ASSERT_EQ(expected, actual) << "vol " << vol << " shift " << shift << " count " << count;
+    }
+  }
+}
+
+TEST(ZeldaAudioRenderer, AddBuffersWithVolumeRamp)
+{
+  for (int iteration = 0; iteration < 1000; ++iteration)
+  {
+    const s32 vol = static_cast<s32>(s_rng());
+    const s32 step = static_cast<s32>(s_rng()) >> (s_rng() % 24);
+    for (const size_t count : COUNTS)
+    {
+      const auto src = RandomSamples<0x50>();
+      auto expected = RandomSamples<0x50>();
+      auto actual = expected;
+      const s32 expected_vol =
+          ReferenceAddBuffersWithVolumeRamp(expected.data(), src.data(), count, vol, step);
+      const s32 actual_vol =
+          ZeldaAudioRenderer::AddBuffersWithVolumeRamp(actual.data(), src.data(), count, vol, step);
+      ASSERT_EQ(expected, actual) << "vol " << vol << " step " << step << " count " << count;
+      ASSERT_EQ(expected_vol, actual_vol);
+    }
+  }
+}
+
+TEST(ZeldaAudioRenderer, AddBuffersWithVolume)
+{
+  for (int iteration = 0; iteration < 1000; ++iteration)
+  {
+    // Some callers use volumes above 0x7FFF, e.g. 0xB820 for the reverb buffers.
+    const u16 vol = iteration == 0 ? 0xB820 : static_cast<u16>(s_rng());
+    for (const size_t count : COUNTS)
+    {
+      const auto src = RandomSamples<0x50>();
+      auto expected = RandomSamples<0x50>();
+      auto actual = expected;
+      ReferenceAddBuffersWithVolume(expected.data(), src.data(), count, vol);
+      ZeldaAudioRenderer::AddBuffersWithVolume(actual.data(), src.data(), count, vol);
+      ASSERT_EQ(expected, actual) << "vol " << vol << " count " << count;
+    }
+  }
+}
+
+TEST(ZeldaAudioRenderer, ResampleWithFilter)
+{
+  for (int iteration = 0; iteration < 1000; ++iteration)
+  {
+    const auto src = RandomSamples<0x500 + 4>();
+    const auto coeffs = RandomSamples<0x100>();
+    const u32 start_pos = s_rng() & 0xFFF;
+    // The renderer only filters when resampling by less than 4:1.
+    const u32 ratio = s_rng() % 0x4000;
+
+    std::array<s16, 0x50> expected;
+    u32 expected_pos = start_pos;
+    for (s16& dst_sample : expected)
+    {
+      const s16* c = &coeffs[((expected_pos & 0xFFF) >> 6) * 4];
+      const s16* input = &src[expected_pos >> 12];
+
+      s64 dst_sample_unclamped = 0;
+      for (size_t i = 0; i < 4; ++i)
+        dst_sample_unclamped += (s64)2 * c[i] * input[i];
+      dst_sample_unclamped >>= 16;
+
+      dst_sample = (s16)std::clamp<s64>(dst_sample_unclamped, -0x8000, 0x7FFF);
+      expected_pos += ratio;
+    }
+
+    std::array<s16, 0x50> actual;
+    const u32 actual_pos = ZeldaAudioRenderer::ResampleWithFilter(
+        actual.data(), actual.size(), src.data(), start_pos, ratio, coeffs.data());
+
+    ASSERT_EQ(expected, actual) << "pos " << start_pos << " ratio " << ratio;
+    ASSERT_EQ(expected_pos, actual_pos);
+  }
+}
+
+TEST(ZeldaAudioRenderer, PCMConversion)
+{
+  const auto src = RandomSamples<0x50>();
+  for (const size_t count : COUNTS)
+  {
+    std::array<s16, 0x50> swapped{};
+    ZeldaAudioRenderer::ByteSwapSamples(swapped.data(), src.data(), count);
+    for (size_t i = 0; i < count; ++i)
+      ASSERT_EQ(static_cast<s16>(Common::swap16(src[i])), swapped[i]);
+
+    std::array<s16, 0x50> expanded{};
+    const s8* src8 = reinterpret_cast<const s8*>(src.data());
+    ZeldaAudioRenderer::ExpandPCM8Samples(expanded.data(), src8, count);
+    for (size_t i = 0; i < count; ++i)
+      ASSERT_EQ(src8[i] * 0x100, expanded[i]);
+  }
+}
@@ -0,0 +1,438 @@
+// Copyright 2022 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <optional>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <mbedtls/md5.h>
+
+#include "AudioCommon/FlacFileWriter.h"
+#include "Common/CommonPaths.h"
+#include "Common/CommonTypes.h"
+#include "Common/FileUtil.h"
+
+namespace
+{
+class BitReader
+{
+public:
+  explicit BitReader(const std::string& data) : m_data(data) {}
+
+  u32 Read(u32 bits)
+  {
+    u32 value = 0;
+    for (u32 i = 0; i < bits; ++i)
+    {
+      const u8 byte = static_cast<u8>(m_data.at(m_position / 8));
+      value = (value << 1) | ((byte >> (7 - m_position % 8)) & 1);
+      ++m_position;
+    }
+    return value;
+  }
+
+  s32 ReadSigned(u32 bits)
+  {
+    const u32 value = Read(bits);
+    if (bits == 0 || bits == 32)
+      return static_cast<s32>(value);
+    return static_cast<s32>(value << (32 - bits)) >> (32 - bits);
+  }
+
+  s32 ReadRice(u32 parameter)
+  {
+    u32 quotient = 0;
+    while (Read(1) == 0)
+      ++quotient;
+    const u32 folded = (quotient << parameter) | Read(parameter);
+    return static_cast<s32>(folded >> 1) ^ -static_cast<s32>(folded & 1);
+  }
+
+  void AlignToByte() { m_position = (m_position + 7) / 8 * 8; }
+  size_t GetBytePosition() const { return m_position / 8; }
+  bool AtEnd() const { return m_position >= m_data.size() * 8; }
+
+private:
+  const std::string& m_data;
+  size_t m_position = 0;
+};
+
+u8 CRC8(const std::string& data, size_t start, size_t end)
+{
+  u8 crc = 0;
+  for (size_t i = start; i < end; ++i)
+  {
+    crc ^= static_cast<u8>(data[i]);
+    for (int bit = 0; bit < 8; ++bit)
+      crc = (crc & 0x80) ? static_cast<u8>((crc << 1) ^ 0x07) : static_cast<u8>(crc << 1);
+  }
+  return crc;
+}
+
+u16 CRC16(const std::string& data, size_t start, size_t end)
+{
+  u16 crc = 0;
+  for (size_t i = start; i < end; ++i)
+  {
+    crc ^= static_cast<u16>(static_cast<u8>(data[i]) << 8);
+    for (int bit = 0; bit < 8; ++bit)
+      crc = (crc & 0x8000) ? static_cast<u16>((crc << 1) ^ 0x8005) : static_cast<u16>(crc << 1);
+  }
+  return crc;
+}
+
+enum SubframeType
+{
+  CONSTANT,
+  VERBATIM,
+  FIXED,
+  LPC,
+  NUM_SUBFRAME_TYPES,
+};
+
+struct DecodedStream
+{
+  u32 sample_rate = 0;
+  u64 total_samples = 0;
+  std::array<u8, 16> md5{};
+  // Interleaved left/right.
+  std::vector<s16> samples;
+  std::array<u32, NUM_SUBFRAME_TYPES> subframe_counts{};
+};
+
+// A straightforward decoder written from the format specification, which is deliberately
+// independent of the encoder's code.
+class Decoder
+{
+public:
+  explicit Decoder(const std::string& data) : m_data(data), m_reader(data) {}
+
+  std::optional<DecodedStream> Decode()
+  {
+    if (m_data.compare(0, 4, "fLaC") != 0)
+      return std::nullopt;
+    m_reader.Read(32);
+
+    const u32 last_block = m_reader.Read(1);
+    const u32 block_type = m_reader.Read(7);
+    const u32 length = m_reader.Read(24);
+    if (!last_block || block_type != 0 || length != 34)
+      return std::nullopt;
+
+    m_reader.Read(16 + 16 + 24 + 24);  // Block and frame sizes
+    m_stream.sample_rate = m_reader.Read(20);
+    if (m_reader.Read(3) != 1 || m_reader.Read(5) != 15)  // Stereo, 16 bits per sample
+      return std::nullopt;
+    m_stream.total_samples = u64{m_reader.Read(4)} << 32;
+    m_stream.total_samples |= m_reader.Read(32);
+    for (u8& byte : m_stream.md5)
+      byte = static_cast<u8>(m_reader.Read(8));
+
+    while (!m_reader.AtEnd())
+    {
+      if (!DecodeFrame())
+        return std::nullopt;
+    }
+    return m_stream;
+  }
+
+private:
+  bool DecodeFrame()
+  {
+    const size_t frame_start = m_reader.GetBytePosition();
+    if (m_reader.Read(14) != 0x3ffe || m_reader.Read(1) != 0 || m_reader.Read(1) != 0)
+      return false;
+
+    const u32 block_size_code = m_reader.Read(4);
+    if (m_reader.Read(4) != 0)  // Sample rate from the stream info
+      return false;
+    const u32 channels = m_reader.Read(4);
+    if (m_reader.Read(3) != 4 || m_reader.Read(1) != 0)  // 16 bits per sample
+      return false;
+
+    u32 frame_number = m_reader.Read(8);
+    if (frame_number & 0x80)
+    {
+      u32 extra_bytes = 0;
+      while (frame_number & (0x40 >> extra_bytes))
+        ++extra_bytes;
+      frame_number &= 0x3f >> extra_bytes;
+      for (u32 i = 0; i < extra_bytes; ++i)
+        frame_number = (frame_number << 6) | (m_reader.Read(8) & 0x3f);
+    }
+    if (frame_number != m_frame_number++)
+      return false;
+
+    u32 block_size;
+    if (block_size_code == 6)
+      block_size = m_reader.Read(8) + 1;
+    else if (block_size_code == 7)
+      block_size = m_reader.Read(16) + 1;
+    else if (block_size_code >= 8)
+      block_size = 256u << (block_size_code - 8);
+    else
+      return false;
+
+    const size_t header_end = m_reader.GetBytePosition();
+    if (m_reader.Read(8) != CRC8(m_data, frame_start, header_end))
+      return false;
+
+    const bool first_is_side = channels == 9;
+    const bool second_is_side = channels == 8 || channels == 10;
+    std::vector<s32> first, second;
+    if (!DecodeSubframe(block_size, first_is_side ? 17 : 16, &first) ||
+        !DecodeSubframe(block_size, second_is_side ? 17 : 16, &second))
+    {
+      return false;
+    }
+
+    m_reader.AlignToByte();
+    const size_t frame_end = m_reader.GetBytePosition();
+    if (m_reader.Read(16) != CRC16(m_data, frame_start, frame_end))
+      return false;
+
+    for (u32 i = 0; i < block_size; ++i)
+    {
+      s32 left, right;
+      switch (channels)
+      {
+      case 1:
+        left = first[i];
+        right = second[i];
+        break;
+      case 8:
+        left = first[i];
+        right = first[i] - second[i];
+        break;
+      case 9:
+        left = first[i] + second[i];
+        right = second[i];
+        break;
+      case 10:
+      {
+        const s32 mid = (first[i] * 2) | (second[i] & 1);
+        left = (mid + second[i]) >> 1;
+        right = (mid - second[i]) >> 1;
+        break;
+      }
+      default:
+        return false;
+      }
+      m_stream.samples.push_back(static_cast<s16>(left));
+      m_stream.samples.push_back(static_cast<s16>(right));
+    }
+    return true;
+  }
+
+  bool DecodeSubframe(u32 block_size, u32 bits_per_sample, std::vector<s32>* samples)
+  {
+    if (m_reader.Read(1) != 0)
+      return false;
+    const u32 type = m_reader.Read(6);
+    if (m_reader.Read(1) != 0)  // Wasted bits
+      return false;
+
+    if (type == 0)
+    {
+      ++m_stream.subframe_counts[CONSTANT];
+      samples->assign(block_size, m_reader.ReadSigned(bits_per_sample));
+      return true;
+    }
+
+    if (type == 1)
+    {
+      ++m_stream.subframe_counts[VERBATIM];
+      for (u32 i = 0; i < block_size; ++i)
+        samples->push_back(m_reader.ReadSigned(bits_per_sample));
+      return true;
+    }
+
+    if (type >= 8 && type <= 12)
+    {
+      ++m_stream.subframe_counts[FIXED];
+      const u32 order = type - 8;
+      for (u32 i = 0; i < order; ++i)
+        samples->push_back(m_reader.ReadSigned(bits_per_sample));
+      if (!DecodeResidual(block_size, order, samples))
+        return false;
+
+      static constexpr std::array<std::array<s32, 4>, 5> predictors{{
+          {0, 0, 0, 0},
+          {1, 0, 0, 0},
+          {2, -1, 0, 0},
+          {3, -3, 1, 0},
+          {4, -6, 4, -1},
+      }};
+      Restore(samples, order, predictors[order].data(), 0);
+      return true;
+    }
+
+    if (type >= 32)
+    {
+      ++m_stream.subframe_counts[LPC];
+      const u32 order = type - 31;
+      for (u32 i = 0; i < order; ++i)
+        samples->push_back(m_reader.ReadSigned(bits_per_sample));
+      const u32 precision = m_reader.Read(4) + 1;
+      const s32 shift = m_reader.ReadSigned(5);
+      if (precision == 16 || shift < 0)
+        return false;
+      std::vector<s32> coefficients;
+      for (u32 i = 0; i < order; ++i)
+        coefficients.push_back(m_reader.ReadSigned(precision));
+      if (!DecodeResidual(block_size, order, samples))
+        return false;
+
+      Restore(samples, order, coefficients.data(), shift);
+      return true;
+    }
+
+    return false;
+  }
+
+  bool DecodeResidual(u32 block_size, u32 order, std::vector<s32>* samples)
+  {
+    const u32 method = m_reader.Read(2);
+    if (method > 1)
+      return false;
+    const u32 parameter_bits = method == 0 ? 4 : 5;
+    const u32 escape = (1u << parameter_bits) - 1;
+
+    const u32 partition_order = m_reader.Read(4);
+    const u32 partition_size = block_size >> partition_order;
+    for (u32 partition = 0; partition < (1u << partition_order); ++partition)
+    {
+      const u32 count = partition == 0 ? partition_size - order : partition_size;
+      const u32 parameter = m_reader.Read(parameter_bits);
+      if (parameter == escape)
+      {
+        const u32 bits = m_reader.Read(5);
+        for (u32 i = 0; i < count; ++i)
+          samples->push_back(m_reader.ReadSigned(bits));
+      }
+      else
+      {
+        for (u32 i = 0; i < count; ++i)
+          samples->push_back(m_reader.ReadRice(parameter));
+      }
+    }
+    return samples->size() == block_size;
+  }
+
+  // Turns the residual that follows the warm-up samples into samples.
+  static void Restore(std::vector<s32>* samples, u32 order, const s32* coefficients, s32 shift)
+  {
+    std::vector<s32>& s = *samples;
+    for (size_t i = order; i < s.size(); ++i)
+    {
+      s64 prediction = 0;
+      for (u32 j = 0; j < order; ++j)
+        prediction += s64{coefficients[j]} * s[i - j - 1];
+      s[i] += static_cast<s32>(prediction >> shift);
+    }
+  }
+
+  const std::string& m_data;
+  BitReader m_reader;
+  DecodedStream m_stream;
+  u32 m_frame_number = 0;
+};
+
+std::array<u8, 16> ComputeMD5(const std::vector<s16>& samples)
+{
+  std::vector<u8> bytes;
+  for (const s16 sample : samples)
+  {
+    bytes.push_back(static_cast<u8>(sample));
+    bytes.push_back(static_cast<u8>(static_cast<u16>(sample) >> 8));
+  }
+
+  std::array<u8, 16> md5;
+  mbedtls_md5_ret(bytes.data(), bytes.size(), md5.data());
+  return md5;
+}
+
+std::vector<s16> GenerateSamples()
+{
+  constexpr u32 block_size = 4096;
+  std::vector<s16> samples;
+  std::mt19937 rng(0x464c4143);
+  std::uniform_int_distribution<int> full_scale(-32768, 32767);
+  std::uniform_int_distribution<int> small_noise(-3, 3);
+
+  // A linear ramp is predicted exactly by the second order fixed predictor.
+  for (u32 i = 0; i < block_size; ++i)
+  {
+    const s16 ramp = static_cast<s16>(static_cast<s32>(i) * 8 - 16384);
+    samples.push_back(ramp);
+    samples.push_back(static_cast<s16>(-ramp));
+  }
+
+  // A mix of tones predicts much better with a higher order linear predictor.
+  constexpr double tau = 6.283185307179586;
+  for (u32 i = 0; i < block_size; ++i)
+  {
+    const double t = i / 48000.0;
+    const double left = 8000 * std::sin(tau * 440 * t) + 5000 * std::sin(tau * 1234 * t);
+    const double right = 7000 * std::sin(tau * 660 * t) + 6000 * std::sin(tau * 2345 * t);
+    samples.push_back(static_cast<s16>(std::lround(left) + small_noise(rng)));
+    samples.push_back(static_cast<s16>(std::lround(right) + small_noise(rng)));
+  }
+
+  // Full scale noise can't be predicted at all and has to be stored verbatim.
+  for (u32 i = 0; i < block_size * 2; ++i)
+    samples.push_back(static_cast<s16>(full_scale(rng)));
+
+  // A partial block at the end, with one silent channel.
+  for (u32 i = 0; i < 1000; ++i)
+  {
+    samples.push_back(static_cast<s16>(small_noise(rng) * 100));
+    samples.push_back(0);
+  }
+
+  return samples;
+}
+}  // namespace
+
+TEST(FlacFileWriter, RoundTrip)
+{
+  const std::string directory = File::CreateTempDir();
+  ASSERT_FALSE(directory.empty());
+  const std::string path = directory + DIR_SEP "dump.flac";
+
+  const std::vector<s16> samples = GenerateSamples();
+  const u32 num_samples = static_cast<u32>(samples.size() / 2);
+  {
+    AudioCommon::FlacFileWriter writer;
+    ASSERT_TRUE(writer.Start(path, 48000));
+    // Feed the samples in uneven batches, like the audio dumper does.
+    for (u32 i = 0; i < num_samples; i += 333)
+      writer.AddStereoSamples(&samples[i * 2], std::min(333u, num_samples - i));
+    writer.Stop();
+  }
+
+  std::string data;
+  ASSERT_TRUE(File::ReadFileToString(path, data));
+  File::DeleteDirRecursively(directory);
+
+  const std::optional<DecodedStream> stream = Decoder(data).Decode();
+  ASSERT_TRUE(stream.has_value());
+  EXPECT_EQ(stream->sample_rate, 48000u);
+  EXPECT_EQ(stream->total_samples, num_samples);
+  EXPECT_EQ(stream->samples, samples);
+  EXPECT_EQ(stream->md5, ComputeMD5(samples));
+
+  EXPECT_GT(stream->subframe_counts[CONSTANT], 0u);
+  EXPECT_GT(stream->subframe_counts[VERBATIM], 0u);
+  EXPECT_GT(stream->subframe_counts[FIXED], 0u);
+  EXPECT_GT(stream->subframe_counts[LPC], 0u);
+
+  // The encoded file should be well below the size of the raw samples, noise included.
+  EXPECT_LT(data.size(), samples.size() * sizeof(s16) * 3 / 4);
+}
@@ -41,6 +41,13 @@ TEST(IsMMIOAddress, SpecialAddresses)
 
   // WG Pipe address, should not be handled by MMIO.
   EXPECT_FALSE(MMIO::IsMMIOAddress(0x0C008000));
+  EXPECT_FALSE(MMIO::IsMMIOAddress(0x0C008000, true));
+
+  // Writes anywhere in the WG Pipe page go to the GPFifo, but reads don't.
+  EXPECT_FALSE(MMIO::IsMMIOAddress(0x0C008004, true));
+  EXPECT_FALSE(MMIO::IsMMIOAddress(0x0C008FFC, true));
+  EXPECT_TRUE(MMIO::IsMMIOAddress(0x0C008004));
+  EXPECT_TRUE(MMIO::IsMMIOAddress(0x0C009000, true));
 
   // Locked L1 cache allocation.
   EXPECT_FALSE(MMIO::IsMMIOAddress(0xE0000000));
@@ -138,3 +145,41 @@ TEST_F(MappingTest, ReadWriteComplex)
   EXPECT_TRUE(read_called);
   EXPECT_TRUE(write_called);
 }
+
+TEST_F(MappingTest, ReadWriteDirectMasked)
+{
+  u16 target = 0;
+
+  m_mapping->Register(0x0C001234, MMIO::DirectRead<u16>(&target, 0x00FF),
+                      MMIO::DirectWrite<u16>(&target, 0xFF00));
+
+  m_mapping->Write<u16>(0x0C001234, 0x1234);
+  EXPECT_EQ(0x1200, target);
+
+  target = 0xABCD;
+  EXPECT_EQ(0x00CD, m_mapping->Read<u16>(0x0C001234));
+}
+
+TEST_F(MappingTest, ResetMethod)
+{
+  u32 target = 0x12345678;
+
+  m_mapping->Register(0x0C001234, MMIO::Constant<u32>(0xdeadbeef), MMIO::Nop<u32>());
+  m_mapping->Write<u32>(0x0C001234, 0);
+  EXPECT_EQ(0xdeadbeef, m_mapping->Read<u32>(0x0C001234));
+  EXPECT_EQ(0x12345678u, target);
+
+  // Replacing a handler must also replace the fast path used by Read and Write.
+  m_mapping->Register(0x0C001234, MMIO::DirectRead<u32>(&target), MMIO::DirectWrite<u32>(&target));
+  EXPECT_EQ(0x12345678u, m_mapping->Read<u32>(0x0C001234));
+  m_mapping->Write<u32>(0x0C001234, 0xcafebabe);
+  EXPECT_EQ(0xcafebabe, target);
+}
+
+TEST_F(MappingTest, ReadUnregistered)
+{
+  // Unregistered handlers are lazily initialized to invalid handlers, which return all ones.
+  EXPECT_EQ(0xFFFFFFFFu, m_mapping->Read<u32>(0x0C004320));
+  EXPECT_EQ(0xFFFFu, m_mapping->Read<u16>(0x0C004320));
+  m_mapping->Write<u8>(0x0C004320, 0x12);
+}
@@ -3,6 +3,7 @@
 
 #include <limits>
 #include <memory>
+#include <random>
 #include <tuple>
 #include <type_traits>
 #include <unordered_set>
@@ -12,6 +13,7 @@
 #include "Common/BitUtils.h"
 #include "Common/Common.h"
 #include "Common/MathUtil.h"
+#include "Common/WorkerPool.h"
 #include "VideoCommon/CPMemory.h"
 #include "VideoCommon/DataReader.h"
 #include "VideoCommon/OpcodeDecoding.h"
@@ -95,6 +97,65 @@ protected:
     EXPECT_EQ(actual_count, expected_count);
   }
 
+  void CreateLargeFloatVertexLoader()
+  {
+    // Enables most attributes in floating point indexed mode.
+    m_vtx_desc.low.PosMatIdx = 1;
+    m_vtx_desc.low.Tex0MatIdx = 1;
+    m_vtx_desc.low.Tex1MatIdx = 1;
+    m_vtx_desc.low.Tex2MatIdx = 1;
+    m_vtx_desc.low.Tex3MatIdx = 1;
+    m_vtx_desc.low.Tex4MatIdx = 1;
+    m_vtx_desc.low.Tex5MatIdx = 1;
+    m_vtx_desc.low.Tex6MatIdx = 1;
+    m_vtx_desc.low.Tex7MatIdx = 1;
+    m_vtx_desc.low.Position = VertexComponentFormat::Index16;
+    m_vtx_desc.low.Normal = VertexComponentFormat::Index16;
+    m_vtx_desc.low.Color0 = VertexComponentFormat::Index16;
+    m_vtx_desc.low.Color1 = VertexComponentFormat::Index16;
+    m_vtx_desc.high.Tex0Coord = VertexComponentFormat::Index16;
+    m_vtx_desc.high.Tex1Coord = VertexComponentFormat::Index16;
+    m_vtx_desc.high.Tex2Coord = VertexComponentFormat::Index16;
+    m_vtx_desc.high.Tex3Coord = VertexComponentFormat::Index16;
+    m_vtx_desc.high.Tex4Coord = VertexComponentFormat::Index16;
+    m_vtx_desc.high.Tex5Coord = VertexComponentFormat::Index16;
+    m_vtx_desc.high.Tex6Coord = VertexComponentFormat::Index16;
+    m_vtx_desc.high.Tex7Coord = VertexComponentFormat::Index16;
+
+    m_vtx_attr.g0.PosElements = CoordComponentCount::XYZ;
+    m_vtx_attr.g0.PosFormat = ComponentFormat::Float;
+    m_vtx_attr.g0.NormalElements = NormalComponentCount::NTB;
+    m_vtx_attr.g0.NormalFormat = ComponentFormat::Float;
+    m_vtx_attr.g0.Color0Elements = ColorComponentCount::RGBA;
+    m_vtx_attr.g0.Color0Comp = ColorFormat::RGBA8888;
+    m_vtx_attr.g0.Color1Elements = ColorComponentCount::RGBA;
+    m_vtx_attr.g0.Color1Comp = ColorFormat::RGBA8888;
+    m_vtx_attr.g0.Tex0CoordElements = TexComponentCount::ST;
+    m_vtx_attr.g0.Tex0CoordFormat = ComponentFormat::Float;
+    m_vtx_attr.g1.Tex1CoordElements = TexComponentCount::ST;
+    m_vtx_attr.g1.Tex1CoordFormat = ComponentFormat::Float;
+    m_vtx_attr.g1.Tex2CoordElements = TexComponentCount::ST;
+    m_vtx_attr.g1.Tex2CoordFormat = ComponentFormat::Float;
+    m_vtx_attr.g1.Tex3CoordElements = TexComponentCount::ST;
+    m_vtx_attr.g1.Tex3CoordFormat = ComponentFormat::Float;
+    m_vtx_attr.g1.Tex4CoordElements = TexComponentCount::ST;
+    m_vtx_attr.g1.Tex4CoordFormat = ComponentFormat::Float;
+    m_vtx_attr.g2.Tex5CoordElements = TexComponentCount::ST;
+    m_vtx_attr.g2.Tex5CoordFormat = ComponentFormat::Float;
+    m_vtx_attr.g2.Tex6CoordElements = TexComponentCount::ST;
+    m_vtx_attr.g2.Tex6CoordFormat = ComponentFormat::Float;
+    m_vtx_attr.g2.Tex7CoordElements = TexComponentCount::ST;
+    m_vtx_attr.g2.Tex7CoordFormat = ComponentFormat::Float;
+
+    CreateAndCheckSizes(33, 156);
+
+    for (int i = 0; i < NUM_VERTEX_COMPONENT_ARRAYS; i++)
+    {
+      VertexLoaderManager::cached_arraybases[static_cast<CPArray>(i)] = m_src.GetPointer();
+      g_main_cp_state.array_strides[static_cast<CPArray>(i)] = 129;
+    }
+  }
+
   void ResetPointers()
   {
     m_src = DataReader(input_memory, input_memory + sizeof(input_memory));
@@ -255,6 +316,49 @@ TEST_F(VertexLoaderTest, PositionIndex16FloatXY)
   ExpectOut(2);
 }
 
+TEST_F(VertexLoaderTest, LastVerticesRestoreZFreezeState)
+{
+  // Vertices that were converted ahead of time on another thread rely on this to restore what the
+  // loader keeps on the side for zfreeze and emboss texgens.
+  m_vtx_desc.low.PosMatIdx = 1;
+  m_vtx_desc.low.Position = VertexComponentFormat::Direct;
+  m_vtx_desc.low.Normal = VertexComponentFormat::Direct;
+  m_vtx_attr.g0.PosElements = CoordComponentCount::XYZ;
+  m_vtx_attr.g0.PosFormat = ComponentFormat::Float;
+  m_vtx_attr.g0.NormalElements = NormalComponentCount::NTB;
+  m_vtx_attr.g0.NormalFormat = ComponentFormat::Float;
+  CreateAndCheckSizes(sizeof(u8) + 12 * sizeof(float), sizeof(u32) + 12 * sizeof(float));
+
+  constexpr int count = 10;
+  for (int i = 0; i < count; ++i)
+  {
+    Input<u8>(i);
+    for (int j = 0; j < 12; ++j)
+      Input(static_cast<float>(i * 100 + j));
+  }
+
+  RunVertices(count);
+  const auto position_cache = VertexLoaderManager::position_cache;
+  const auto position_matrix_index_cache = VertexLoaderManager::position_matrix_index_cache;
+  const auto tangent_cache = VertexLoaderManager::tangent_cache;
+  const auto binormal_cache = VertexLoaderManager::binormal_cache;
+
+  VertexLoaderManager::position_cache = {};
+  VertexLoaderManager::position_matrix_index_cache = {};
+  VertexLoaderManager::tangent_cache = {};
+  VertexLoaderManager::binormal_cache = {};
+
+  ResetPointers();
+  m_src.Skip((count - 3) * m_loader->m_vertex_size);
+  EXPECT_EQ(3, m_loader->RunVertices(m_src, m_dst, 3));
+
+  EXPECT_EQ(position_cache, VertexLoaderManager::position_cache);
+  EXPECT_EQ(position_matrix_index_cache, VertexLoaderManager::position_matrix_index_cache);
+  EXPECT_EQ(tangent_cache, VertexLoaderManager::tangent_cache);
+  EXPECT_EQ(binormal_cache, VertexLoaderManager::binormal_cache);
+  EXPECT_EQ(static_cast<float>((count - 1) * 100), VertexLoaderManager::position_cache[0][0]);
+}
+
 class VertexLoaderSpeedTest : public VertexLoaderTest,
                               public ::testing::WithParamInterface<std::tuple<ComponentFormat, int>>
 {
@@ -305,64 +409,142 @@ TEST_P(VertexLoaderSpeedTest, TexCoordSingleElement)
 
 TEST_F(VertexLoaderTest, LargeFloatVertexSpeed)
 {
-  // Enables most attributes in floating point indexed mode to test speed.
+  CreateLargeFloatVertexLoader();
+
+  // This test is only done 100x in a row since it's ~20x slower using the
+  // current vertex loader implementation.
+  for (int i = 0; i < 100; ++i)
+    RunVertices(100000);
+}
+
+TEST_F(VertexLoaderTest, ParallelMatchesSingleThreaded)
+{
+  // Normals are the last attribute and written 16 bytes at a time, so every vertex spills into the
+  // next one. Some positions have the index that makes the loader skip the vertex.
   m_vtx_desc.low.PosMatIdx = 1;
-  m_vtx_desc.low.Tex0MatIdx = 1;
-  m_vtx_desc.low.Tex1MatIdx = 1;
-  m_vtx_desc.low.Tex2MatIdx = 1;
-  m_vtx_desc.low.Tex3MatIdx = 1;
-  m_vtx_desc.low.Tex4MatIdx = 1;
-  m_vtx_desc.low.Tex5MatIdx = 1;
-  m_vtx_desc.low.Tex6MatIdx = 1;
-  m_vtx_desc.low.Tex7MatIdx = 1;
   m_vtx_desc.low.Position = VertexComponentFormat::Index16;
-  m_vtx_desc.low.Normal = VertexComponentFormat::Index16;
-  m_vtx_desc.low.Color0 = VertexComponentFormat::Index16;
-  m_vtx_desc.low.Color1 = VertexComponentFormat::Index16;
-  m_vtx_desc.high.Tex0Coord = VertexComponentFormat::Index16;
-  m_vtx_desc.high.Tex1Coord = VertexComponentFormat::Index16;
-  m_vtx_desc.high.Tex2Coord = VertexComponentFormat::Index16;
-  m_vtx_desc.high.Tex3Coord = VertexComponentFormat::Index16;
-  m_vtx_desc.high.Tex4Coord = VertexComponentFormat::Index16;
-  m_vtx_desc.high.Tex5Coord = VertexComponentFormat::Index16;
-  m_vtx_desc.high.Tex6Coord = VertexComponentFormat::Index16;
-  m_vtx_desc.high.Tex7Coord = VertexComponentFormat::Index16;
+  m_vtx_desc.low.Normal = VertexComponentFormat::Direct;
+  m_vtx_attr.g0.PosElements = CoordComponentCount::XYZ;
+  m_vtx_attr.g0.PosFormat = ComponentFormat::Float;
+  m_vtx_attr.g0.NormalElements = NormalComponentCount::N;
+  m_vtx_attr.g0.NormalFormat = ComponentFormat::Short;
+  CreateAndCheckSizes(sizeof(u8) + sizeof(u16) + 3 * sizeof(s16),
+                      sizeof(u32) + 3 * sizeof(float) + 3 * sizeof(float));
+
+  constexpr int count = 100000;
+  std::mt19937 rng(0x56545843);
+  for (int i = 0; i < count; ++i)
+  {
+    // Also skip vertices right where the work is split between four threads.
+    const bool skip = rng() % 16 == 0 || i == count / 4 - 1 || i == count / 2;
+    Input<u8>(static_cast<u8>(i));
+    Input<u16>(skip ? 0xFFFF : static_cast<u16>(rng() % 256));
+    for (int j = 0; j < 3; ++j)
+      Input<s16>(static_cast<s16>(rng()));
+  }
 
+  VertexLoaderManager::cached_arraybases[CPArray::Position] = m_src.GetPointer();
+  g_main_cp_state.array_strides[CPArray::Position] = 3 * sizeof(float);
+  for (int i = 0; i < 256 * 3; ++i)
+    Input(static_cast<float>(i));
+
+  ResetPointers();
+  const int expected_count = m_loader->RunVertices(m_src, m_dst, count);
+  const auto position_cache = VertexLoaderManager::position_cache;
+  const auto position_matrix_index_cache = VertexLoaderManager::position_matrix_index_cache;
+  ASSERT_LT(expected_count, count);
+
+  Common::WorkerPool workers;
+  workers.Start(3, "Vertex loader test worker");
+  u8* const dst = output_memory + sizeof(output_memory) / 2;
+  const int actual_count = VertexLoaderManager::RunVerticesInParallel(
+      workers, m_loader.get(), m_src, DataReader(dst, output_memory + sizeof(output_memory)),
+      count);
+
+  ASSERT_EQ(expected_count, actual_count);
+  EXPECT_EQ(0, memcmp(output_memory, dst, expected_count * m_loader->m_native_vtx_decl.stride));
+  EXPECT_EQ(position_cache, VertexLoaderManager::position_cache);
+  EXPECT_EQ(position_matrix_index_cache, VertexLoaderManager::position_matrix_index_cache);
+}
+
+TEST_F(VertexLoaderTest, PreloadLeavesZFreezeStateAlone)
+{
+  // Preloads convert the vertices of upcoming primitives on other threads, while the state that
+  // is kept for zfreeze and emboss texgens still belongs to the primitive before them.
+  m_vtx_desc.low.PosMatIdx = 1;
+  m_vtx_desc.low.Position = VertexComponentFormat::Direct;
+  m_vtx_desc.low.Normal = VertexComponentFormat::Direct;
   m_vtx_attr.g0.PosElements = CoordComponentCount::XYZ;
   m_vtx_attr.g0.PosFormat = ComponentFormat::Float;
   m_vtx_attr.g0.NormalElements = NormalComponentCount::NTB;
   m_vtx_attr.g0.NormalFormat = ComponentFormat::Float;
-  m_vtx_attr.g0.Color0Elements = ColorComponentCount::RGBA;
-  m_vtx_attr.g0.Color0Comp = ColorFormat::RGBA8888;
-  m_vtx_attr.g0.Color1Elements = ColorComponentCount::RGBA;
-  m_vtx_attr.g0.Color1Comp = ColorFormat::RGBA8888;
-  m_vtx_attr.g0.Tex0CoordElements = TexComponentCount::ST;
-  m_vtx_attr.g0.Tex0CoordFormat = ComponentFormat::Float;
-  m_vtx_attr.g1.Tex1CoordElements = TexComponentCount::ST;
-  m_vtx_attr.g1.Tex1CoordFormat = ComponentFormat::Float;
-  m_vtx_attr.g1.Tex2CoordElements = TexComponentCount::ST;
-  m_vtx_attr.g1.Tex2CoordFormat = ComponentFormat::Float;
-  m_vtx_attr.g1.Tex3CoordElements = TexComponentCount::ST;
-  m_vtx_attr.g1.Tex3CoordFormat = ComponentFormat::Float;
-  m_vtx_attr.g1.Tex4CoordElements = TexComponentCount::ST;
-  m_vtx_attr.g1.Tex4CoordFormat = ComponentFormat::Float;
-  m_vtx_attr.g2.Tex5CoordElements = TexComponentCount::ST;
-  m_vtx_attr.g2.Tex5CoordFormat = ComponentFormat::Float;
-  m_vtx_attr.g2.Tex6CoordElements = TexComponentCount::ST;
-  m_vtx_attr.g2.Tex6CoordFormat = ComponentFormat::Float;
-  m_vtx_attr.g2.Tex7CoordElements = TexComponentCount::ST;
-  m_vtx_attr.g2.Tex7CoordFormat = ComponentFormat::Float;
-
-  CreateAndCheckSizes(33, 156);
-
-  for (int i = 0; i < NUM_VERTEX_COMPONENT_ARRAYS; i++)
+  CreateAndCheckSizes(sizeof(u8) + 12 * sizeof(float), sizeof(u32) + 12 * sizeof(float));
+
+  VertexLoaderBase* const concurrent_loader = m_loader->GetConcurrentLoader();
+  if (!concurrent_loader)
+    return;
+
+  constexpr int count = 1000;
+  for (int i = 0; i < count; ++i)
   {
-    VertexLoaderManager::cached_arraybases[static_cast<CPArray>(i)] = m_src.GetPointer();
-    g_main_cp_state.array_strides[static_cast<CPArray>(i)] = 129;
+    Input<u8>(static_cast<u8>(i));
+    for (int j = 0; j < 12; ++j)
+      Input(static_cast<float>(i * 100 + j));
   }
 
-  // This test is only done 100x in a row since it's ~20x slower using the
-  // current vertex loader implementation.
+  VertexLoaderManager::position_cache = {{{1, 2, 3, 4}, {5, 6, 7, 8}, {9, 10, 11, 12}}};
+  VertexLoaderManager::position_matrix_index_cache = {13, 14, 15};
+  VertexLoaderManager::tangent_cache = {16, 17, 18, 19};
+  VertexLoaderManager::binormal_cache = {20, 21, 22, 23};
+  const auto position_cache = VertexLoaderManager::position_cache;
+  const auto position_matrix_index_cache = VertexLoaderManager::position_matrix_index_cache;
+  const auto tangent_cache = VertexLoaderManager::tangent_cache;
+  const auto binormal_cache = VertexLoaderManager::binormal_cache;
+
+  // Convert the vertices in four pieces, like four preloaded primitives. The loaders can write a
+  // few bytes past the last vertex, so the pieces are kept apart.
+  constexpr int piece_count = count / 4;
+  const int stride = m_loader->m_native_vtx_decl.stride;
+  const int piece_size = piece_count * stride + 16;
+  Common::WorkerPool workers;
+  workers.Start(3, "Vertex loader test worker");
+  workers.ParallelFor(4, [&](u32 i) {
+    const DataReader src(input_memory + piece_count * i * m_loader->m_vertex_size,
+                         input_memory + sizeof(input_memory));
+    const DataReader dst(output_memory + piece_size * i, output_memory + sizeof(output_memory));
+    EXPECT_EQ(piece_count, concurrent_loader->RunVertices(src, dst, piece_count));
+  });
+
+  EXPECT_EQ(position_cache, VertexLoaderManager::position_cache);
+  EXPECT_EQ(position_matrix_index_cache, VertexLoaderManager::position_matrix_index_cache);
+  EXPECT_EQ(tangent_cache, VertexLoaderManager::tangent_cache);
+  EXPECT_EQ(binormal_cache, VertexLoaderManager::binormal_cache);
+
+  // The vertices are the same as with the regular loader, which does keep the last ones.
+  u8* const dst = output_memory + sizeof(output_memory) / 2;
+  ResetPointers();
+  EXPECT_EQ(count, m_loader->RunVertices(
+                       m_src, DataReader(dst, output_memory + sizeof(output_memory)), count));
+  for (int i = 0; i < 4; ++i)
+  {
+    EXPECT_EQ(0, memcmp(output_memory + piece_size * i, dst + piece_count * stride * i,
+                        piece_count * stride));
+  }
+  EXPECT_EQ(static_cast<float>((count - 1) * 100), VertexLoaderManager::position_cache[0][0]);
+  EXPECT_EQ(static_cast<u32>((count - 1) & 0x3f),
+            VertexLoaderManager::position_matrix_index_cache[0]);
+}
+
+TEST_F(VertexLoaderTest, LargeFloatVertexParallelSpeed)
+{
+  CreateLargeFloatVertexLoader();
+
+  Common::WorkerPool workers;
+  workers.Start(3, "Vertex loader test worker");
   for (int i = 0; i < 100; ++i)
-    RunVertices(100000);
+  {
+    ResetPointers();
+    EXPECT_EQ(100000, VertexLoaderManager::RunVerticesInParallel(workers, m_loader.get(), m_src,
+                                                                 m_dst, 100000));
+  }
 }